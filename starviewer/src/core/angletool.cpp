@@ -68,7 +68,7 @@ void AngleTool::deleteTemporalRepresentation()
 
         if (hasToRefresh)
         {
-            m_2DViewer->render();
+            m_2DViewer->requestRender();
         }
 
         m_state = None;
@@ -245,7 +245,7 @@ void AngleTool::simulateCorrespondingSegmentOfAngle()
             drawCircle();
         }
 
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 }
 
@@ -0,0 +1,331 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#include "apngwriter.h"
+
+#include "logging.h"
+
+#include <QBuffer>
+#include <QFile>
+#include <QImage>
+#include <QList>
+#include <QtEndian>
+
+namespace udg {
+
+namespace {
+
+// Signatura que encapçala tots els fitxers PNG
+const char PngSignature[] = { '\x89', 'P', 'N', 'G', '\r', '\n', '\x1a', '\n' };
+const int PngSignatureSize = 8;
+
+// Mida de les dades del chunk acTL: nombre de frames i nombre de reproduccions
+const int AnimationControlDataSize = 8;
+
+void appendUInt32(QByteArray &data, quint32 value)
+{
+    uchar bytes[4];
+    qToBigEndian(value, bytes);
+    data.append(reinterpret_cast<const char*>(bytes), 4);
+}
+
+void appendUInt16(QByteArray &data, quint16 value)
+{
+    uchar bytes[2];
+    qToBigEndian(value, bytes);
+    data.append(reinterpret_cast<const char*>(bytes), 2);
+}
+
+quint32 readUInt32(const QByteArray &data, int position)
+{
+    return qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(data.constData() + position));
+}
+
+// CRC-32 tal com el defineix l'especificació de PNG
+quint32 pngCrc(const QByteArray &data)
+{
+    static quint32 table[256];
+    static bool tableComputed = false;
+
+    if (!tableComputed)
+    {
+        for (quint32 n = 0; n < 256; n++)
+        {
+            quint32 c = n;
+            for (int k = 0; k < 8; k++)
+            {
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        tableComputed = true;
+    }
+
+    quint32 crc = 0xffffffffu;
+    for (int i = 0; i < data.size(); i++)
+    {
+        crc = table[(crc ^ static_cast<uchar>(data.at(i))) & 0xff] ^ (crc >> 8);
+    }
+
+    return crc ^ 0xffffffffu;
+}
+
+// Chunk d'un fitxer PNG
+struct PngChunk {
+    QByteArray type;
+    QByteArray data;
+};
+
+// Retorna els chunks del PNG donat o una llista buida si no és un PNG vàlid
+QList<PngChunk> readChunks(const QByteArray &png)
+{
+    QList<PngChunk> chunks;
+    if (!png.startsWith(QByteArray::fromRawData(PngSignature, PngSignatureSize)))
+    {
+        return chunks;
+    }
+
+    int position = PngSignatureSize;
+    while (position + 12 <= png.size())
+    {
+        quint32 length = readUInt32(png, position);
+        if (length > static_cast<quint32>(png.size() - position - 12))
+        {
+            return QList<PngChunk>();
+        }
+
+        PngChunk chunk;
+        chunk.type = png.mid(position + 4, 4);
+        chunk.data = png.mid(position + 8, length);
+        chunks << chunk;
+        position += 12 + length;
+    }
+
+    return chunks;
+}
+
+}
+
+ApngWriter::ApngWriter()
+ : m_device(0), m_file(0), m_framesPerSecond(1), m_loop(true), m_numberOfFrames(0), m_sequenceNumber(0), m_animationControlPosition(0)
+{
+}
+
+ApngWriter::~ApngWriter()
+{
+    delete m_file;
+}
+
+bool ApngWriter::open(const QString &fileName, int framesPerSecond, bool loop)
+{
+    delete m_file;
+    m_file = new QFile(fileName);
+    if (!m_file->open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        ERROR_LOG("No s'ha pogut obrir el fitxer " + fileName + " per escriure-hi l'animació: " + m_file->errorString());
+        delete m_file;
+        m_file = 0;
+        return false;
+    }
+
+    return open(m_file, framesPerSecond, loop);
+}
+
+bool ApngWriter::open(QIODevice *device, int framesPerSecond, bool loop)
+{
+    if (!device || !device->isWritable() || device->isSequential() || framesPerSecond <= 0)
+    {
+        return false;
+    }
+
+    m_device = device;
+    m_framesPerSecond = framesPerSecond;
+    m_loop = loop;
+    m_frameSize = QSize();
+    m_numberOfFrames = 0;
+    m_sequenceNumber = 0;
+    m_animationControlPosition = 0;
+
+    return true;
+}
+
+bool ApngWriter::addFrame(const QImage &frame)
+{
+    if (!m_device || frame.isNull())
+    {
+        return false;
+    }
+
+    if (m_numberOfFrames > 0 && frame.size() != m_frameSize)
+    {
+        ERROR_LOG(QString("El frame %1 fa %2x%3 però l'animació és de %4x%5").arg(m_numberOfFrames).arg(frame.width()).arg(frame.height())
+                  .arg(m_frameSize.width()).arg(m_frameSize.height()));
+        return false;
+    }
+
+    // Tots els frames es codifiquen amb el mateix format perquè comparteixin la capçalera del primer
+    QByteArray png;
+    QBuffer buffer(&png);
+    buffer.open(QIODevice::WriteOnly);
+    if (!frame.convertToFormat(QImage::Format_RGB32).save(&buffer, "PNG"))
+    {
+        return false;
+    }
+
+    if (m_numberOfFrames == 0)
+    {
+        m_frameSize = frame.size();
+        if (!writeHeader(png))
+        {
+            return false;
+        }
+    }
+
+    if (!writeFrameControl())
+    {
+        return false;
+    }
+
+    foreach (const PngChunk &chunk, readChunks(png))
+    {
+        if (chunk.type != "IDAT")
+        {
+            continue;
+        }
+
+        bool ok;
+        if (m_numberOfFrames == 0)
+        {
+            // El primer frame és també la imatge per defecte del PNG
+            ok = writeChunk("IDAT", chunk.data);
+        }
+        else
+        {
+            QByteArray frameData;
+            appendUInt32(frameData, m_sequenceNumber++);
+            frameData.append(chunk.data);
+            ok = writeChunk("fdAT", frameData);
+        }
+
+        if (!ok)
+        {
+            return false;
+        }
+    }
+
+    m_numberOfFrames++;
+
+    return true;
+}
+
+bool ApngWriter::close()
+{
+    if (!m_device)
+    {
+        return false;
+    }
+
+    bool ok = m_numberOfFrames > 0 && writeChunk("IEND", QByteArray());
+
+    if (ok)
+    {
+        // Ara que se sap el nombre de frames es reescriu el chunk acTL, que té sempre la mateixa mida
+        qint64 endPosition = m_device->pos();
+        QByteArray animationControl;
+        appendUInt32(animationControl, m_numberOfFrames);
+        appendUInt32(animationControl, m_loop ? 0 : 1);
+
+        ok = m_device->seek(m_animationControlPosition) && writeChunk("acTL", animationControl) && m_device->seek(endPosition);
+    }
+
+    if (m_file)
+    {
+        m_file->close();
+        delete m_file;
+        m_file = 0;
+    }
+    m_device = 0;
+
+    return ok;
+}
+
+int ApngWriter::getNumberOfFrames() const
+{
+    return m_numberOfFrames;
+}
+
+bool ApngWriter::writeHeader(const QByteArray &png)
+{
+    QList<PngChunk> chunks = readChunks(png);
+    if (chunks.isEmpty() || chunks.first().type != "IHDR")
+    {
+        ERROR_LOG("No s'ha pogut codificar el primer frame de l'animació en PNG");
+        return false;
+    }
+
+    if (m_device->write(PngSignature, PngSignatureSize) != PngSignatureSize || !writeChunk("IHDR", chunks.first().data))
+    {
+        return false;
+    }
+
+    // El nombre de frames encara no se sap, s'escriu a close()
+    m_animationControlPosition = m_device->pos();
+    if (!writeChunk("acTL", QByteArray(AnimationControlDataSize, '\0')))
+    {
+        return false;
+    }
+
+    // Es mantenen els chunks auxiliars que van abans de les dades de la imatge (resolució, espai de color, etc.)
+    for (int i = 1; i < chunks.count() && chunks.at(i).type != "IDAT"; i++)
+    {
+        if (!writeChunk(chunks.at(i).type.constData(), chunks.at(i).data))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ApngWriter::writeChunk(const char *type, const QByteArray &data)
+{
+    QByteArray typeAndData = QByteArray(type, 4) + data;
+
+    QByteArray chunk;
+    appendUInt32(chunk, data.size());
+    chunk.append(typeAndData);
+    appendUInt32(chunk, pngCrc(typeAndData));
+
+    return m_device->write(chunk) == chunk.size();
+}
+
+bool ApngWriter::writeFrameControl()
+{
+    // El retard de cada frame és 1/fps segons. Els frames ocupen tota l'animació i substitueixen l'anterior.
+    QByteArray frameControl;
+    appendUInt32(frameControl, m_sequenceNumber++);
+    appendUInt32(frameControl, m_frameSize.width());
+    appendUInt32(frameControl, m_frameSize.height());
+    appendUInt32(frameControl, 0);
+    appendUInt32(frameControl, 0);
+    appendUInt16(frameControl, 1);
+    appendUInt16(frameControl, qMin(m_framesPerSecond, 0xffff));
+    frameControl.append('\0');
+    frameControl.append('\0');
+
+    return writeChunk("fcTL", frameControl);
+}
+
+}
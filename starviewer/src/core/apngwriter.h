@@ -0,0 +1,99 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#ifndef UDGAPNGWRITER_H
+#define UDGAPNGWRITER_H
+
+#include <QByteArray>
+#include <QSize>
+
+class QFile;
+class QImage;
+class QIODevice;
+class QString;
+
+namespace udg {
+
+/**
+    Escriu una seqüència d'imatges com a PNG animat (APNG) a mesura que es van afegint els frames.
+
+    Cada frame es codifica en PNG i s'escriu immediatament al dispositiu, de manera que la memòria necessària no depèn del nombre de frames.
+    Tots els frames han de tenir la mida del primer. El resultat només depèn de les imatges i paràmetres donats (no s'hi escriu cap data ni
+    informació de l'entorn), per tant dues exportacions iguals generen fitxers idèntics byte a byte.
+    Els visors que no suporten APNG mostren el primer frame com una imatge PNG normal.
+  */
+class ApngWriter {
+public:
+    ApngWriter();
+    ~ApngWriter();
+
+    /// Comença a escriure l'animació al fitxer donat amb la velocitat donada en frames per segon.
+    /// Si loop és cert l'animació es repeteix indefinidament, altrament es reprodueix un sol cop. Retorna fals si no es pot obrir el fitxer.
+    bool open(const QString &fileName, int framesPerSecond, bool loop = true);
+
+    /// Com l'anterior però escrivint al dispositiu donat, que ha d'estar obert en escriptura i permetre accés aleatori.
+    /// El dispositiu no passa a ser propietat de l'ApngWriter.
+    bool open(QIODevice *device, int framesPerSecond, bool loop = true);
+
+    /// Codifica i escriu el frame donat. Retorna fals si no s'ha obert l'animació, si la mida no coincideix amb la del primer frame o si hi ha
+    /// algun error d'escriptura.
+    bool addFrame(const QImage &frame);
+
+    /// Acaba l'animació actualitzant-ne el nombre de frames i tanca el fitxer si l'havia obert l'ApngWriter. Retorna fals si no s'ha afegit
+    /// cap frame o si hi ha algun error d'escriptura.
+    bool close();
+
+    /// Retorna el nombre de frames escrits fins ara
+    int getNumberOfFrames() const;
+
+private:
+    /// Escriu la capçalera de l'animació a partir del PNG del primer frame
+    bool writeHeader(const QByteArray &png);
+
+    /// Escriu un chunk amb el tipus i dades donats
+    bool writeChunk(const char *type, const QByteArray &data);
+
+    /// Escriu el chunk fcTL del frame actual
+    bool writeFrameControl();
+
+private:
+    /// Dispositiu on s'escriu l'animació
+    QIODevice *m_device;
+
+    /// Fitxer obert per l'ApngWriter, si n'hi ha
+    QFile *m_file;
+
+    /// Velocitat de reproducció
+    int m_framesPerSecond;
+
+    /// Indica si l'animació es repeteix indefinidament
+    bool m_loop;
+
+    /// Mida de tots els frames
+    QSize m_frameSize;
+
+    /// Nombre de frames escrits
+    int m_numberOfFrames;
+
+    /// Número de seqüència dels chunks fcTL i fdAT
+    unsigned int m_sequenceNumber;
+
+    /// Posició del chunk acTL dins del dispositiu, per poder actualitzar el nombre de frames en acabar
+    qint64 m_animationControlPosition;
+};
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#include "asynchronousthumbnailcreator.h"
+
+#include "logging.h"
+#include "thumbnailcreator.h"
+#include "dicomtagreader.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QMutexLocker>
+#include <QtConcurrentRun>
+
+namespace udg {
+
+const int AsynchronousThumbnailCreator::BatchSize = 16;
+
+namespace {
+
+// Guarda el thumbnail al fitxer donat. S'escriu primer en un fitxer temporal i es reanomena perquè qui llegeixi el thumbnail
+// mentre es genera no trobi mai un fitxer a mig escriure.
+void saveThumbnail(const QImage &thumbnail, const QString &thumbnailFilePath)
+{
+    QString temporaryFilePath = thumbnailFilePath + ".tmp";
+
+    if (!thumbnail.save(temporaryFilePath, "PNG"))
+    {
+        ERROR_LOG(QString("No s'ha pogut guardar el thumbnail %1").arg(thumbnailFilePath));
+        return;
+    }
+
+    if (!QFile::rename(temporaryFilePath, thumbnailFilePath))
+    {
+        ERROR_LOG(QString("No s'ha pogut reanomenar el thumbnail temporal %1").arg(temporaryFilePath));
+        QFile::remove(temporaryFilePath);
+    }
+}
+
+}
+
+AsynchronousThumbnailCreator::AsynchronousThumbnailCreator(QObject *parent)
+ : QObject(parent), m_isProcessing(false)
+{
+}
+
+AsynchronousThumbnailCreator::~AsynchronousThumbnailCreator()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_pendingRequests.clear();
+    }
+
+    m_processingFuture.waitForFinished();
+}
+
+void AsynchronousThumbnailCreator::enqueue(const QString &dicomFilePath, const QStringList &thumbnailFilePaths)
+{
+    Request request;
+    request.dicomFilePath = dicomFilePath;
+
+    QMutexLocker locker(&m_mutex);
+
+    foreach (const QString &thumbnailFilePath, thumbnailFilePaths)
+    {
+        if (!m_pendingThumbnailFilePaths.contains(thumbnailFilePath) && !QFileInfo(thumbnailFilePath).exists())
+        {
+            request.thumbnailFilePaths << thumbnailFilePath;
+            m_pendingThumbnailFilePaths.insert(thumbnailFilePath);
+        }
+    }
+
+    if (request.thumbnailFilePaths.isEmpty())
+    {
+        return;
+    }
+
+    m_pendingRequests.append(request);
+
+    if (!m_isProcessing)
+    {
+        m_isProcessing = true;
+        m_processingFuture = QtConcurrent::run(this, &AsynchronousThumbnailCreator::processPendingRequests);
+    }
+}
+
+bool AsynchronousThumbnailCreator::isPending(const QString &thumbnailFilePath)
+{
+    QMutexLocker locker(&m_mutex);
+    return m_pendingThumbnailFilePaths.contains(thumbnailFilePath);
+}
+
+void AsynchronousThumbnailCreator::processPendingRequests()
+{
+    QList<Request> batch = takeNextBatch();
+
+    while (!batch.isEmpty())
+    {
+        // Primer es descodifiquen totes les imatges del lot i després s'escriuen tots els fitxers seguits
+        QList<QImage> thumbnails;
+        foreach (const Request &request, batch)
+        {
+            DICOMTagReader reader(request.dicomFilePath);
+            thumbnails << ThumbnailCreator().getThumbnail(&reader);
+        }
+
+        QStringList savedThumbnailFilePaths;
+        for (int i = 0; i < batch.size(); i++)
+        {
+            foreach (const QString &thumbnailFilePath, batch.at(i).thumbnailFilePaths)
+            {
+                saveThumbnail(thumbnails.at(i), thumbnailFilePath);
+                savedThumbnailFilePaths << thumbnailFilePath;
+            }
+        }
+
+        {
+            QMutexLocker locker(&m_mutex);
+            foreach (const QString &thumbnailFilePath, savedThumbnailFilePaths)
+            {
+                m_pendingThumbnailFilePaths.remove(thumbnailFilePath);
+            }
+        }
+
+        batch = takeNextBatch();
+    }
+}
+
+QList<AsynchronousThumbnailCreator::Request> AsynchronousThumbnailCreator::takeNextBatch()
+{
+    QMutexLocker locker(&m_mutex);
+
+    QList<Request> batch = m_pendingRequests.mid(0, BatchSize);
+    m_pendingRequests = m_pendingRequests.mid(batch.size());
+
+    if (batch.isEmpty())
+    {
+        m_isProcessing = false;
+        m_pendingThumbnailFilePaths.clear();
+    }
+
+    return batch;
+}
+
+} // End namespace udg
@@ -0,0 +1,83 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#ifndef UDGASYNCHRONOUSTHUMBNAILCREATOR_H
+#define UDGASYNCHRONOUSTHUMBNAILCREATOR_H
+
+#include <QObject>
+
+#include <QFuture>
+#include <QList>
+#include <QMutex>
+#include <QSet>
+#include <QStringList>
+
+namespace udg {
+
+/**
+    Crea i guarda thumbnails en un thread de fons perquè la importació d'estudis no hagi d'esperar a descodificar imatges.
+
+    Cada petició indica el fitxer DICOM del qual s'ha de fer el thumbnail (se'n descodifica només el primer frame) i els fitxers on s'ha
+    de guardar. Les peticions es processen per lots: es creen els thumbnails de tot el lot i després s'escriuen tots els fitxers.
+    Les peticions d'un fitxer de thumbnail que ja existeix o que ja està pendent s'ignoren.
+
+    S'ha d'accedir a través de SingletonPointer<AsynchronousThumbnailCreator>. El primer accés es fa normalment des del thread de
+    descàrrega (VolumeFillerStep), però SingletonPointer mou la instància al thread principal perquè es destrueixi en sortir.
+  */
+class AsynchronousThumbnailCreator : public QObject {
+Q_OBJECT
+public:
+    AsynchronousThumbnailCreator(QObject *parent = 0);
+    /// Espera que s'acabin els thumbnails que s'estan creant. Els pendents de començar es descarten.
+    ~AsynchronousThumbnailCreator();
+
+    /// Demana crear el thumbnail del fitxer DICOM donat i guardar-lo en format PNG a cadascun dels fitxers indicats
+    void enqueue(const QString &dicomFilePath, const QStringList &thumbnailFilePaths);
+
+    /// Retorna cert si s'ha demanat crear el fitxer de thumbnail donat i encara no s'ha escrit
+    bool isPending(const QString &thumbnailFilePath);
+
+private:
+    struct Request
+    {
+        QString dicomFilePath;
+        QStringList thumbnailFilePaths;
+    };
+
+    /// Processa lots de peticions pendents fins que no en queda cap. S'executa en un thread del QThreadPool global.
+    void processPendingRequests();
+
+    /// Treu de la cua el següent lot de peticions. Si no en queda cap, marca que ja no hi ha cap lot en curs.
+    QList<Request> takeNextBatch();
+
+private:
+    /// Nombre màxim de peticions que es processen en un mateix lot
+    static const int BatchSize;
+
+    QList<Request> m_pendingRequests;
+    /// Fitxers de thumbnail demanats que encara no s'han escrit
+    QSet<QString> m_pendingThumbnailFilePaths;
+
+    /// Indica si hi ha un thread processant peticions
+    bool m_isProcessing;
+    QFuture<void> m_processingFuture;
+
+    /// Protegeix l'accés a les peticions pendents i a l'estat del processament
+    QMutex m_mutex;
+};
+
+} // End namespace udg
+
+#endif
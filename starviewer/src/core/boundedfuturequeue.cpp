@@ -0,0 +1,60 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+#include "boundedfuturequeue.h"
+
+namespace udg {
+
+BoundedFutureQueue::BoundedFutureQueue(int maximumNumberOfPendingFutures)
+ : m_maximumNumberOfPendingFutures(qMax(1, maximumNumberOfPendingFutures)), m_allSucceeded(true)
+{
+}
+
+BoundedFutureQueue::~BoundedFutureQueue()
+{
+    waitForAll();
+}
+
+void BoundedFutureQueue::enqueue(const QFuture<bool> &future)
+{
+    while (m_pendingFutures.size() >= m_maximumNumberOfPendingFutures)
+    {
+        waitForOldest();
+    }
+
+    m_pendingFutures.enqueue(future);
+}
+
+bool BoundedFutureQueue::waitForAll()
+{
+    while (!m_pendingFutures.isEmpty())
+    {
+        waitForOldest();
+    }
+
+    return m_allSucceeded;
+}
+
+int BoundedFutureQueue::getNumberOfPendingFutures() const
+{
+    return m_pendingFutures.size();
+}
+
+void BoundedFutureQueue::waitForOldest()
+{
+    // result() bloqueja fins que la tasca ha acabat
+    m_allSucceeded = m_pendingFutures.dequeue().result() && m_allSucceeded;
+}
+
+} // End namespace udg
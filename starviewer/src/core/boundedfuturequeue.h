@@ -0,0 +1,62 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+#ifndef UDGBOUNDEDFUTUREQUEUE_H
+#define UDGBOUNDEDFUTUREQUEUE_H
+
+#include <QFuture>
+#include <QQueue>
+
+namespace udg {
+
+/**
+    Cua de tasques en paral·lel (QFuture<bool>) amb un nombre màxim de tasques pendents.
+
+    Quan la cua és plena, en afegir-ne una de nova s'espera que acabi la més antiga. Així qui produeix les dades de les tasques
+    (p.ex. captures que s'han d'escriure a disc) no pot avançar-se indefinidament i no acumula totes les dades a memòria.
+  */
+class BoundedFutureQueue {
+public:
+    /// Crea una cua que com a molt tindrà el nombre de tasques pendents donat, que ha de ser com a mínim 1
+    explicit BoundedFutureQueue(int maximumNumberOfPendingFutures);
+    /// Espera que acabin les tasques pendents
+    ~BoundedFutureQueue();
+
+    /// Afegeix la tasca donada. Si ja hi ha el màxim de tasques pendents, abans espera que acabi la més antiga.
+    void enqueue(const QFuture<bool> &future);
+
+    /// Espera que acabin totes les tasques pendents. Retorna cert si totes les tasques afegides fins ara han retornat cert.
+    bool waitForAll();
+
+    /// Retorna el nombre de tasques afegides que encara no s'han esperat
+    int getNumberOfPendingFutures() const;
+
+private:
+    /// Espera que acabi la tasca més antiga i la treu de la cua
+    void waitForOldest();
+
+private:
+    /// Nombre màxim de tasques pendents
+    int m_maximumNumberOfPendingFutures;
+
+    /// Tasques pendents, de la més antiga a la més nova
+    QQueue<QFuture<bool> > m_pendingFutures;
+
+    /// Cert si totes les tasques esperades fins ara han retornat cert
+    bool m_allSucceeded;
+};
+
+} // End namespace udg
+
+#endif
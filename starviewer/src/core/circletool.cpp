@@ -144,7 +144,7 @@ void CircleTool::updateCircle()
 
     // Actualitzem la forma i renderitzem
     updatePolygonPoints();
-    m_2DViewer->render();
+    m_2DViewer->requestRender();
 }
 
 void CircleTool::getEndPoint()
@@ -224,7 +224,7 @@ void CircleTool::initialize()
     {
         m_circle->decreaseReferenceCount();
         delete m_circle;
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 
     m_circle = 0;
@@ -48,6 +48,8 @@ HEADERS += extensionfactory.h \
     volume.h \
     volumehelper.h \
     volumereader.h \
+    rawpixeldatacache.h \
+    memorymappeddataarray.h \
     volumepixeldatareader.h \
     volumepixeldatareadervtkgdcm.h \
     volumepixeldatareaderitkgdcm.h \
@@ -74,6 +76,7 @@ HEADERS += extensionfactory.h \
     imageoverlay.h \
     imageoverlayreader.h \
     dicomtagreader.h \
+    dcmdatasetcache.h \
     patientfiller.h \
     patientfillerstep.h \
     patientfillerinput.h \
@@ -120,6 +123,7 @@ HEADERS += extensionfactory.h \
     point3d.h \
     line3d.h \
     drawer.h \
+    drawerprimitiveindex.h \
     drawerprimitive.h \
     drawerpolygon.h \
     drawerline.h \
@@ -180,6 +184,7 @@ HEADERS += extensionfactory.h \
     combiningvoxelshader.h \
     viewpointgenerator.h \
     thumbnailcreator.h \
+    asynchronousthumbnailcreator.h \
     nonclosedangletool.h \
     abortrendercommand.h \
     roitool.h \
@@ -207,13 +212,17 @@ HEADERS += extensionfactory.h \
     settings.h \
     settingsregistry.h \
     settingsparser.h \
+    settingscache.h \
     defaultsettings.h \
     coresettings.h \
     settingsaccesslevelfilereader.h \
     shortcuts.h \
     shortcutmanager.h \
     volumebuilder.h \
+    apngwriter.h \
     volumebuilderfromcaptures.h \
+    viewerbatchcapturer.h \
+    boundedfuturequeue.h \
     dicomattribute.h \
     dicomvalueattribute.h \
     dicomsequenceattribute.h \
@@ -231,6 +240,7 @@ HEADERS += extensionfactory.h \
     patientorientation.h \
     imageorientation.h \
     photometricinterpretation.h \
+    stringinterner.h \
     qreleasenotes.h \
     qdicomdumpbrowser.h \
     applicationversionchecker.h \
@@ -283,6 +293,7 @@ HEADERS += extensionfactory.h \
     diagnosistestfactory.h \
     diagnosistestfactoryregister.h \
     slicelocator.h \
+    sliceprojectionindex.h \
     slicehandler.h \
     automaticsynchronizationtool.h \
     automaticsynchronizationtooldata.h \
@@ -411,6 +422,8 @@ HEADERS += extensionfactory.h \
     hangingprotocolimagesetrestriction.h \
     hangingprotocolimagesetrestrictionexpression.h \
     hangingprotocolfiller.h \
+    hangingprotocolcandidateindex.h \
+    floodfill.h \
     qfusionlayoutwidget.h \
     gridicon.h \
     itemmenu.h \
@@ -437,6 +450,8 @@ SOURCES += extensionmediator.cpp \
     volume.cpp \
     volumehelper.cpp \
     volumereader.cpp \
+    rawpixeldatacache.cpp \
+    memorymappeddataarray.cpp \
     volumepixeldatareader.cpp \
     volumepixeldatareadervtkgdcm.cpp \
     volumepixeldatareaderitkgdcm.cpp \
@@ -465,6 +480,7 @@ SOURCES += extensionmediator.cpp \
     imageoverlay.cpp \
     imageoverlayreader.cpp \
     dicomtagreader.cpp \
+    dcmdatasetcache.cpp \
     patientfiller.cpp \
     patientfillerstep.cpp \
     patientfillerinput.cpp \
@@ -511,6 +527,7 @@ SOURCES += extensionmediator.cpp \
     point3d.cpp \
     line3d.cpp \
     drawer.cpp \
+    drawerprimitiveindex.cpp \
     drawerprimitive.cpp \
     drawerpolygon.cpp \
     drawerline.cpp \
@@ -565,6 +582,7 @@ SOURCES += extensionmediator.cpp \
     combiningvoxelshader.cpp \
     viewpointgenerator.cpp \
     thumbnailcreator.cpp \
+    asynchronousthumbnailcreator.cpp \
     nonclosedangletool.cpp \
     abortrendercommand.cpp \
     roitool.cpp \
@@ -592,13 +610,17 @@ SOURCES += extensionmediator.cpp \
     settings.cpp \
     settingsregistry.cpp \
     settingsparser.cpp \
+    settingscache.cpp \
     defaultsettings.cpp \
     coresettings.cpp \
     settingsaccesslevelfilereader.cpp \
     shortcuts.cpp \
     shortcutmanager.cpp \
     volumebuilder.cpp \
+    apngwriter.cpp \
     volumebuilderfromcaptures.cpp \
+    viewerbatchcapturer.cpp \
+    boundedfuturequeue.cpp \
     dicomattribute.cpp \
     dicomvalueattribute.cpp \
     dicomsequenceattribute.cpp \
@@ -615,6 +637,7 @@ SOURCES += extensionmediator.cpp \
     patientorientation.cpp \
     imageorientation.cpp \
     photometricinterpretation.cpp \
+    stringinterner.cpp \
     qreleasenotes.cpp \
     qdicomdumpbrowser.cpp \
     applicationversionchecker.cpp \
@@ -663,6 +686,7 @@ SOURCES += extensionmediator.cpp \
     diagnosistestresult.cpp \
     applicationupdatechecker.cpp \
     slicelocator.cpp \
+    sliceprojectionindex.cpp \
     slicehandler.cpp \
     automaticsynchronizationtool.cpp \
     automaticsynchronizationtooldata.cpp \
@@ -787,6 +811,7 @@ SOURCES += extensionmediator.cpp \
     hangingprotocolimagesetrestriction.cpp \
     hangingprotocolimagesetrestrictionexpression.cpp \
     hangingprotocolfiller.cpp \
+    hangingprotocolcandidateindex.cpp \
     qfusionlayoutwidget.cpp \
     gridicon.cpp \
     itemmenu.cpp \
@@ -44,6 +44,13 @@ const QString CoreSettings::ForcedImageReaderLibrary("Input/ForcedImageReaderLib
 const QString CoreSettings::ForceITKImageReaderForSpecifiedModalities("Input/ForceITKImageReaderForSpecifiedModalities");
 const QString CoreSettings::ForceVTKImageReaderForSpecifiedModalities("Input/ForceVTKImageReaderForSpecifiedModalities");
 const QString CoreSettings::UseItkGdcmImageReaderByDefault("Input/UseItkGdcmImageReaderByDefault");
+const QString CoreSettings::KeepRetrievedImagesInMemory("Input/KeepRetrievedImagesInMemory");
+const QString CoreSettings::RetrievedImagesMemoryPoolSize("Input/RetrievedImagesMemoryPoolSize");
+const QString CoreSettings::CacheDecodedPixelData("Input/CacheDecodedPixelData");
+const QString CoreSettings::CacheDecodedPixelDataMaximumVolumeSize("Input/CacheDecodedPixelDataMaximumVolumeSize");
+const QString CoreSettings::OutOfCoreVolumeThreshold("Input/OutOfCoreVolumeThreshold");
+const QString CoreSettings::OutOfCoreVolumeDirectory("Input/OutOfCoreVolumeDirectory");
+const QString CoreSettings::CompressInactiveVolumes("Input/CompressInactiveVolumes");
 
 // Release Notes
 const QString CoreSettings::LastReleaseNotesVersionShown("LastReleaseNotesVersionShown");
@@ -70,6 +77,8 @@ const QString CoreSettings::QDICOMDumpBrowserGeometry("QDICOMDumpBrowserGeometry
 const QString CoreSettings::DefaultPACSListToQuery("PACS/defaultPACSListToQuery");
 //TODO:Aquesta clau està duplicada a InputOutputSettings
 const QString CoreSettings::PacsListConfigurationSectionName = "PacsList";
+//TODO:Aquesta clau està duplicada a InputOutputSettings
+const QString CoreSettings::LocalDatabaseCachePath("PACS/cache/imagePath");
 
 const QString CoreSettings::ExternalApplicationsConfigurationSectionName = "ExternalApplications";
 
@@ -127,6 +136,13 @@ void CoreSettings::init()
     settingsRegistry->addSetting(MammographyAutoOrientationExceptions, (QStringList() << "BAV" << "BAG" << "estereot"));
     settingsRegistry->addSetting(AllowAsynchronousVolumeLoading, true);
     settingsRegistry->addSetting(MaximumNumberOfVolumesLoadingConcurrently, 1);
+    settingsRegistry->addSetting(KeepRetrievedImagesInMemory, false);
+    settingsRegistry->addSetting(RetrievedImagesMemoryPoolSize, 512);
+    settingsRegistry->addSetting(CacheDecodedPixelData, false);
+    settingsRegistry->addSetting(CacheDecodedPixelDataMaximumVolumeSize, 1024);
+    settingsRegistry->addSetting(OutOfCoreVolumeThreshold, 4096);
+    settingsRegistry->addSetting(OutOfCoreVolumeDirectory, "", Settings::Parseable);
+    settingsRegistry->addSetting(CompressInactiveVolumes, false);
     settingsRegistry->addSetting(MaximumNumberOfVisibleVoiLutComboItems, 50);
     settingsRegistry->addSetting(EnableQ2DViewerSliceScrollLoop, false);
     settingsRegistry->addSetting(EnableQ2DViewerPhaseScrollLoop, false);
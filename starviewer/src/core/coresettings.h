@@ -52,6 +52,25 @@ public:
     /// If true, the ITK-GDCM image reader will be the default, instead of the new VTK-DCMTK.
     static const QString UseItkGdcmImageReaderByDefault;
 
+    /// If true, the images retrieved from PACS are also kept in memory so that the first read of the volume doesn't have to load them from disk.
+    static const QString KeepRetrievedImagesInMemory;
+    /// Maximum size in MB of the memory used to keep the retrieved images.
+    static const QString RetrievedImagesMemoryPoolSize;
+
+    /// If true, the decoded pixel data of the volumes of the local database is kept in raw files so that they can be reopened without decoding.
+    static const QString CacheDecodedPixelData;
+    /// Maximum size in MB of a volume whose decoded pixel data is kept in the raw files. Bigger volumes are always decoded again.
+    static const QString CacheDecodedPixelDataMaximumVolumeSize;
+
+    /// Size in MB from which the pixel data of a volume is stored in a temporary memory-mapped file instead of in memory. 0 disables it.
+    static const QString OutOfCoreVolumeThreshold;
+    /// Directory where the memory-mapped files of the out-of-core volumes are created.
+    /// If empty, the "outofcore" directory inside the local database cache is used.
+    static const QString OutOfCoreVolumeDirectory;
+
+    /// If true, the pixel data of the volumes that are not being displayed is compressed losslessly in memory.
+    static const QString CompressInactiveVolumes;
+
     /// La última versió comprobada de les Release Notes
     static const QString LastReleaseNotesVersionShown;
 
@@ -92,6 +111,8 @@ public:
     static const QString DefaultPACSListToQuery;
     //TODO: Aquesta clau està duplicada a InputOutputSettings
     static const QString PacsListConfigurationSectionName;
+    //TODO: Aquesta clau està duplicada a InputOutputSettings (CachePath)
+    static const QString LocalDatabaseCachePath;
 
     /// List containing the external applications.
     static const QString ExternalApplicationsConfigurationSectionName;
@@ -140,7 +140,7 @@ void Cursor3DTool::updatePosition()
                 m_crossHair->setCentrePoint(xyz[0], xyz[1], xyz[2]);
                 m_crossHair->setVisibility(true);
                 m_crossHair->update();
-                m_2DViewer->render();
+                m_2DViewer->requestRender();
                 // Punt al món real (DICOM)
                 m_myData->setOriginPointPosition(dicomWorldPosition);
             }
@@ -179,7 +179,7 @@ void Cursor3DTool::updateProjectedPoint()
         }
 
         m_crossHair->update();
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 }
 
@@ -260,7 +260,7 @@ void Cursor3DTool::hideCursor()
     {
         m_crossHair->setVisibility(false);
         m_crossHair->update();
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 }
 
@@ -36,6 +36,20 @@ CustomWindowLevelsLoader::~CustomWindowLevelsLoader()
 {
 }
 
+void CustomWindowLevelsLoader::loadDefaultsOnce()
+{
+// Amb starviewer lite no es fan servir els custom window levels per defecte
+#ifndef STARVIEWER_LITE
+    static bool defaultsLoaded = false;
+    if (!defaultsLoaded)
+    {
+        defaultsLoaded = true;
+        CustomWindowLevelsLoader loader;
+        loader.loadDefaults();
+    }
+#endif
+}
+
 void CustomWindowLevelsLoader::loadDefaults()
 {
     /// Custom Window Levels definits per l'usuari
@@ -33,6 +33,9 @@ public:
     /// Mètode que carrega els arxius XML definits a una adreça per defecte. (Hardcode)
     void loadDefaults();
 
+    /// Carrega els custom window levels per defecte el primer cop que es crida durant la sessió. Els següents cops no fa res.
+    static void loadDefaultsOnce();
+
     /// Mètode que carrega els arxius XML que contenen la informació dels custom window levels. El paràmetre pot ser el path d'un Directori o Fitxer.
     void loadXMLFiles(const QString &path);
 
@@ -0,0 +1,172 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#include "dcmdatasetcache.h"
+
+#include "logging.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+// Make sure OS specific configuration is included first
+#include <osconfig.h>
+#include <dcdatset.h>
+
+namespace udg {
+
+namespace {
+
+// Normalitza el path perquè el mateix fitxer es trobi encara que s'hi arribi amb separadors diferents
+QString getKey(const QString &filePath)
+{
+    return QDir::cleanPath(QDir::fromNativeSeparators(filePath));
+}
+
+}
+
+DcmDatasetCache::DcmDatasetCache(QObject *parent)
+ : QObject(parent), m_currentSize(0), m_maximumSize(0)
+{
+}
+
+DcmDatasetCache::~DcmDatasetCache()
+{
+}
+
+void DcmDatasetCache::setMaximumSize(qint64 maximumSize)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maximumSize = qMax(Q_INT64_C(0), maximumSize);
+    evictOldestDatasets();
+}
+
+qint64 DcmDatasetCache::getMaximumSize() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maximumSize;
+}
+
+qint64 DcmDatasetCache::getCurrentSize() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_currentSize;
+}
+
+void DcmDatasetCache::insert(const QString &filePath, DcmDataset *dataset)
+{
+    if (!dataset)
+    {
+        return;
+    }
+
+    Entry entry;
+    entry.dataset = QSharedPointer<DcmDataset>(dataset);
+    entry.size = dataset->getLength(dataset->getOriginalXfer());
+    entry.lastModified = QFileInfo(filePath).lastModified();
+
+    QMutexLocker locker(&m_mutex);
+
+    if (entry.size > m_maximumSize)
+    {
+        // No hi cap, el QSharedPointer l'esborrarà en sortir
+        return;
+    }
+
+    QString key = getKey(filePath);
+    removeEntry(key);
+
+    m_entries.insert(key, entry);
+    m_insertionOrder.enqueue(key);
+    m_currentSize += entry.size;
+
+    evictOldestDatasets();
+}
+
+QSharedPointer<DcmDataset> DcmDatasetCache::take(const QString &filePath)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QString key = getKey(filePath);
+    if (!m_entries.contains(key))
+    {
+        return QSharedPointer<DcmDataset>();
+    }
+
+    Entry entry = m_entries.value(key);
+    removeEntry(key);
+
+    if (entry.lastModified != QFileInfo(filePath).lastModified())
+    {
+        DEBUG_LOG(QString("El fitxer %1 s'ha modificat des que se'n va guardar el dataset, es descarta").arg(filePath));
+        return QSharedPointer<DcmDataset>();
+    }
+
+    return entry.dataset;
+}
+
+bool DcmDatasetCache::contains(const QString &filePath) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.contains(getKey(filePath));
+}
+
+void DcmDatasetCache::remove(const QString &filePath)
+{
+    QMutexLocker locker(&m_mutex);
+    removeEntry(getKey(filePath));
+}
+
+void DcmDatasetCache::removeDirectory(const QString &directoryPath)
+{
+    QString directoryKey = getKey(directoryPath) + "/";
+
+    QMutexLocker locker(&m_mutex);
+    foreach (const QString &key, m_entries.keys())
+    {
+        if (key.startsWith(directoryKey))
+        {
+            removeEntry(key);
+        }
+    }
+}
+
+void DcmDatasetCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+    m_insertionOrder.clear();
+    m_currentSize = 0;
+}
+
+void DcmDatasetCache::evictOldestDatasets()
+{
+    while (m_currentSize > m_maximumSize && !m_insertionOrder.isEmpty())
+    {
+        QString key = m_insertionOrder.dequeue();
+        m_currentSize -= m_entries.take(key).size;
+    }
+}
+
+void DcmDatasetCache::removeEntry(const QString &key)
+{
+    if (m_entries.contains(key))
+    {
+        m_currentSize -= m_entries.take(key).size;
+        m_insertionOrder.removeOne(key);
+    }
+}
+
+} // End namespace udg
@@ -0,0 +1,105 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#ifndef UDGDCMDATASETCACHE_H
+#define UDGDCMDATASETCACHE_H
+
+#include <QObject>
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QQueue>
+#include <QSharedPointer>
+
+class DcmDataset;
+
+namespace udg {
+
+/**
+    Magatzem en memòria, limitat en mida, dels DcmDataset d'imatges que s'acaben de descarregar.
+
+    Quan es descarrega una sèrie i s'obre de seguida, el primer VolumeReader::read() torna a llegir i parsejar del disc els fitxers que
+    s'acaben d'escriure. Si s'hi afegeixen els datasets rebuts en el moment de guardar-los, el lector els pot agafar d'aquí i estalviar-se
+    aquesta lectura. Cada dataset es lliura una sola vegada: take() el treu de la cache. Quan s'excedeix la mida màxima es descarten
+    els datasets més antics. Si el fitxer s'ha modificat des que es va guardar el dataset, aquest es descarta en comptes de lliurar-lo.
+
+    La classe és thread-safe, ja que s'hi insereix des del thread de descàrrega i s'hi llegeix des dels threads de lectura de volums.
+    S'ha d'accedir a través de SingletonPointer<DcmDatasetCache> per evitar problemes d'ordre de destrucció d'objectes estàtics amb dcmtk.
+  */
+class DcmDatasetCache : public QObject {
+Q_OBJECT
+public:
+    DcmDatasetCache(QObject *parent = 0);
+    ~DcmDatasetCache();
+
+    /// Defineix la mida màxima en bytes que poden ocupar els datasets guardats. Si ja se supera, es descarten els més antics.
+    void setMaximumSize(qint64 maximumSize);
+    qint64 getMaximumSize() const;
+
+    /// Retorna la mida en bytes que ocupen actualment els datasets guardats
+    qint64 getCurrentSize() const;
+
+    /// Guarda el dataset corresponent al fitxer donat i se'n fa propietari. Si el dataset no hi cap, s'esborra directament.
+    /// El fitxer ja ha d'estar escrit al disc, ja que se'n guarda la data de modificació.
+    void insert(const QString &filePath, DcmDataset *dataset);
+
+    /// Treu i retorna el dataset corresponent al fitxer donat. Si no hi és o el fitxer s'ha modificat després de guardar-lo
+    /// retorna un punter nul.
+    QSharedPointer<DcmDataset> take(const QString &filePath);
+
+    /// Indica si hi ha un dataset guardat pel fitxer donat
+    bool contains(const QString &filePath) const;
+
+    /// Esborra el dataset del fitxer donat, si n'hi ha
+    void remove(const QString &filePath);
+
+    /// Esborra els datasets de tots els fitxers que hi ha dins del directori donat
+    void removeDirectory(const QString &directoryPath);
+
+    /// Esborra tots els datasets guardats
+    void clear();
+
+private:
+    /// Descarta els datasets més antics fins que la mida ocupada no superi la mida màxima
+    void evictOldestDatasets();
+
+    /// Treu el dataset amb la clau donada. Cal tenir el mutex bloquejat
+    void removeEntry(const QString &key);
+
+private:
+    struct Entry
+    {
+        QSharedPointer<DcmDataset> dataset;
+        qint64 size;
+        /// Data de modificació del fitxer quan es va guardar el dataset
+        QDateTime lastModified;
+    };
+
+    /// Datasets guardats indexats pel path del fitxer
+    QHash<QString, Entry> m_entries;
+    /// Paths en l'ordre en què s'han inserit, per descartar primer els més antics
+    QQueue<QString> m_insertionOrder;
+
+    qint64 m_currentSize;
+    qint64 m_maximumSize;
+
+    /// Protegeix l'accés a totes les dades membre
+    mutable QMutex m_mutex;
+};
+
+} // End namespace udg
+
+#endif
@@ -32,6 +32,17 @@ DICOMDumpDefaultTagsLoader::~DICOMDumpDefaultTagsLoader()
 {
 }
 
+void DICOMDumpDefaultTagsLoader::loadDefaultsOnce()
+{
+    static bool defaultsLoaded = false;
+    if (!defaultsLoaded)
+    {
+        defaultsLoaded = true;
+        DICOMDumpDefaultTagsLoader loader;
+        loader.loadDefaults();
+    }
+}
+
 void DICOMDumpDefaultTagsLoader::loadDefaults()
 {
     /// DICOM Dump Default Tags definits per defecte, agafa el directori de l'executable TODO això podria ser un setting més
@@ -34,6 +34,9 @@ public:
     /// Mètode que carrega els arxius XML definits a una adreça per defecte. (Hardcode)
     void loadDefaults();
 
+    /// Carrega els default tags per defecte el primer cop que es crida durant la sessió. Els següents cops no fa res.
+    static void loadDefaultsOnce();
+
     /// Mètode que carrega els arxius XML que contenen la informació dels Tags. El paràmetre pot ser el path d'un Directori o Fitxer.
     void loadXMLFiles(const QString &path);
 
@@ -157,6 +157,15 @@ DcmDataset* DICOMTagReader::getDcmDataset() const
     return m_dicomData;
 }
 
+DcmDataset* DICOMTagReader::takeDcmDataset()
+{
+    DcmDataset *dcmDataset = m_dicomData;
+    m_dicomData = NULL;
+    m_hasValidFile = false;
+
+    return dcmDataset;
+}
+
 bool DICOMTagReader::tagExists(const DICOMTag &tag) const
 {
     if (!m_dicomData && !m_dicomHeader)
@@ -73,6 +73,10 @@ public:
     /// Retorna el Dataset de dcmtk que es fa servir internament
     DcmDataset* getDcmDataset() const;
 
+    /// Deixa de fer servir el DcmDataset actual sense esborrar-lo i el retorna. Qui el crida passa a ser-ne el propietari.
+    /// Permet reaprofitar el mateix DICOMTagReader per llegir datasets que pertanyen a un altre objecte.
+    DcmDataset* takeDcmDataset();
+
     /// Ens diu si el tag és present al fitxer o no. Cal haver fet un ús correcte de l'objecte m_dicomData.
     virtual bool tagExists(const DICOMTag &tag) const;
 
@@ -20,13 +20,40 @@
 #include <cmath>
 
 #include <QColor>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QPainter>
 #include <QRegExp>
 
+#include <vtkDataArray.h>
 #include <vtkImageData.h>
+#include <vtkPointData.h>
+#include <vtkWeakPointer.h>
 
 namespace udg {
 
+namespace {
+
+// Masks shared by getAsSharedVtkImageData(), indexed by the shutter geometry and the mask dimensions.
+// Only weak references are kept, so a mask is freed when no image uses it anymore.
+QMutex sharedMasksMutex;
+QHash<QString, vtkWeakPointer<vtkDataArray> > sharedMasks;
+
+// Returns the key of the shared mask for the given shape, polygon and dimensions
+QString getSharedMaskKey(DisplayShutter::ShapeType shape, const QPolygon &polygon, int width, int height)
+{
+    QString key = QString("%1:%2x%3").arg(shape).arg(width).arg(height);
+    foreach (const QPoint &point, polygon)
+    {
+        key += QString(";%1,%2").arg(point.x()).arg(point.y());
+    }
+
+    return key;
+}
+
+}
+
 DisplayShutter::DisplayShutter()
 {
     m_shape = UndefinedShape;
@@ -310,6 +337,41 @@ vtkSmartPointer<vtkImageData> DisplayShutter::getAsVtkImageData(int width, int h
     return VtkImageDataCreator().setDimensions({{width, height, 1}}).setNumberOfComponents(4).create(shutterImage.constBits());
 }
 
+vtkSmartPointer<vtkImageData> DisplayShutter::getAsSharedVtkImageData(int width, int height) const
+{
+    // The shutter value is not part of the key because it's not used to paint the mask
+    QString key = getSharedMaskKey(m_shape, m_shutterPolygon, width, height);
+
+    vtkSmartPointer<vtkDataArray> scalars;
+    {
+        QMutexLocker locker(&sharedMasksMutex);
+        scalars = sharedMasks.value(key);
+
+        if (!scalars)
+        {
+            scalars = getAsVtkImageData(width, height)->GetPointData()->GetScalars();
+
+            // Remove the masks that have been freed before adding the new one
+            QMutableHashIterator<QString, vtkWeakPointer<vtkDataArray> > iterator(sharedMasks);
+            while (iterator.hasNext())
+            {
+                if (!iterator.next().value())
+                {
+                    iterator.remove();
+                }
+            }
+
+            sharedMasks.insert(key, scalars.GetPointer());
+        }
+    }
+
+    vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+    imageData->SetDimensions(width, height, 1);
+    imageData->GetPointData()->SetScalars(scalars);
+
+    return imageData;
+}
+
 DisplayShutter DisplayShutter::intersection(const QList<DisplayShutter> &shuttersList)
 {
     if (shuttersList.isEmpty())
@@ -85,6 +85,11 @@ public:
 
     /// Returns the shutter in vtkImageData format, with extent defined by given width and height.
     vtkSmartPointer<vtkImageData> getAsVtkImageData(int width, int height) const;
+
+    /// Returns the shutter in vtkImageData format like getAsVtkImageData(), but the scalars are shared with all the other vtkImageData returned
+    /// by this method for a shutter with the same geometry and the same width and height. This way, all the frames of a series with the same shutter
+    /// keep a single mask in memory. The returned object is new on each call, so its origin and spacing can be modified, but its scalars must not.
+    vtkSmartPointer<vtkImageData> getAsSharedVtkImageData(int width, int height) const;
     
     /// Donada una llista de shutters, ens retorna el shutter resultant de la intersecció d'aquests. 
     /// En quant al color resultant, serà la mitjana de tots els shutters de la llista.
@@ -51,7 +51,7 @@ void DistanceTool::deleteTemporalRepresentation()
 
     if (hasToRefresh)
     {
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 
     m_lineState = NoPointFixed;
@@ -133,7 +133,7 @@ void DistanceTool::simulateLine()
 
         m_distanceLine->setSecondPoint(clickedWorldPoint);
         m_distanceLine->update();
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 }
 
@@ -36,24 +36,17 @@ Drawer::~Drawer()
 
 void Drawer::draw(DrawerPrimitive *primitive, const OrthogonalPlane &plane, int slice)
 {
-    switch (plane)
+    DrawerPrimitiveIndex *primitiveIndex = getPrimitiveIndex(plane);
+    if (!primitiveIndex)
     {
-        case OrthogonalPlane::XYPlane:
-            m_XYPlanePrimitives.insert(slice, primitive);
-            break;
-
-        case OrthogonalPlane::YZPlane:
-            m_YZPlanePrimitives.insert(slice, primitive);
-            break;
-
-        case OrthogonalPlane::XZPlane:
-            m_XZPlanePrimitives.insert(slice, primitive);
-            break;
+        DEBUG_LOG("Pla no definit!");
+        return;
+    }
 
-        default:
-            DEBUG_LOG("Pla no definit!");
-            return;
-            break;
+    if (!primitiveIndex->insert(primitive, slice))
+    {
+        // Tornar a dibuixar una primitiva que ja és al pla (p.ex. la llavor del SeedTool quan es canvia de llesca) la mou a la nova llesca
+        primitiveIndex->move(primitive, slice);
     }
 
     // Segons quin sigui el pla actual caldrà comprovar
@@ -84,29 +77,15 @@ void Drawer::draw(DrawerPrimitive *primitive)
 
 void Drawer::clearViewer()
 {
-    QMultiMap<int, DrawerPrimitive*> primitivesContainer;
-    switch (m_currentPlane)
+    DrawerPrimitiveIndex *primitiveIndex = getPrimitiveIndex(m_currentPlane);
+    if (!primitiveIndex)
     {
-        case OrthogonalPlane::XYPlane:
-            primitivesContainer = m_XYPlanePrimitives;
-            break;
-
-        case OrthogonalPlane::YZPlane:
-            primitivesContainer = m_YZPlanePrimitives;
-            break;
-
-        case OrthogonalPlane::XZPlane:
-            primitivesContainer = m_XZPlanePrimitives;
-            break;
-
-        default:
-            DEBUG_LOG("Pla no definit!");
-            return;
-            break;
+        DEBUG_LOG("Pla no definit!");
+        return;
     }
 
     // Obtenim les primitives de la vista i llesca actuals
-    QList<DrawerPrimitive*> list = primitivesContainer.values(m_currentSlice);
+    QList<DrawerPrimitive*> list = primitiveIndex->getPrimitives(m_currentSlice);
     // Eliminem totes aquelles primitives que estiguin a la llista, que no tinguin "propietaris" i que siguin esborrables
     // Al fer delete es cridarà el mètode erasePrimitive() que ja s'encarrega de fer la "feina bruta"
     foreach (DrawerPrimitive *primitive, list)
@@ -123,6 +102,7 @@ void Drawer::addToGroup(DrawerPrimitive *primitive, const QString &groupName)
 {
     // No comprovem si ja existeix ni si està en cap altre de les llistes, no cal.
     m_primitiveGroups.insert(groupName, primitive);
+    m_groupsOfPrimitive.insert(primitive, groupName);
 }
 
 void Drawer::refresh()
@@ -149,9 +129,9 @@ void Drawer::refresh()
 
 void Drawer::removeAllPrimitives()
 {
-    QList <DrawerPrimitive*> list = m_XYPlanePrimitives.values();
-    QList <DrawerPrimitive*> sagitalList = m_YZPlanePrimitives.values();
-    QList <DrawerPrimitive*> coronalList = m_XZPlanePrimitives.values();
+    QList <DrawerPrimitive*> list = m_XYPlanePrimitives.getAllPrimitives();
+    QList <DrawerPrimitive*> sagitalList = m_YZPlanePrimitives.getAllPrimitives();
+    QList <DrawerPrimitive*> coronalList = m_XZPlanePrimitives.getAllPrimitives();
 
     list += sagitalList;
     list += coronalList;
@@ -184,32 +164,17 @@ void Drawer::erasePrimitive(DrawerPrimitive *primitive)
     }
 
     // Mirem si està en algun grup
-    QMutableMapIterator<QString, DrawerPrimitive*> groupsIterator(m_primitiveGroups);
-    while (groupsIterator.hasNext())
+    foreach (const QString &groupName, m_groupsOfPrimitive.values(primitive))
     {
-        groupsIterator.next();
-        if (primitive == groupsIterator.value())
-        {
-            groupsIterator.remove();
-        }
+        m_primitiveGroups.remove(groupName, primitive);
     }
+    m_groupsOfPrimitive.remove(primitive);
+    m_disabledPrimitives.remove(primitive);
 
-    // Busquem en el pla axial
-    if (erasePrimitiveFromContainer(primitive, m_XYPlanePrimitives))
-    {
-        // En principi una mateixa primitiva només estarà en una de les llistes
-        return;
-    }
-
-    // Busquem en el pla sagital
-    if (erasePrimitiveFromContainer(primitive, m_YZPlanePrimitives))
-    {
-        return;
-    }
-
-    // Busquem en el pla coronal
-    if (erasePrimitiveFromContainer(primitive, m_XZPlanePrimitives))
+    // En principi una mateixa primitiva només estarà en un dels plans
+    if (m_XYPlanePrimitives.remove(primitive) || m_YZPlanePrimitives.remove(primitive) || m_XZPlanePrimitives.remove(primitive))
     {
+        m_2DViewer->getRenderer()->RemoveViewProp(primitive->getAsVtkProp());
         return;
     }
 
@@ -224,21 +189,13 @@ void Drawer::erasePrimitive(DrawerPrimitive *primitive)
 
 void Drawer::hide(const OrthogonalPlane &plane, int slice)
 {
-    QList<DrawerPrimitive*> primitivesList;
-    switch (plane)
+    DrawerPrimitiveIndex *primitiveIndex = getPrimitiveIndex(plane);
+    if (!primitiveIndex)
     {
-        case OrthogonalPlane::XYPlane:
-            primitivesList = m_XYPlanePrimitives.values(slice);
-            break;
-
-        case OrthogonalPlane::YZPlane:
-            primitivesList = m_YZPlanePrimitives.values(slice);
-            break;
-
-        case OrthogonalPlane::XZPlane:
-            primitivesList = m_XZPlanePrimitives.values(slice);
-            break;
+        return;
     }
+
+    QList<DrawerPrimitive*> primitivesList = primitiveIndex->getPrimitives(slice);
     foreach (DrawerPrimitive *primitive, primitivesList)
     {
         if (primitive->isVisible())
@@ -251,22 +208,14 @@ void Drawer::hide(const OrthogonalPlane &plane, int slice)
 
 void Drawer::show(const OrthogonalPlane &plane, int slice)
 {
-    QList<DrawerPrimitive*> primitivesList;
-    switch (plane)
+    DrawerPrimitiveIndex *primitiveIndex = getPrimitiveIndex(plane);
+    if (!primitiveIndex)
     {
-        case OrthogonalPlane::XYPlane:
-            primitivesList = m_XYPlanePrimitives.values(slice);
-            break;
-
-        case OrthogonalPlane::YZPlane:
-            primitivesList = m_YZPlanePrimitives.values(slice);
-            break;
-
-        case OrthogonalPlane::XZPlane:
-            primitivesList = m_XZPlanePrimitives.values(slice);
-            break;
+        return;
     }
 
+    QList<DrawerPrimitive*> primitivesList = primitiveIndex->getPrimitives(slice);
+
     foreach (DrawerPrimitive *primitive, primitivesList)
     {
         if (!m_disabledPrimitives.contains(primitive) && (primitive->isModified() || !primitive->isVisible()))
@@ -279,7 +228,7 @@ void Drawer::show(const OrthogonalPlane &plane, int slice)
 
 int Drawer::getNumberOfDrawnPrimitives()
 {
-    return (m_XYPlanePrimitives.size() + m_YZPlanePrimitives.size() + m_XZPlanePrimitives.size());
+    return (m_XYPlanePrimitives.getNumberOfPrimitives() + m_YZPlanePrimitives.getNumberOfPrimitives() + m_XZPlanePrimitives.getNumberOfPrimitives());
 }
 
 void Drawer::disableGroup(const QString &groupName)
@@ -306,23 +255,13 @@ void Drawer::disableGroup(const QString &groupName)
 
 void Drawer::enableGroup(const QString &groupName)
 {
-    QList<DrawerPrimitive*> currentVisiblePrimitives;
-    int currentSlice = m_2DViewer->getCurrentSlice();
-    switch (m_2DViewer->getView())
+    QSet<DrawerPrimitive*> currentVisiblePrimitives;
+    DrawerPrimitiveIndex *primitiveIndex = getPrimitiveIndex(m_2DViewer->getView());
+    if (primitiveIndex)
     {
-        case OrthogonalPlane::XYPlane:
-            currentVisiblePrimitives = m_XYPlanePrimitives.values(currentSlice);
-            break;
-
-        case OrthogonalPlane::YZPlane:
-            currentVisiblePrimitives = m_YZPlanePrimitives.values(currentSlice);
-            break;
-
-        case OrthogonalPlane::XZPlane:
-            currentVisiblePrimitives = m_XZPlanePrimitives.values(currentSlice);
-            break;
+        currentVisiblePrimitives = primitiveIndex->getPrimitives(m_2DViewer->getCurrentSlice()).toSet();
     }
-    currentVisiblePrimitives << m_top2DPlanePrimitives;
+    currentVisiblePrimitives += m_top2DPlanePrimitives.toSet();
 
     bool hasToRender = false;
     QList<DrawerPrimitive*> groupPrimitives = m_primitiveGroups.values(groupName);
@@ -357,22 +296,10 @@ DrawerPrimitive* Drawer::getNearestErasablePrimitiveToPoint(double point[3], con
 
     DrawerPrimitive *nearestPrimitive = 0;
 
-    switch (view)
+    DrawerPrimitiveIndex *primitiveIndex = getPrimitiveIndex(view);
+    if (primitiveIndex)
     {
-        case OrthogonalPlane::XYPlane:
-            primitivesList = m_XYPlanePrimitives.values(slice);
-            break;
-
-        case OrthogonalPlane::YZPlane:
-            primitivesList = m_YZPlanePrimitives.values(slice);
-            break;
-
-        case OrthogonalPlane::XZPlane:
-            primitivesList = m_XZPlanePrimitives.values(slice);
-            break;
-
-        default:
-            break;
+        primitivesList = primitiveIndex->getPrimitives(slice);
     }
 
     double localClosestPoint[3];
@@ -398,22 +325,10 @@ void Drawer::erasePrimitivesInsideBounds(double bounds[6], const OrthogonalPlane
 {
     QList<DrawerPrimitive*> primitivesList;
 
-    switch (view)
+    DrawerPrimitiveIndex *primitiveIndex = getPrimitiveIndex(view);
+    if (primitiveIndex)
     {
-        case OrthogonalPlane::XYPlane:
-            primitivesList = m_XYPlanePrimitives.values(slice);
-            break;
-
-        case OrthogonalPlane::YZPlane:
-            primitivesList = m_YZPlanePrimitives.values(slice);
-            break;
-
-        case OrthogonalPlane::XZPlane:
-            primitivesList = m_XZPlanePrimitives.values(slice);
-            break;
-
-        default:
-            break;
+        primitivesList = primitiveIndex->getPrimitives(slice);
     }
 
     foreach (DrawerPrimitive *primitive, primitivesList)
@@ -448,22 +363,22 @@ bool Drawer::isPrimitiveInside(DrawerPrimitive *primitive, const OrthogonalPlane
     return inside;
 }
 
-bool Drawer::erasePrimitiveFromContainer(DrawerPrimitive *primitive, QMultiMap<int, DrawerPrimitive*> &primitiveContainer)
+DrawerPrimitiveIndex* Drawer::getPrimitiveIndex(const OrthogonalPlane &plane)
 {
-    bool found = false;
-    QMutableMapIterator<int, DrawerPrimitive*> containerIterator(primitiveContainer);
-    while (containerIterator.hasNext() && !found)
+    switch (plane)
     {
-        containerIterator.next();
-        if (primitive == containerIterator.value())
-        {
-            found = true;
-            containerIterator.remove();
-            m_2DViewer->getRenderer()->RemoveViewProp(primitive->getAsVtkProp());
-        }
-    }
+        case OrthogonalPlane::XYPlane:
+            return &m_XYPlanePrimitives;
+
+        case OrthogonalPlane::YZPlane:
+            return &m_YZPlanePrimitives;
 
-    return found;
+        case OrthogonalPlane::XZPlane:
+            return &m_XZPlanePrimitives;
+
+        default:
+            return 0;
+    }
 }
 
 void Drawer::renderPrimitive(DrawerPrimitive *primitive)
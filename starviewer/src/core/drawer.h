@@ -16,10 +16,12 @@
 #define UDGDRAWER_H
 
 #include <QObject>
+#include <QMultiHash>
 #include <QMultiMap>
 #include <QSet>
 
 #include "q2dviewer.h"
+#include "drawerprimitiveindex.h"
 
 namespace udg {
 
@@ -91,9 +93,8 @@ private:
     /// Ens diu si la primitiva donada, que es troba a la vista view, està dins dels bounds indicats
     bool isPrimitiveInside(DrawerPrimitive *primitive, const OrthogonalPlane &view, double bounds[6]);
 
-    /// Esborra la primitiva donada del contenidor de primitives especificat.
-    /// Si la troba l'esborra. Retorna cert si la troba, fals altrament.
-    bool erasePrimitiveFromContainer(DrawerPrimitive *primitive, QMultiMap<int, DrawerPrimitive*> &primitiveContainer);
+    /// Retorna l'índex de primitives del pla donat, o nul si el pla no és vàlid
+    DrawerPrimitiveIndex* getPrimitiveIndex(const OrthogonalPlane &plane);
 
     /// Fa que la primitiva es pugui visualitzar al visor associat
     void renderPrimitive(DrawerPrimitive *primitive);
@@ -106,10 +107,10 @@ private:
     /// Viewer sobre el qual pintarem les primitives
     Q2DViewer *m_2DViewer;
 
-    /// Contenidors de primitives per cada pla possible
-    QMultiMap<int, DrawerPrimitive*> m_XYPlanePrimitives;
-    QMultiMap<int, DrawerPrimitive*> m_YZPlanePrimitives;
-    QMultiMap<int, DrawerPrimitive*> m_XZPlanePrimitives;
+    /// Índexs de primitives per cada pla possible
+    DrawerPrimitiveIndex m_XYPlanePrimitives;
+    DrawerPrimitiveIndex m_YZPlanePrimitives;
+    DrawerPrimitiveIndex m_XZPlanePrimitives;
     QList<DrawerPrimitive*> m_top2DPlanePrimitives;
 
     /// Pla i llesca en el que es troba en aquell moment el 2D Viewer. Serveix per controlar
@@ -120,6 +121,9 @@ private:
     /// Grups de primitives. Les agrupem per nom
     QMultiMap<QString, DrawerPrimitive*> m_primitiveGroups;
 
+    /// Grups als quals pertany cada primitiva, per no haver de recórrer tots els grups en esborrar-la
+    QMultiHash<DrawerPrimitive*, QString> m_groupsOfPrimitive;
+
     /// Conjunt de primitives en estat disabled
     QSet<DrawerPrimitive*> m_disabledPrimitives;
 };
@@ -0,0 +1,90 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#include "drawerprimitiveindex.h"
+
+namespace udg {
+
+DrawerPrimitiveIndex::DrawerPrimitiveIndex()
+{
+}
+
+DrawerPrimitiveIndex::~DrawerPrimitiveIndex()
+{
+}
+
+bool DrawerPrimitiveIndex::insert(DrawerPrimitive *primitive, int slice)
+{
+    if (contains(primitive))
+    {
+        return false;
+    }
+
+    m_primitivesBySlice.insert(slice, primitive);
+    m_sliceOfPrimitive.insert(primitive, slice);
+
+    return true;
+}
+
+bool DrawerPrimitiveIndex::move(DrawerPrimitive *primitive, int slice)
+{
+    if (!remove(primitive))
+    {
+        return false;
+    }
+
+    return insert(primitive, slice);
+}
+
+bool DrawerPrimitiveIndex::remove(DrawerPrimitive *primitive)
+{
+    QHash<DrawerPrimitive*, int>::iterator sliceIterator = m_sliceOfPrimitive.find(primitive);
+    if (sliceIterator == m_sliceOfPrimitive.end())
+    {
+        return false;
+    }
+
+    m_primitivesBySlice.remove(sliceIterator.value(), primitive);
+    m_sliceOfPrimitive.erase(sliceIterator);
+
+    return true;
+}
+
+bool DrawerPrimitiveIndex::contains(DrawerPrimitive *primitive) const
+{
+    return m_sliceOfPrimitive.contains(primitive);
+}
+
+int DrawerPrimitiveIndex::getSlice(DrawerPrimitive *primitive) const
+{
+    return m_sliceOfPrimitive.value(primitive);
+}
+
+QList<DrawerPrimitive*> DrawerPrimitiveIndex::getPrimitives(int slice) const
+{
+    return m_primitivesBySlice.values(slice);
+}
+
+QList<DrawerPrimitive*> DrawerPrimitiveIndex::getAllPrimitives() const
+{
+    return m_primitivesBySlice.values();
+}
+
+int DrawerPrimitiveIndex::getNumberOfPrimitives() const
+{
+    return m_primitivesBySlice.size();
+}
+
+}
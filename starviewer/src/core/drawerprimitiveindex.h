@@ -0,0 +1,76 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#ifndef UDGDRAWERPRIMITIVEINDEX_H
+#define UDGDRAWERPRIMITIVEINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QMultiHash>
+
+namespace udg {
+
+class DrawerPrimitive;
+
+/**
+    Índex de les primitives dibuixades en un pla per llesca.
+
+    Les primitives es guarden agrupades per llesca, de manera que obtenir les d'una llesca només depèn
+    del nombre de primitives retornades, i es manté la llesca de cada primitiva perquè esborrar-la no requereixi recórrer tot l'índex.
+    Només es consulten llesques individuals, mai rangs de llesques, i per tant no cal mantenir-les ordenades.
+
+    Una primitiva només pot ser a una llesca. Per canviar-la de llesca s'ha de fer servir move(); insert() no modifica les primitives
+    que ja hi són.
+  */
+class DrawerPrimitiveIndex {
+public:
+    DrawerPrimitiveIndex();
+    ~DrawerPrimitiveIndex();
+
+    /// Afegeix la primitiva a la llesca donada. Si la primitiva ja és a l'índex no fa res i retorna fals.
+    bool insert(DrawerPrimitive *primitive, int slice);
+
+    /// Mou la primitiva, que ja ha de ser a l'índex, a la llesca donada. Retorna fals si la primitiva no hi era.
+    bool move(DrawerPrimitive *primitive, int slice);
+
+    /// Treu la primitiva de l'índex. Retorna cert si hi era, fals altrament.
+    bool remove(DrawerPrimitive *primitive);
+
+    /// Retorna cert si la primitiva és a l'índex
+    bool contains(DrawerPrimitive *primitive) const;
+
+    /// Retorna la llesca de la primitiva donada. La primitiva ha de ser a l'índex.
+    int getSlice(DrawerPrimitive *primitive) const;
+
+    /// Retorna les primitives de la llesca donada
+    QList<DrawerPrimitive*> getPrimitives(int slice) const;
+
+    /// Retorna totes les primitives de l'índex
+    QList<DrawerPrimitive*> getAllPrimitives() const;
+
+    /// Retorna el nombre de primitives de l'índex
+    int getNumberOfPrimitives() const;
+
+private:
+    /// Primitives per llesca
+    QMultiHash<int, DrawerPrimitive*> m_primitivesBySlice;
+
+    /// Llesca de cada primitiva
+    QHash<DrawerPrimitive*, int> m_sliceOfPrimitive;
+};
+
+}
+
+#endif
@@ -18,6 +18,9 @@
 #include "voilut.h"
 #include "volume.h"
 #include "volumepixeldataiterator.h"
+#include "volumepixeldata.h"
+#include "floodfill.h"
+#include "logging.h"
 
 // Vtk
 #include <vtkCommand.h>
@@ -29,6 +32,7 @@
 #include <vtkDataSetMapper.h>
 #include <vtkRenderWindowInteractor.h>
 #include <vtkCellType.h>
+#include <vtkSetGet.h>
 
 namespace udg {
 
@@ -170,7 +174,7 @@ void EditorTool::increaseState()
             m_editorState = EraseRegion;
             m_2DViewer->setCursor(QCursor(QPixmap(":/images/cursors/translate-erase.svg")));
             m_squareActor->VisibilityOff();
-            m_2DViewer->render();
+            m_2DViewer->requestRender();
             break;
 
         case EraseRegion:
@@ -208,7 +212,7 @@ void EditorTool::decreaseState()
             m_editorState = EraseSlice;
             m_2DViewer->setCursor(QCursor(QPixmap(":/images/cursors/slice-erase.svg")));
             m_squareActor->VisibilityOff();
-            m_2DViewer->render();
+            m_2DViewer->requestRender();
             break;
 
         case Erase:
@@ -274,7 +278,7 @@ void EditorTool::setEditorPoint()
             }
             m_myData->setVolumeVoxels(m_volumeCont);
             m_2DViewer->updateOverlay();
-            m_2DViewer->render();
+            m_2DViewer->requestRender();
         }
     }
 }
@@ -329,7 +333,7 @@ void EditorTool::setPaintCursor()
 
         m_2DViewer->getRenderer()->AddViewProp(m_squareActor);
         m_2DViewer->getRenderer()->ResetCameraClippingRange();
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
 
         squareMapper->Delete();
         points->Delete();
@@ -433,33 +437,34 @@ void EditorTool::eraseRegionMask()
     double spacing[3];
     int index[3];
     int ext[6];
-    m_2DViewer->getMainInput()->getExtent(ext);
     m_2DViewer->getCurrentCursorImageCoordinate(pos);
     m_2DViewer->getMainInput()->getSpacing(spacing);
     m_2DViewer->getMainInput()->getOrigin(origin);
     index[0] = (int)((((double)pos[0] - origin[0]) / spacing[0]) + 0.5);
     index[1] = (int)((((double)pos[1] - origin[1]) / spacing[1]) + 0.5);
     index[2] = m_2DViewer->getCurrentSlice();
-    eraseRegionMaskRecursive(index[0], index[1], index[2]);
-}
 
-void EditorTool::eraseRegionMaskRecursive(int a, int b, int c)
-{
-    int ext[6];
-    m_2DViewer->getMainInput()->getExtent(ext);
-    if ((a >= ext[0]) && (a <= ext[1]) && (b >= ext[2]) && (b <= ext[3]) && (c >= ext[4]) && (c <= ext[5]))
+    // L'esborrat és en 2D, per tant restringim l'extensió a la llesca actual
+    Volume *overlay = m_2DViewer->getOverlayInput();
+    overlay->getExtent(ext);
+    if (index[2] < ext[4] || index[2] > ext[5])
     {
-        VolumePixelDataIterator it = m_2DViewer->getOverlayInput()->getIterator(a, b, c);
-        if (it.get<int>() == m_insideValue)
-        {
-            it.set(m_outsideValue);
-            m_volumeCont--;
-            eraseRegionMaskRecursive(a + 1, b, c);
-            eraseRegionMaskRecursive(a - 1, b, c);
-            eraseRegionMaskRecursive(a, b + 1, c);
-            eraseRegionMaskRecursive(a, b - 1, c);
-        }
+        return;
     }
+    ext[4] = ext[5] = index[2];
+
+    int numberOfErasedVoxels = 0;
+    void *scalarPointer = overlay->getScalarPointer(ext[0], ext[2], ext[4]);
+    switch (overlay->getPixelData()->getScalarType())
+    {
+        vtkTemplateMacro(numberOfErasedVoxels = FloodFill::replaceValue(static_cast<VTK_TT*>(scalarPointer), ext, index[0], index[1], index[2],
+                                                                        static_cast<VTK_TT>(m_insideValue), static_cast<VTK_TT>(m_outsideValue)));
+
+        default:
+            ERROR_LOG("Unknown scalar type");
+    }
+
+    m_volumeCont -= numberOfErasedVoxels;
 }
 
 void EditorTool::increaseEditorSize()
@@ -74,10 +74,6 @@ private:
     /// Esborra una porció conectada de la màscara (en 2D)
     void eraseRegionMask();
 
-    /// Crida recursiva de la funció eraseRegionMask
-    /// @param a, @param b, @param c índex del volum de la màscara que estem mirant en cada crida
-    void eraseRegionMaskRecursive(int a, int b, int c);
-
     /// Decrementa un estat de la tool. Ordre: Paint, Erase, EraseRegion, EraseSlice
     void decreaseState();
 
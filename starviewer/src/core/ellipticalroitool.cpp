@@ -45,7 +45,7 @@ void EllipticalROITool::deleteTemporalRepresentation()
     {
         m_roiPolygon->decreaseReferenceCount();
         delete m_roiPolygon;
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 
     m_roiPolygon = 0;
@@ -166,7 +166,7 @@ void EllipticalROITool::simulateEllipse()
 
         // Actualitzem la forma i renderitzem
         updatePolygonPoints();
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 }
 
@@ -243,7 +243,7 @@ void EllipticalROITool::initialize()
     {
         m_roiPolygon->decreaseReferenceCount();
         delete m_roiPolygon;
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 
     m_roiPolygon = 0;
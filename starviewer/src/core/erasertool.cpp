@@ -58,7 +58,7 @@ void EraserTool::handleEvent(unsigned long eventID)
         case vtkCommand::LeftButtonReleaseEvent:
             erasePrimitive();
             reset();
-            m_2DViewer->render();
+            m_2DViewer->requestRender();
             break;
 
         default:
@@ -117,7 +117,7 @@ void EraserTool::drawAreaOfErasure()
             m_polygon->setVertix(3, m_startPoint);
             // Actualitzem els atributs de la polilinia
             m_polygon->update();
-            m_2DViewer->render();
+            m_2DViewer->requestRender();
         }
     }
 }
@@ -130,7 +130,7 @@ void EraserTool::erasePrimitive()
         if (primitiveToErase)
         {
             m_2DViewer->getDrawer()->erasePrimitive(primitiveToErase);
-            m_2DViewer->render();
+            m_2DViewer->requestRender();
         }
     }
     else
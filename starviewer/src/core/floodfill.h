@@ -0,0 +1,260 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#ifndef UDGFLOODFILL_H
+#define UDGFLOODFILL_H
+
+#include <QVector>
+
+namespace udg {
+
+/**
+    Omple regions connexes d'una graella 3D a partir d'una llavor, de manera iterativa i per segments (scanline).
+
+    En comptes de visitar els vòxels un a un, cada llavor s'estén tant com es pot al llarg de l'eix X i es marca tot el segment de cop.
+    Després es recorren les files veïnes dins el rang del segment i només s'afegeix una nova llavor per cada tram consecutiu de vòxels a omplir.
+    Així la pila creix amb el nombre de segments i no amb el de vòxels, i no hi ha cap risc de desbordar la pila del programa.
+
+    La regió a omplir es descriu amb un objecte que ha de proporcionar els mètodes següents:
+        bool isInside(int x, int y, int z) const   Cert si el vòxel pertany a la regió i encara no s'ha omplert
+        void mark(int x, int y, int z)             Omple el vòxel. Després d'omplir-lo, isInside() ha de retornar fals
+    Per omplir regions d'un sol valor directament sobre un buffer hi ha replaceValue().
+
+    Per fer un omplert 2D només cal passar una extensió amb una sola llesca: amb SixConnectivity s'obté 4-connectivitat i
+    amb les altres, 8-connectivitat.
+  */
+class FloodFill {
+public:
+    /// Veïnat que es considera connectat a cada vòxel
+    enum Connectivity {
+        /// Vòxels que comparteixen una cara
+        SixConnectivity,
+        /// Vòxels que comparteixen una cara o una aresta
+        EighteenConnectivity,
+        /// Vòxels que comparteixen una cara, una aresta o un vèrtex
+        TwentySixConnectivity
+    };
+
+    /// Omple la regió connectada a la llavor (seedX, seedY, seedZ) dins l'extensió donada ([xmin, xmax, ymin, ymax, zmin, zmax]).
+    /// Retorna el nombre de vòxels omplerts, 0 si la llavor és fora de l'extensió o no pertany a la regió.
+    template <typename Region>
+    static int fill(Region &region, const int extent[6], int seedX, int seedY, int seedZ, Connectivity connectivity = SixConnectivity);
+
+    /// Canvia per newValue tots els vòxels amb valor targetValue connectats a la llavor.
+    /// El buffer és contigu, amb X com a índex més ràpid, i el seu primer element correspon a l'origen de l'extensió.
+    /// Retorna el nombre de vòxels modificats.
+    template <typename T>
+    static int replaceValue(T *buffer, const int extent[6], int seedX, int seedY, int seedZ, T targetValue, T newValue,
+                            Connectivity connectivity = SixConnectivity);
+
+private:
+    /// Regió definida pels vòxels d'un buffer que tenen un valor concret
+    template <typename T>
+    class ValueRegion {
+    public:
+        ValueRegion(T *buffer, const int extent[6], T targetValue, T newValue);
+
+        bool isInside(int x, int y, int z) const;
+        void mark(int x, int y, int z);
+
+    private:
+        T* getPointer(int x, int y, int z) const;
+
+    private:
+        T *m_buffer;
+        int m_origin[3];
+        int m_rowSize;
+        int m_sliceSize;
+        T m_targetValue;
+        T m_newValue;
+    };
+
+    /// Fila veïna d'un segment: desplaçament en Y i Z i quants vòxels cal ampliar el segment en X per trobar-hi veïns
+    struct NeighbourRow
+    {
+        int dy;
+        int dz;
+        int expansion;
+    };
+
+    /// Llavor pendent de processar
+    struct Seed
+    {
+        int x;
+        int y;
+        int z;
+    };
+
+    /// Omple rows amb les files veïnes corresponents a la connectivitat donada i retorna quantes n'hi ha
+    static int getNeighbourRows(Connectivity connectivity, NeighbourRow rows[8]);
+};
+
+inline int FloodFill::getNeighbourRows(Connectivity connectivity, NeighbourRow rows[8])
+{
+    // Les files que comparteixen una cara amb la del segment necessiten ampliació en X si es permeten veïns per aresta,
+    // les diagonals només tenen veïns quan es permeten veïns per aresta (sense ampliació) o per vèrtex (amb ampliació)
+    const int faceExpansion = connectivity == SixConnectivity ? 0 : 1;
+    const int diagonalExpansion = connectivity == TwentySixConnectivity ? 1 : 0;
+
+    const NeighbourRow faceRows[4] = { { -1, 0, faceExpansion }, { 1, 0, faceExpansion }, { 0, -1, faceExpansion }, { 0, 1, faceExpansion } };
+    const NeighbourRow diagonalRows[4] = { { -1, -1, diagonalExpansion }, { -1, 1, diagonalExpansion },
+                                           { 1, -1, diagonalExpansion }, { 1, 1, diagonalExpansion } };
+
+    int numberOfRows = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        rows[numberOfRows++] = faceRows[i];
+    }
+
+    if (connectivity != SixConnectivity)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            rows[numberOfRows++] = diagonalRows[i];
+        }
+    }
+
+    return numberOfRows;
+}
+
+template <typename Region>
+int FloodFill::fill(Region &region, const int extent[6], int seedX, int seedY, int seedZ, Connectivity connectivity)
+{
+    if (seedX < extent[0] || seedX > extent[1] || seedY < extent[2] || seedY > extent[3] || seedZ < extent[4] || seedZ > extent[5])
+    {
+        return 0;
+    }
+
+    NeighbourRow neighbourRows[8];
+    const int numberOfNeighbourRows = getNeighbourRows(connectivity, neighbourRows);
+
+    int numberOfFilledVoxels = 0;
+
+    QVector<Seed> seeds;
+    Seed firstSeed = { seedX, seedY, seedZ };
+    seeds.append(firstSeed);
+
+    while (!seeds.isEmpty())
+    {
+        const Seed seed = seeds.last();
+        seeds.removeLast();
+
+        // Una altra llavor pot haver omplert aquest vòxel mentrestant
+        if (!region.isInside(seed.x, seed.y, seed.z))
+        {
+            continue;
+        }
+
+        int left = seed.x;
+        while (left > extent[0] && region.isInside(left - 1, seed.y, seed.z))
+        {
+            --left;
+        }
+
+        int right = seed.x;
+        while (right < extent[1] && region.isInside(right + 1, seed.y, seed.z))
+        {
+            ++right;
+        }
+
+        for (int x = left; x <= right; x++)
+        {
+            region.mark(x, seed.y, seed.z);
+        }
+        numberOfFilledVoxels += right - left + 1;
+
+        for (int i = 0; i < numberOfNeighbourRows; i++)
+        {
+            const NeighbourRow &row = neighbourRows[i];
+            const int y = seed.y + row.dy;
+            const int z = seed.z + row.dz;
+
+            if (y < extent[2] || y > extent[3] || z < extent[4] || z > extent[5])
+            {
+                continue;
+            }
+
+            const int from = qMax(left - row.expansion, extent[0]);
+            const int to = qMin(right + row.expansion, extent[1]);
+
+            // Només afegim una llavor al principi de cada tram de vòxels a omplir
+            bool isInsideRun = false;
+            for (int x = from; x <= to; x++)
+            {
+                if (region.isInside(x, y, z))
+                {
+                    if (!isInsideRun)
+                    {
+                        Seed neighbourSeed = { x, y, z };
+                        seeds.append(neighbourSeed);
+                        isInsideRun = true;
+                    }
+                }
+                else
+                {
+                    isInsideRun = false;
+                }
+            }
+        }
+    }
+
+    return numberOfFilledVoxels;
+}
+
+template <typename T>
+int FloodFill::replaceValue(T *buffer, const int extent[6], int seedX, int seedY, int seedZ, T targetValue, T newValue, Connectivity connectivity)
+{
+    // Si els dos valors són iguals la regió no es buidaria mai
+    if (!buffer || targetValue == newValue)
+    {
+        return 0;
+    }
+
+    ValueRegion<T> region(buffer, extent, targetValue, newValue);
+    return fill(region, extent, seedX, seedY, seedZ, connectivity);
+}
+
+template <typename T>
+FloodFill::ValueRegion<T>::ValueRegion(T *buffer, const int extent[6], T targetValue, T newValue)
+ : m_buffer(buffer), m_targetValue(targetValue), m_newValue(newValue)
+{
+    m_origin[0] = extent[0];
+    m_origin[1] = extent[2];
+    m_origin[2] = extent[4];
+    m_rowSize = extent[1] - extent[0] + 1;
+    m_sliceSize = m_rowSize * (extent[3] - extent[2] + 1);
+}
+
+template <typename T>
+inline T* FloodFill::ValueRegion<T>::getPointer(int x, int y, int z) const
+{
+    return m_buffer + static_cast<qint64>(z - m_origin[2]) * m_sliceSize + static_cast<qint64>(y - m_origin[1]) * m_rowSize + (x - m_origin[0]);
+}
+
+template <typename T>
+inline bool FloodFill::ValueRegion<T>::isInside(int x, int y, int z) const
+{
+    return *getPointer(x, y, z) == m_targetValue;
+}
+
+template <typename T>
+inline void FloodFill::ValueRegion<T>::mark(int x, int y, int z)
+{
+    *getPointer(x, y, z) = m_newValue;
+}
+
+}
+
+#endif
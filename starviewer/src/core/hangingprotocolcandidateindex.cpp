@@ -0,0 +1,133 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+#include "hangingprotocolcandidateindex.h"
+
+#include "hangingprotocol.h"
+#include "hangingprotocolmask.h"
+#include "series.h"
+#include "study.h"
+
+#include <QSet>
+
+#include <algorithm>
+
+namespace udg {
+
+HangingProtocolCandidateIndex::HangingProtocolCandidateIndex()
+{
+}
+
+HangingProtocolCandidateIndex::~HangingProtocolCandidateIndex()
+{
+}
+
+void HangingProtocolCandidateIndex::build(const QList<HangingProtocol*> &hangingProtocols)
+{
+    m_indexedHangingProtocols = hangingProtocols;
+    m_entries.clear();
+    m_entriesByModality.clear();
+
+    m_entries.reserve(hangingProtocols.size());
+
+    foreach (HangingProtocol *hangingProtocol, hangingProtocols)
+    {
+        Entry entry;
+        entry.hangingProtocol = hangingProtocol;
+        entry.numberOfPriors = hangingProtocol->getNumberOfPriors();
+        entry.institutionsRegularExpression = hangingProtocol->getInstitutionsRegularExpression();
+
+        int position = m_entries.size();
+        m_entries.append(entry);
+
+        // Una modalitat repetida a la màscara només s'ha d'indexar un cop
+        foreach (const QString &modality, hangingProtocol->getHangingProtocolMask()->getProtocolList().toSet())
+        {
+            m_entriesByModality[modality].append(position);
+        }
+    }
+}
+
+const QList<HangingProtocol*>& HangingProtocolCandidateIndex::getIndexedHangingProtocols() const
+{
+    return m_indexedHangingProtocols;
+}
+
+QList<HangingProtocol*> HangingProtocolCandidateIndex::getCandidates(Study *study, int numberOfAvailablePriors) const
+{
+    QList<HangingProtocol*> candidates;
+
+    if (!study)
+    {
+        return candidates;
+    }
+
+    // Posicions de les entrades que tenen alguna modalitat de l'estudi, sense repeticions
+    QVector<int> positions;
+    foreach (const QString &modality, study->getModalities())
+    {
+        positions += m_entriesByModality.value(modality);
+    }
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    if (positions.isEmpty())
+    {
+        return candidates;
+    }
+
+    QStringList institutionNames;
+    foreach (Series *series, study->getSeries())
+    {
+        institutionNames << series->getInstitutionName();
+    }
+    institutionNames.removeDuplicates();
+
+    foreach (int position, positions)
+    {
+        const Entry &entry = m_entries.at(position);
+        if (entry.numberOfPriors <= numberOfAvailablePriors && isInstitutionCompatible(entry, institutionNames))
+        {
+            candidates << entry.hangingProtocol;
+        }
+    }
+
+    return candidates;
+}
+
+bool HangingProtocolCandidateIndex::isInstitutionCompatible(const Entry &entry, const QStringList &institutionNames) const
+{
+    if (institutionNames.isEmpty())
+    {
+        // Un estudi sense sèries no és compatible amb cap protocol
+        return false;
+    }
+
+    if (entry.institutionsRegularExpression.isEmpty())
+    {
+        return true;
+    }
+
+    foreach (const QString &institutionName, institutionNames)
+    {
+        if (institutionName.contains(entry.institutionsRegularExpression))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}
@@ -0,0 +1,73 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+#ifndef UDGHANGINGPROTOCOLCANDIDATEINDEX_H
+#define UDGHANGINGPROTOCOLCANDIDATEINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QRegExp>
+#include <QVector>
+
+namespace udg {
+
+class HangingProtocol;
+class Study;
+
+/**
+    Índex dels hanging protocols per modalitat, institució i nombre de previs.
+    Permet descartar els protocols que no es poden aplicar a un estudi sense haver de clonar-los ni omplir-los.
+    L'índex no és propietari dels hanging protocols.
+  */
+class HangingProtocolCandidateIndex {
+public:
+    HangingProtocolCandidateIndex();
+    ~HangingProtocolCandidateIndex();
+
+    /// Reconstrueix l'índex a partir de la llista de protocols donada
+    void build(const QList<HangingProtocol*> &hangingProtocols);
+
+    /// Retorna la llista de protocols a partir de la qual s'ha construït l'índex
+    const QList<HangingProtocol*>& getIndexedHangingProtocols() const;
+
+    /// Retorna els protocols compatibles amb la modalitat i la institució de l'estudi i que no necessiten més previs dels disponibles.
+    /// Es manté l'ordre de la llista original.
+    QList<HangingProtocol*> getCandidates(Study *study, int numberOfAvailablePriors) const;
+
+private:
+    /// Dades de cada protocol que es necessiten per fer el filtratge
+    struct Entry
+    {
+        HangingProtocol *hangingProtocol;
+        int numberOfPriors;
+        QRegExp institutionsRegularExpression;
+    };
+
+    /// Comprova si alguna de les institucions donades és vàlida per l'entrada
+    bool isInstitutionCompatible(const Entry &entry, const QStringList &institutionNames) const;
+
+private:
+    /// Llista de protocols indexats, en l'ordre original
+    QList<HangingProtocol*> m_indexedHangingProtocols;
+
+    /// Entrades en el mateix ordre que m_indexedHangingProtocols
+    QVector<Entry> m_entries;
+
+    /// Posicions de les entrades per cada modalitat
+    QHash<QString, QVector<int> > m_entriesByModality;
+};
+
+}
+
+#endif
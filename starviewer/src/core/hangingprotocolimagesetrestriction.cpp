@@ -33,6 +33,7 @@ HangingProtocolImageSetRestriction::HangingProtocolImageSetRestriction(int ident
                                                                        int selectorValueNumber)
     : m_identifier(identifier), m_selectorAttribute(selectorAttribute), m_selectorValue(selectorValue), m_selectorValueNumber(selectorValueNumber)
 {
+    updateSelectorValueRegularExpressions();
 }
 
 HangingProtocolImageSetRestriction::~HangingProtocolImageSetRestriction()
@@ -67,6 +68,7 @@ const QString& HangingProtocolImageSetRestriction::getSelectorValue() const
 void HangingProtocolImageSetRestriction::setSelectorValue(const QString &selectorValue)
 {
     m_selectorValue = selectorValue;
+    updateSelectorValueRegularExpressions();
 }
 
 int HangingProtocolImageSetRestriction::getSelectorValueNumber() const
@@ -87,7 +89,7 @@ bool HangingProtocolImageSetRestriction::test(const Series *series) const
     }
     else if (getSelectorAttribute() == "ProtocolName")
     {
-        return series->getProtocolName().contains(QRegularExpression(getSelectorValue()));
+        return series->getProtocolName().contains(m_selectorValueRegularExpression);
     }
     else if (getSelectorAttribute() == "ViewPosition")
     {
@@ -95,11 +97,11 @@ bool HangingProtocolImageSetRestriction::test(const Series *series) const
     }
     else if (getSelectorAttribute() == "SeriesDescription")
     {
-        return series->getDescription().contains(QRegularExpression(getSelectorValue(), QRegularExpression::CaseInsensitiveOption));
+        return series->getDescription().contains(m_caseInsensitiveSelectorValueRegularExpression);
     }
     else if (getSelectorAttribute() == "StudyDescription")
     {
-        return series->getParentStudy()->getDescription().contains(QRegularExpression(getSelectorValue(), QRegularExpression::CaseInsensitiveOption));
+        return series->getParentStudy()->getDescription().contains(m_caseInsensitiveSelectorValueRegularExpression);
     }
     else if (getSelectorAttribute() == "PatientName")
     {
@@ -121,7 +123,7 @@ bool HangingProtocolImageSetRestriction::test(const Image *image) const
 {
     if (getSelectorAttribute() == "ViewPosition")
     {
-        return image->getViewPosition().contains(QRegularExpression(getSelectorValue(), QRegularExpression::CaseInsensitiveOption));
+        return image->getViewPosition().contains(m_caseInsensitiveSelectorValueRegularExpression);
     }
     else if (getSelectorAttribute() == "ImageLaterality")
     {
@@ -134,16 +136,16 @@ bool HangingProtocolImageSetRestriction::test(const Image *image) const
     }
     else if (getSelectorAttribute() == "PatientOrientation")
     {
-        return image->getPatientOrientation().getDICOMFormattedPatientOrientation().contains(QRegularExpression(getSelectorValue()));
+        return image->getPatientOrientation().getDICOMFormattedPatientOrientation().contains(m_selectorValueRegularExpression);
     }
     // TODO Es podria canviar el nom, ja que és massa genèric. Seria més adequat ViewCodeMeaning per exemple
     else if (getSelectorAttribute() == "CodeMeaning")
     {
-        return image->getViewCodeMeaning().contains(QRegularExpression(getSelectorValue()));
+        return image->getViewCodeMeaning().contains(m_selectorValueRegularExpression);
     }
     else if (getSelectorAttribute() == "ImageType")
     {
-        return image->getImageType().contains(QRegularExpression(getSelectorValue(), QRegularExpression::CaseInsensitiveOption));
+        return image->getImageType().contains(m_caseInsensitiveSelectorValueRegularExpression);
     }
     else if (getSelectorAttribute() == "MinimumNumberOfImages")
     {
@@ -151,10 +153,18 @@ bool HangingProtocolImageSetRestriction::test(const Image *image) const
     }
     else if (getSelectorAttribute() == "SeriesDescription")
     {
-        return image->getParentSeries()->getDescription().contains(QRegularExpression(getSelectorValue(), QRegularExpression::CaseInsensitiveOption));
+        return image->getParentSeries()->getDescription().contains(m_caseInsensitiveSelectorValueRegularExpression);
     }
 
     return true;
 }
 
+void HangingProtocolImageSetRestriction::updateSelectorValueRegularExpressions()
+{
+    m_selectorValueRegularExpression = QRegularExpression(m_selectorValue);
+    m_selectorValueRegularExpression.optimize();
+    m_caseInsensitiveSelectorValueRegularExpression = QRegularExpression(m_selectorValue, QRegularExpression::CaseInsensitiveOption);
+    m_caseInsensitiveSelectorValueRegularExpression.optimize();
+}
+
 } // namespace udg
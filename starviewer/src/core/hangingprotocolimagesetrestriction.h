@@ -15,6 +15,7 @@
 #ifndef UDG_HANGINGPROTOCOLIMAGESETRESTRICTION_H
 #define UDG_HANGINGPROTOCOLIMAGESETRESTRICTION_H
 
+#include <QRegularExpression>
 #include <QString>
 
 namespace udg {
@@ -51,6 +52,10 @@ public:
     /// Returns true if the given image satisfies this restriction, and false otherwise.
     bool test(const Image *image) const;
 
+private:
+    /// Compiles the selector value as case sensitive and case insensitive regular expressions so that they are not created again on every test.
+    void updateSelectorValueRegularExpressions();
+
 private:
     /// Identifier of this restriction. Must be unique in a hanging protocol.
     int m_identifier;
@@ -64,6 +69,11 @@ private:
     /// This represents the DICOM Selector Value Number (0072,0028).
     int m_selectorValueNumber;
 
+    /// The selector value as a case sensitive regular expression.
+    QRegularExpression m_selectorValueRegularExpression;
+    /// The selector value as a case insensitive regular expression.
+    QRegularExpression m_caseInsensitiveSelectorValueRegularExpression;
+
 };
 
 } // namespace udg
@@ -17,24 +17,23 @@
 #include "hangingprotocolimagesetrestriction.h"
 #include "logging.h"
 
-#include <QJSEngine>
 #include <QRegularExpression>
-#include <QSet>
+#include <QVarLengthArray>
 
 namespace udg {
 
 HangingProtocolImageSetRestrictionExpression::HangingProtocolImageSetRestrictionExpression()
     : m_expression("true")
 {
+    addInstruction(Instruction::PushTrue);
 }
 
 HangingProtocolImageSetRestrictionExpression::HangingProtocolImageSetRestrictionExpression(const QString &expression,
                                                                                            const QMap<int, HangingProtocolImageSetRestriction> &restrictions)
-    : m_expression(expression), m_restrictions(restrictions)
+    : m_expression(expression)
 {
     sanitize();
-    filterUsedRestrictions();
-    prepareForEvaluation();
+    compile(restrictions);
 }
 
 HangingProtocolImageSetRestrictionExpression::~HangingProtocolImageSetRestrictionExpression()
@@ -43,11 +42,11 @@ HangingProtocolImageSetRestrictionExpression::~HangingProtocolImageSetRestrictio
 
 bool HangingProtocolImageSetRestrictionExpression::test(const Series *series) const
 {
-    QList<bool> results;
+    QVector<bool> results(m_restrictions.size());
 
-    foreach (const HangingProtocolImageSetRestriction &restriction, m_restrictions)
+    for (int i = 0; i < m_restrictions.size(); i++)
     {
-        results.append(restriction.test(series));
+        results[i] = m_restrictions.at(i).test(series);
     }
 
     return evaluate(results);
@@ -55,11 +54,11 @@ bool HangingProtocolImageSetRestrictionExpression::test(const Series *series) co
 
 bool HangingProtocolImageSetRestrictionExpression::test(const Image *image) const
 {
-    QList<bool> results;
+    QVector<bool> results(m_restrictions.size());
 
-    foreach (const HangingProtocolImageSetRestriction &restriction, m_restrictions)
+    for (int i = 0; i < m_restrictions.size(); i++)
     {
-        results.append(restriction.test(image));
+        results[i] = m_restrictions.at(i).test(image);
     }
 
     return evaluate(results);
@@ -75,54 +74,233 @@ void HangingProtocolImageSetRestrictionExpression::sanitize()
     }
 }
 
-void HangingProtocolImageSetRestrictionExpression::filterUsedRestrictions()
+void HangingProtocolImageSetRestrictionExpression::compile(const QMap<int, HangingProtocolImageSetRestriction> &restrictions)
 {
-    QRegularExpression regularExpression("\\d+");
-    QRegularExpressionMatchIterator it = regularExpression.globalMatch(m_expression);
-    QSet<int> identifiers;
+    QStringList tokens;
+    QMap<int, int> restrictionIndices;
+    int position = 0;
 
-    while (it.hasNext())
+    if (tokenize(tokens))
     {
-        QRegularExpressionMatch match = it.next();
-        identifiers << match.captured().toInt();
+        // Only the restrictions used in the expression are kept, each one once
+        foreach (const QString &token, tokens)
+        {
+            bool isIdentifier;
+            int identifier = token.toInt(&isIdentifier);
+
+            if (isIdentifier && restrictions.contains(identifier) && !restrictionIndices.contains(identifier))
+            {
+                restrictionIndices.insert(identifier, m_restrictions.size());
+                m_restrictions.append(restrictions.value(identifier));
+            }
+        }
+
+        if (compileOr(tokens, position, restrictionIndices) && position == tokens.size())
+        {
+            return;
+        }
     }
 
-    foreach (int i, m_restrictions.keys())
+    DEBUG_LOG(QString("Error while compiling expression \"%1\", it will always evaluate to true").arg(m_expression));
+    ERROR_LOG(QString("Error while compiling expression \"%1\", it will always evaluate to true").arg(m_expression));
+    m_restrictions.clear();
+    m_program.clear();
+    addInstruction(Instruction::PushTrue);
+}
+
+bool HangingProtocolImageSetRestrictionExpression::tokenize(QStringList &tokens) const
+{
+    static const QStringList Keywords = QStringList() << "and" << "or" << "not" << "true" << "(" << ")";
+    int position = 0;
+
+    while (position < m_expression.size())
     {
-        if (!identifiers.contains(i))
+        if (m_expression.at(position).isDigit())
         {
-            m_restrictions.remove(i);
+            int start = position;
+
+            while (position < m_expression.size() && m_expression.at(position).isDigit())
+            {
+                position++;
+            }
+
+            tokens << m_expression.mid(start, position - start);
+        }
+        else
+        {
+            bool found = false;
+
+            foreach (const QString &keyword, Keywords)
+            {
+                if (m_expression.midRef(position, keyword.size()) == keyword)
+                {
+                    tokens << keyword;
+                    position += keyword.size();
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+            {
+                return false;
+            }
         }
     }
+
+    return true;
 }
 
-void HangingProtocolImageSetRestrictionExpression::prepareForEvaluation()
+bool HangingProtocolImageSetRestrictionExpression::compileOr(const QStringList &tokens, int &position, const QMap<int, int> &restrictionIndices)
 {
-    m_expression.replace("and", "&").replace("or", "|").replace("not", "!").replace(QRegularExpression("(\\d+)"), "%\\1");
+    if (!compileAnd(tokens, position, restrictionIndices))
+    {
+        return false;
+    }
+
+    while (position < tokens.size() && tokens.at(position) == "or")
+    {
+        position++;
+
+        if (!compileAnd(tokens, position, restrictionIndices))
+        {
+            return false;
+        }
+
+        addInstruction(Instruction::Or);
+    }
+
+    return true;
 }
 
-bool HangingProtocolImageSetRestrictionExpression::evaluate(const QList<bool> &results) const
+bool HangingProtocolImageSetRestrictionExpression::compileAnd(const QStringList &tokens, int &position, const QMap<int, int> &restrictionIndices)
 {
-    QString expression = m_expression;
+    if (!compileNot(tokens, position, restrictionIndices))
+    {
+        return false;
+    }
 
-    foreach (bool result, results)
+    while (position < tokens.size() && tokens.at(position) == "and")
     {
-        expression = expression.arg(result);
+        position++;
+
+        if (!compileNot(tokens, position, restrictionIndices))
+        {
+            return false;
+        }
+
+        addInstruction(Instruction::And);
     }
 
-    QJSEngine scriptEngine;
-    QJSValue result = scriptEngine.evaluate(expression);
+    return true;
+}
 
-    if (!result.isError())
+bool HangingProtocolImageSetRestrictionExpression::compileNot(const QStringList &tokens, int &position, const QMap<int, int> &restrictionIndices)
+{
+    if (position < tokens.size() && tokens.at(position) == "not")
     {
-        return result.toBool();
+        position++;
+
+        if (!compileNot(tokens, position, restrictionIndices))
+        {
+            return false;
+        }
+
+        addInstruction(Instruction::Not);
+        return true;
+    }
+
+    return compilePrimary(tokens, position, restrictionIndices);
+}
+
+bool HangingProtocolImageSetRestrictionExpression::compilePrimary(const QStringList &tokens, int &position, const QMap<int, int> &restrictionIndices)
+{
+    if (position >= tokens.size())
+    {
+        return false;
+    }
+
+    const QString &token = tokens.at(position);
+    position++;
+
+    if (token == "true")
+    {
+        addInstruction(Instruction::PushTrue);
+        return true;
+    }
+    else if (token == "(")
+    {
+        if (!compileOr(tokens, position, restrictionIndices) || position >= tokens.size() || tokens.at(position) != ")")
+        {
+            return false;
+        }
+
+        position++;
+        return true;
     }
     else
     {
-        DEBUG_LOG(QString("Error while evaluating expression \"%1\": %2").arg(expression).arg(result.toString()));
-        ERROR_LOG(QString("Error while evaluating expression \"%1\": %2").arg(expression).arg(result.toString()));
+        bool isIdentifier;
+        int identifier = token.toInt(&isIdentifier);
+
+        if (!isIdentifier || !restrictionIndices.contains(identifier))
+        {
+            return false;
+        }
+
+        addInstruction(Instruction::PushRestriction, restrictionIndices.value(identifier));
         return true;
     }
 }
 
+void HangingProtocolImageSetRestrictionExpression::addInstruction(Instruction::Type type, int restrictionIndex)
+{
+    Instruction instruction;
+    instruction.type = type;
+    instruction.restrictionIndex = restrictionIndex;
+    m_program.append(instruction);
+}
+
+bool HangingProtocolImageSetRestrictionExpression::evaluate(const QVector<bool> &results) const
+{
+    // The program has been validated when compiled, so the stack never underflows and ends with a single value
+    QVarLengthArray<bool, 16> stack;
+
+    foreach (const Instruction &instruction, m_program)
+    {
+        switch (instruction.type)
+        {
+            case Instruction::PushRestriction:
+                stack.append(results.at(instruction.restrictionIndex));
+                break;
+
+            case Instruction::PushTrue:
+                stack.append(true);
+                break;
+
+            case Instruction::Not:
+                stack.last() = !stack.last();
+                break;
+
+            case Instruction::And:
+            {
+                bool operand = stack.last();
+                stack.removeLast();
+                stack.last() = stack.last() && operand;
+                break;
+            }
+
+            case Instruction::Or:
+            {
+                bool operand = stack.last();
+                stack.removeLast();
+                stack.last() = stack.last() || operand;
+                break;
+            }
+        }
+    }
+
+    return stack.last();
+}
+
 } // namespace udg
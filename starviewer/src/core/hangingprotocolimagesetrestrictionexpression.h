@@ -19,6 +19,8 @@
 
 #include <QMap>
 #include <QString>
+#include <QStringList>
+#include <QVector>
 
 namespace udg {
 
@@ -28,6 +30,9 @@ class Series;
 /**
  * @brief The HangingProtocolImageSetRestrictionExpression class represents a boolean expression involving several restrictions of type
  * HangingProtocolImageSetRestriction. The expression is evaluated by evaluating all the restrictions and combining their results according to the expression.
+ *
+ * The expression is compiled once when it is created into a postfix program, so evaluating it only needs a small stack of booleans. Malformed expressions
+ * always evaluate to true.
  */
 class HangingProtocolImageSetRestrictionExpression
 {
@@ -43,20 +48,40 @@ public:
     bool test(const Image *image) const;
 
 private:
+    /// Instruction of the compiled expression. The program is stored in postfix order.
+    struct Instruction
+    {
+        enum Type { PushRestriction, PushTrue, Not, And, Or };
+
+        Type type;
+        /// Index in m_restrictions of the restriction whose result is pushed. Only used by PushRestriction.
+        int restrictionIndex;
+    };
+
     /// Removes unwanted characters from the expression.
     void sanitize();
-    /// Removes unused restrictions from the list.
-    void filterUsedRestrictions();
-    /// Transforms the expression to prepare it for evaluation.
-    void prepareForEvaluation();
-    /// Evaluates the expression with the given results for each restriction.
-    bool evaluate(const QList<bool> &results) const;
+    /// Compiles the expression into m_program using only the given restrictions. If the expression is malformed the program always returns true.
+    void compile(const QMap<int, HangingProtocolImageSetRestriction> &restrictions);
+    /// Splits the expression into tokens. Returns false if there is an unknown token.
+    bool tokenize(QStringList &tokens) const;
+    /// Recursive descent parsing functions. Each one compiles a level of the grammar, starting at the given token position and advancing it.
+    /// They return false if the tokens don't follow the grammar or reference an unknown restriction.
+    bool compileOr(const QStringList &tokens, int &position, const QMap<int, int> &restrictionIndices);
+    bool compileAnd(const QStringList &tokens, int &position, const QMap<int, int> &restrictionIndices);
+    bool compileNot(const QStringList &tokens, int &position, const QMap<int, int> &restrictionIndices);
+    bool compilePrimary(const QStringList &tokens, int &position, const QMap<int, int> &restrictionIndices);
+    /// Appends an instruction to the program.
+    void addInstruction(Instruction::Type type, int restrictionIndex = -1);
+    /// Evaluates the compiled program with the given results for each restriction.
+    bool evaluate(const QVector<bool> &results) const;
 
 private:
     /// Boolean expression that is evaluated.
     QString m_expression;
     /// Restrictions used in the expression.
-    QMap<int, HangingProtocolImageSetRestriction> m_restrictions;
+    QVector<HangingProtocolImageSetRestriction> m_restrictions;
+    /// Compiled expression.
+    QVector<Instruction> m_program;
 
 };
 
@@ -21,6 +21,7 @@
 #include "volume.h"
 #include "q2dviewerwidget.h"
 #include "hangingprotocolsrepository.h"
+#include "hangingprotocolsloader.h"
 #include "hangingprotocol.h"
 #include "hangingprotocollayout.h"
 #include "hangingprotocolmask.h"
@@ -31,11 +32,65 @@
 #include "volumerepository.h"
 #include "applyhangingprotocolqviewercommand.h"
 #include "hangingprotocolfiller.h"
+
+#include <QtConcurrent>
+
 // Necessari per poder anar a buscar prèvies
 #include "../inputoutput/relatedstudiesmanager.h"
 
 namespace udg {
 
+namespace {
+
+/// Omple el hanging protocol amb les sèries de l'estudi i dels previs i retorna cert si el resultat és vàlid
+bool fillAndValidateHangingProtocol(HangingProtocol *hangingProtocol, Study *study, const QList<Study*> &previousStudies)
+{
+    HangingProtocolFiller hangingProtocolFiller;
+    hangingProtocolFiller.fill(hangingProtocol, study, previousStudies);
+
+    int numberOfFilledImageSets = hangingProtocol->countFilledImageSets();
+
+    if (hangingProtocol->isStrict())
+    {
+        return numberOfFilledImageSets == hangingProtocol->getNumberOfImageSets();
+    }
+
+    if (numberOfFilledImageSets == 0)
+    {
+        return false;
+    }
+
+    if (hangingProtocol->getNumberOfPriors() > 0)
+    {
+        int filledImageSetsWithPriors = hangingProtocol->countFilledImageSetsWithPriors();
+        return filledImageSetsWithPriors != 0 && numberOfFilledImageSets != filledImageSetsWithPriors;
+    }
+
+    return true;
+}
+
+/// Functor per omplir els candidats en paral·lel amb QtConcurrent
+class HangingProtocolCandidateFiller {
+public:
+    typedef bool result_type;
+
+    HangingProtocolCandidateFiller(Study *study, const QList<Study*> &previousStudies)
+        : m_study(study), m_previousStudies(previousStudies)
+    {
+    }
+
+    bool operator()(HangingProtocol *hangingProtocol) const
+    {
+        return fillAndValidateHangingProtocol(hangingProtocol, m_study, m_previousStudies);
+    }
+
+private:
+    Study *m_study;
+    QList<Study*> m_previousStudies;
+};
+
+}
+
 HangingProtocolManager::HangingProtocolManager(QObject *parent)
  : QObject(parent)
 {
@@ -62,6 +117,9 @@ HangingProtocolManager::~HangingProtocolManager()
 
 void HangingProtocolManager::copyHangingProtocolRepository()
 {
+    // Els hanging protocols no es carreguen a l'arrencada sinó el primer cop que es necessiten
+    HangingProtocolsLoader::loadDefaultsOnce();
+
     foreach (HangingProtocol *hangingProtocol, HangingProtocolsRepository::getRepository()->getItems())
     {
         m_availableHangingProtocols << new HangingProtocol(*hangingProtocol);
@@ -79,54 +137,32 @@ QList<HangingProtocol*> HangingProtocolManager::searchHangingProtocols(Study *st
 {
     QList<HangingProtocol*> outputHangingProtocolList;
 
-    // Buscar el hangingProtocol que s'ajusta millor a l'estudi del pacient
-    // Aprofitem per assignar ja les series, per millorar el rendiment
-    foreach (HangingProtocol *hangingProtocolBase, m_availableHangingProtocols)
+    // Només es clonen i s'omplen els hanging protocols que passen el filtre de modalitat, institució i nombre de previs
+    if (m_candidateIndex.getIndexedHangingProtocols() != m_availableHangingProtocols)
     {
-        HangingProtocol *hangingProtocol = new HangingProtocol(*hangingProtocolBase);
-        if (isModalityCompatible(hangingProtocol, study) && isInstitutionCompatible(hangingProtocol, study) && hangingProtocol->getNumberOfPriors() <= previousStudies.size())
-        {
-            HangingProtocolFiller hangingProtocolFiller;
-            hangingProtocolFiller.fill(hangingProtocol, study, previousStudies);
+        m_candidateIndex.build(m_availableHangingProtocols);
+    }
 
-            int numberOfFilledImageSets = hangingProtocol->countFilledImageSets();
+    QList<HangingProtocol*> candidateHangingProtocols;
+    foreach (HangingProtocol *hangingProtocolBase, m_candidateIndex.getCandidates(study, previousStudies.size()))
+    {
+        candidateHangingProtocols << new HangingProtocol(*hangingProtocolBase);
+    }
 
-            bool isValidHangingProtocol = false;
+    // Cada candidat és una còpia independent, per tant es poden omplir en paral·lel
+    // Es bloqueja fins que s'acaba perquè qui crida espera el resultat, per tant des de la GUI no es surt del thread principal
+    QList<bool> validHangingProtocols = QtConcurrent::blockingMapped<QList<bool> >(candidateHangingProtocols,
+                                                                                    HangingProtocolCandidateFiller(study, previousStudies));
 
-            if (hangingProtocol->isStrict())
-            {
-                if (numberOfFilledImageSets == hangingProtocol->getNumberOfImageSets())
-                {
-                    isValidHangingProtocol = true;
-                }
-            }
-            else
-            {
-                if (numberOfFilledImageSets > 0)
-                {
-                    if (hangingProtocol->getNumberOfPriors() > 0)
-                    {
-                        int filledImageSetsWithPriors = hangingProtocol->countFilledImageSetsWithPriors();
-                        if (filledImageSetsWithPriors == 0 || numberOfFilledImageSets == filledImageSetsWithPriors)
-                        {
-                            isValidHangingProtocol = false;
-                        }
-                        else
-                        {
-                            isValidHangingProtocol = true;
-                        }
-                    }
-                    else
-                    {
-                        isValidHangingProtocol = true;
-                    }
-                }
-            }
-
-            if (isValidHangingProtocol)
-            {
-                outputHangingProtocolList << hangingProtocol;
-            }
+    for (int i = 0; i < candidateHangingProtocols.size(); i++)
+    {
+        if (validHangingProtocols.at(i))
+        {
+            outputHangingProtocolList << candidateHangingProtocols.at(i);
+        }
+        else
+        {
+            delete candidateHangingProtocols.at(i);
         }
     }
 
@@ -234,47 +270,6 @@ void HangingProtocolManager::applyHangingProtocol(HangingProtocol *hangingProtoc
     INFO_LOG(QString("Hanging protocol aplicat: %1").arg(hangingProtocol->getName()));
 }
 
-bool HangingProtocolManager::isModalityCompatible(HangingProtocol *protocol, Study *study)
-{
-    foreach (const QString &modality, study->getModalities())
-    {
-        if (isModalityCompatible(protocol, modality))
-        {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-bool HangingProtocolManager::isModalityCompatible(HangingProtocol *protocol, const QString &modality)
-{
-    return protocol->getHangingProtocolMask()->getProtocolList().contains(modality);
-}
-
-bool HangingProtocolManager::isInstitutionCompatible(HangingProtocol *protocol, Study *study)
-{
-    foreach(Series *series, study->getSeries())
-    {
-        if (isValidInstitution(protocol, series->getInstitutionName()))
-        {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-bool HangingProtocolManager::isValidInstitution(HangingProtocol *protocol, const QString &institutionName)
-{
-    if (protocol->getInstitutionsRegularExpression().isEmpty())
-    {
-        return true;
-    }
-
-    return institutionName.contains(protocol->getInstitutionsRegularExpression());
-}
-
 void HangingProtocolManager::previousStudyDownloaded(Study *study)
 {
     foreach (HangingProtocol *hangingProtocol, m_hangingProtocolsDownloading->keys())
@@ -15,6 +15,8 @@
 #ifndef UDGHANGINGPROTOCOLMANAGER_H
 #define UDGHANGINGPROTOCOLMANAGER_H
 
+#include "hangingprotocolcandidateindex.h"
+
 #include <QObject>
 #include <QList>
 #include <QMultiHash>
@@ -46,6 +48,7 @@ public:
     ~HangingProtocolManager();
 
     /// Buscar els hanging protocols disponibles
+    /// Els candidats s'omplen en paral·lel, però la crida és síncrona: el thread que la fa queda bloquejat fins que s'han omplert tots.
     QList<HangingProtocol*> searchHangingProtocols(Study *study);
     QList<HangingProtocol*> searchHangingProtocols(Study *study, const QList<Study*> &previousStudies);
 
@@ -69,6 +72,9 @@ protected:
     /// Còpia del repositori de HP però poder-los modificar sense que afecti al repositori
     QList<HangingProtocol*> m_availableHangingProtocols;
 
+    /// Índex de m_availableHangingProtocols per descartar ràpidament els protocols no aplicables
+    HangingProtocolCandidateIndex m_candidateIndex;
+
 private slots:
     /// S'ha descarregat un estudi previ demanat
     void previousStudyDownloaded(Study *study);
@@ -77,18 +83,6 @@ private slots:
     void errorDownloadingPreviousStudies(const QString &studyUID);
 
 private:
-    /// Mira si el protocol es pot aplicar al pacient
-    bool isModalityCompatible(HangingProtocol *protocol, Study *study);
-
-    /// Mira si la modalitat és compatible amb el protocol
-    bool isModalityCompatible(HangingProtocol *protocol, const QString &modality);
-
-    /// Mira si la institució és compatible amb el protocol
-    bool isInstitutionCompatible(HangingProtocol *protocol, Study *study);
-
-    /// Comprova si el protocol és aplicable a la institució. Si el protocol no té expressió regular per institució és aplicable
-    bool isValidInstitution(HangingProtocol *protocol, const QString &institutionName);
-
     /// Mètode encarregat d'assignar l'input al viewer a partir de les especificacions del displaySet+imageSet.
     void setInputToViewer(Q2DViewerWidget *viewerWidget, HangingProtocolDisplaySet *displaySet);
 
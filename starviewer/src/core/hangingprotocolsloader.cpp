@@ -43,6 +43,20 @@ HangingProtocolsLoader::~HangingProtocolsLoader()
 
 }
 
+void HangingProtocolsLoader::loadDefaultsOnce()
+{
+// Amb starviewer lite no hi haurà hanging protocols, per tant no els carregarem
+#ifndef STARVIEWER_LITE
+    static bool defaultsLoaded = false;
+    if (!defaultsLoaded)
+    {
+        defaultsLoaded = true;
+        HangingProtocolsLoader loader;
+        loader.loadDefaults();
+    }
+#endif
+}
+
 void HangingProtocolsLoader::loadDefaults()
 {
     /// Hanging protocols definits per defecte, agafa el directori de l'executable TODO això podria ser un setting més
@@ -32,6 +32,10 @@ public:
     /// Càrrega de hanging protocols per defecte
     void loadDefaults();
 
+    /// Carrega els hanging protocols per defecte el primer cop que es crida durant la sessió. Els següents cops no fa res.
+    /// Permet no llegir-los fins que es necessiten en lloc de fer-ho a l'arrencada.
+    static void loadDefaultsOnce();
+
     /// Càrrega des d'un directori de hanging protocols o un fitxer XML
     void loadXMLFiles(const QString &path);
 
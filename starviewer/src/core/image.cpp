@@ -17,9 +17,12 @@
 #include "series.h"
 #include "logging.h"
 #include "thumbnailcreator.h"
+#include "asynchronousthumbnailcreator.h"
+#include "singleton.h"
 #include "mathtools.h"
 #include "imageoverlayreader.h"
 #include "preferredpixelspacingselector.h"
+#include "stringinterner.h"
 
 #include <QFileInfo>
 
@@ -331,12 +334,12 @@ const QString& Image::getAcquisitionNumber() const
 
 void Image::setAcquisitionNumber(QString acquisitionNumber)
 {
-    m_acquisitionNumber = std::move(acquisitionNumber);
+    m_acquisitionNumber = StringInterner::intern(acquisitionNumber);
 }
 
 void Image::setImageType(const QString &imageType)
 {
-    m_imageType = imageType;
+    m_imageType = StringInterner::intern(imageType);
 }
 
 QString Image::getImageType() const
@@ -346,7 +349,7 @@ QString Image::getImageType() const
 
 void Image::setViewPosition(const QString &viewPosition)
 {
-    m_viewPosition = viewPosition;
+    m_viewPosition = StringInterner::intern(viewPosition);
 }
 
 QString Image::getViewPosition() const
@@ -366,7 +369,7 @@ QChar Image::getImageLaterality() const
 
 void Image::setViewCodeMeaning(const QString &viewCodeMeaning)
 {
-    m_viewCodeMeaning = viewCodeMeaning;
+    m_viewCodeMeaning = StringInterner::intern(viewCodeMeaning);
 }
 
 QString Image::getViewCodeMeaning() const
@@ -449,7 +452,7 @@ QString Image::getFormattedImageTime() const
 
 void Image::setTransferSyntaxUID(const QString &transferSyntaxUID)
 {
-    m_transferSyntaxUID = transferSyntaxUID;
+    m_transferSyntaxUID = StringInterner::intern(transferSyntaxUID);
 }
 
 const QString& Image::getTransferSyntaxUID() const
@@ -592,7 +595,8 @@ vtkImageData* Image::getDisplayShutterForDisplayAsVtkImageData()
         DisplayShutter shutter = this->getDisplayShutterForDisplay();
         if (shutter.getShape() != DisplayShutter::UndefinedShape)
         {
-            m_displayShutterForDisplayVtkImageData = shutter.getAsVtkImageData(m_columns, m_rows);
+            // La màscara es comparteix amb totes les imatges amb el mateix shutter i les mateixes mides
+            m_displayShutterForDisplayVtkImageData = shutter.getAsSharedVtkImageData(m_columns, m_rows);
             if (m_displayShutterForDisplayVtkImageData)
             {
                 m_displayShutterForDisplayVtkImageData->SetOrigin(m_imagePositionPatient);
@@ -640,6 +644,11 @@ QString Image::getPath() const
 }
 
 QPixmap Image::getThumbnail(bool getFromCache, int resolution)
+{
+    return QPixmap::fromImage(getThumbnailImage(getFromCache, resolution));
+}
+
+QImage Image::getThumbnailImage(bool getFromCache, int resolution)
 {
     ThumbnailCreator thumbnailCreator;
     bool createThumbnail = true;
@@ -655,20 +664,23 @@ QPixmap Image::getThumbnail(bool getFromCache, int resolution)
             QString thumbnailPath = QFileInfo(getPath()).absolutePath();
             // Path absolut de l'arxiu de thumbnail
             QString thumbnailFilePath = QString("%1/thumbnail%2.png").arg(thumbnailPath).arg(getVolumeNumberInSeries());
+            // Es consulta abans de mirar si existeix el fitxer perquè no s'acabi d'escriure entre les dues comprovacions
+            bool isThumbnailPending = SingletonPointer<AsynchronousThumbnailCreator>::instance()->isPending(thumbnailFilePath);
 
             QFileInfo thumbnailFile(thumbnailFilePath);
             if (thumbnailFile.exists())
             {
-                m_thumbnail = QPixmap(thumbnailFilePath);
+                m_thumbnail = QImage(thumbnailFilePath);
                 createThumbnail = false;
             }
-            else
+            // Mentre el thumbnail d'aquest volum s'està creant en segon pla no podem agafar el genèric, que és el del primer volum
+            else if (!isThumbnailPending)
             {
                 thumbnailFilePath = QString("%1/thumbnail.png").arg(thumbnailPath);
                 thumbnailFile.setFile(thumbnailFilePath);
                 if (thumbnailFile.exists())
                 {
-                    m_thumbnail = QPixmap(thumbnailFilePath);
+                    m_thumbnail = QImage(thumbnailFilePath);
                     createThumbnail = false;
                 }
             }
@@ -676,7 +688,7 @@ QPixmap Image::getThumbnail(bool getFromCache, int resolution)
 
         if (createThumbnail)
         {
-            m_thumbnail = QPixmap::fromImage(thumbnailCreator.getThumbnail(this, resolution));
+            m_thumbnail = thumbnailCreator.getThumbnail(this, resolution);
         }
     }
     return m_thumbnail;
@@ -20,6 +20,7 @@
 #include <QList>
 #include <QPair>
 #include <QStringList>
+#include <QImage>
 #include <QPixmap>
 
 #include "dicomsource.h"
@@ -256,6 +257,11 @@ public:
     /// @return Un QPixmap amb el thumbnail
     QPixmap getThumbnail(bool getFromCache = false, int resolution = 100);
 
+    /// Igual que getThumbnail() però retorna un QImage, de manera que es pot cridar des de fora del thread de la GUI
+    /// No és thread-safe: guarda el thumbnail a la imatge sense cap bloqueig, per tant no s'ha de cridar per una mateixa imatge des de diferents threads alhora
+    /// per tenir el thumbnail preparat abans que es demani des de la interfície.
+    QImage getThumbnailImage(bool getFromCache = false, int resolution = 100);
+
     /// Ens retorna una llista amb les modalitats que suportem com a Image
     static QStringList getSupportedModalities();
 
@@ -441,7 +447,7 @@ private:
     Series *m_parentSeries;
 
     /// Cache de la imatge de previsualització
-    QPixmap m_thumbnail;
+    QImage m_thumbnail;
 
     //Indica quin és l'origen de les imatges DICOM
     DICOMSource m_imageDICOMSource;
@@ -23,6 +23,7 @@
 #include "sliceorientedvolumepixeldata.h"
 #include "voxel.h"
 #include "voxelindex.h"
+#include "floodfill.h"
 
 #include <QApplication> // to check pressed mouse buttons
 #include <qmath.h>
@@ -33,6 +34,43 @@
 
 namespace udg {
 
+namespace {
+
+/// Regió de píxels connectats amb valor dins el rang de llindars que encara no s'han afegit a la màscara
+class MagicROIRegion {
+public:
+    MagicROIRegion(SliceOrientedVolumePixelData &pixelData, QVector<bool> &mask, int maskRowSize, double lowerLevel, double upperLevel)
+        : m_pixelData(pixelData), m_mask(mask), m_maskRowSize(maskRowSize), m_lowerLevel(lowerLevel), m_upperLevel(upperLevel)
+    {
+    }
+
+    bool isInside(int x, int y, int z) const
+    {
+        if (m_mask.at(y * m_maskRowSize + x))
+        {
+            return false;
+        }
+
+        double value = m_pixelData.getVoxelValue(VoxelIndex(x, y, z)).getComponent(0);
+        return (value >= m_lowerLevel) && (value <= m_upperLevel);
+    }
+
+    void mark(int x, int y, int z)
+    {
+        Q_UNUSED(z);
+        m_mask[y * m_maskRowSize + x] = true;
+    }
+
+private:
+    SliceOrientedVolumePixelData &m_pixelData;
+    QVector<bool> &m_mask;
+    int m_maskRowSize;
+    double m_lowerLevel;
+    double m_upperLevel;
+};
+
+}
+
 const int MagicROITool::MagicSize = 3;
 const double MagicROITool::InitialMagicFactor = 0.0;
 
@@ -72,13 +110,13 @@ void MagicROITool::deleteTemporalRepresentation()
     {
         m_roiPolygon->decreaseReferenceCount();
         delete m_roiPolygon;
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
     if (!m_filledRoiPolygon.isNull())
     {
         m_filledRoiPolygon->decreaseReferenceCount();
         delete m_filledRoiPolygon;
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 
     m_state = Ready;
@@ -91,13 +129,13 @@ void MagicROITool::initialize()
     {
         m_roiPolygon->decreaseReferenceCount();
         delete m_roiPolygon;
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
     if (!m_filledRoiPolygon.isNull())
     {
         m_filledRoiPolygon->decreaseReferenceCount();
         delete m_filledRoiPolygon;
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 
     m_roiPolygon = NULL;
@@ -296,7 +334,7 @@ void MagicROITool::generateRegion()
     // Trobem els punts frontera i creem el polígon
     this->computePolygon();
 
-    m_2DViewer->render();
+    m_2DViewer->requestRender();
 }
 
 int MagicROITool::getROIInputIndex() const
@@ -361,121 +399,23 @@ void MagicROITool::computeRegionMask()
         DEBUG_LOG("ERROR: extension no comença a 0");
     }
     
+    SliceOrientedVolumePixelData pixelData = getPixelData();
     VoxelIndex index = getPickedPositionVoxelIndex();   // slice oriented index
-    double value = this->getVoxelValue(index);
-    int x = index.x(), y = index.y(), z = index.z();
+    double value = pixelData.getVoxelValue(index).getComponent(0);
 
-    if ((value >= m_lowerLevel) && (value <= m_upperLevel))
-    {
-        int maskIndex = getMaskVectorIndex(x, y);
-        m_mask[maskIndex] = true;
-    }
-    else
+    if ((value < m_lowerLevel) || (value > m_upperLevel))
     {
         DEBUG_LOG("Ha petat i sortim");
         return;
     }
 
-    // Comencem el Region Growing
-    QVector<int> movements;
-    // First movement \TODO Codi duplicat amb main loop
-    int i = 0;
-    bool found = false;
-    int maskIndex = 0;
-    while (i < 4 && !found)
+    // Region growing 4-connectat dins la llesca, deixant fora el marc d'1 píxel que no es fa servir per generar el polígon
+    int extent[6] = { m_minX + 1, m_maxX - 1, m_minY + 1, m_maxY - 1, index.z(), index.z() };
+    MagicROIRegion region(pixelData, m_mask, m_maxX + 1, m_lowerLevel, m_upperLevel);
+    if (FloodFill::fill(region, extent, index.x(), index.y(), index.z()) == 0)
     {
-        this->doMovement(x, y, i);
-        value = this->getVoxelValue(VoxelIndex(x, y, z));
-
-        if ((value >= m_lowerLevel) && (value <= m_upperLevel))
-        {
-            maskIndex = getMaskVectorIndex(x, y);
-            m_mask[maskIndex] = true;
-            found = true;
-            movements.push_back(i);
-        }
-        if (!found)
-        {
-            this->undoMovement(x, y, i);
-        }
-        ++i;
-    }
-
-    // Main loop
-    i = 0;
-    while (movements.size() > 0)
-    {
-        found = false;
-        while (i < 4 && !found)
-        {
-            this->doMovement(x, y, i);
-            if ((x > m_minX) && (x < m_maxX) && (y > m_minY) && (y < m_maxY))
-            {
-                value = this->getVoxelValue(VoxelIndex(x, y, z));
-                maskIndex = getMaskVectorIndex(x, y);
-                if ((value >= m_lowerLevel) && (value <= m_upperLevel) && (!m_mask[maskIndex]))
-                {
-                    m_mask[maskIndex] = true;
-                    found = true;
-                    movements.push_back(i);
-                    i = 0;
-                }
-            }
-            if (!found)
-            {
-                this->undoMovement(x, y, i);
-                ++i;
-            }
-        }
-        if (!found)
-        {
-            this->undoMovement(x, y, movements.back());
-            i = movements.back();
-            ++i;
-            movements.pop_back();
-        }
-    }
-}
-
-void MagicROITool::doMovement(int &x, int &y, int movement)
-{
-    switch (movement)
-    {
-        case MoveRight:
-            x++;
-            break;
-        case MoveLeft:
-            x--;
-            break;
-        case MoveUp:
-            y++;
-            break;
-        case MoveDown:
-            y--;
-            break;
-        default:
-            DEBUG_LOG("Invalid movement");
-    }
-}
-
-void MagicROITool::undoMovement(int &x, int &y, int movement)
-{
-    switch (movement)
-    {
-        case MoveRight:
-            x--;
-            break;
-        case MoveLeft:
-            x++;
-            break;
-        case MoveUp:
-            y--;
-            break;
-        case MoveDown:
-            y++;
-            break;
-        default:
-            DEBUG_LOG("Invalid movement");
+        // La llavor és al marc, només la marquem a ella
+        m_mask[getMaskVectorIndex(index.x(), index.y())] = true;
     }
 }
 
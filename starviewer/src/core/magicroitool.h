@@ -37,8 +37,6 @@ public:
     
     // Creixement
     enum { LeftDown, Down, RightDown, Right, RightUp, Up, LeftUp, Left };
-    // Moviments
-    enum { MoveRight, MoveLeft, MoveUp, MoveDown };
 
     MagicROITool(QViewer *viewer, QObject *parent = 0);
     ~MagicROITool();
@@ -64,19 +62,9 @@ private:
     /// Calcula el rang de valors d'intensitat vàlid a partir de \sa #m_magicSize i \see #m_magicFactor
     void computeLevelRange();
 
-    /// Versió iterativa del region Growing
+    /// Calcula la màscara de la regió amb un region growing iteratiu a partir del punt escollit
     void computeRegionMask();
 
-    /// Fer un moviment des d'un índex cap a una direcció
-    /// @param a, @param b índex del volum de la màscara que estem mirant en cada crida
-    /// @param movement direcció en el moviment
-    void doMovement(int &a, int &b, int movement);
-
-    /// Desfer un moviment dses d'un índex cap a una direcció
-    /// @param a, @param b índex del volum de la màscara que estem mirant en cada crida
-    /// @param movement direcció en el moviment
-    void undoMovement(int &a, int &b, int movement);
-
     /// Genera el polígon a partir de la màscara
     void computePolygon();
 
@@ -95,7 +95,7 @@ void MagnifyingGlassTool::removeMagnifiedRenderer()
         m_2DViewer->unsetCursor();
         m_magnifiedRenderer->RemoveAllViewProps();
         m_2DViewer->getRenderWindow()->RemoveRenderer(m_magnifiedRenderer);
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
         m_magnifyingRendererIsVisible = false;
     }
 }
@@ -162,7 +162,7 @@ void MagnifyingGlassTool::updateMagnifiedView()
     // Actualitzem la posició que enfoca la càmera
     setFocalPoint(xyz);
     m_magnifiedRenderer->ResetCameraClippingRange();
-    m_2DViewer->render();
+    m_2DViewer->requestRender();
 }
 
 void MagnifyingGlassTool::setFocalPoint(const double cursorPosition[3])
@@ -0,0 +1,166 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#include "memorymappeddataarray.h"
+
+#include "logging.h"
+
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTemporaryFile>
+
+#include <vtkDataArray.h>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <errno.h>
+#endif
+
+namespace udg {
+
+namespace {
+
+// Fitxers mapejats indexats per l'adreça de les seves dades, per poder-los desmapejar quan VTK alliberi l'array
+QHash<void*, QFile*> mappedFiles;
+QMutex mappedFilesMutex;
+
+// Funció d'alliberament que VTK crida quan es destrueix l'array que fa servir la memòria mapejada
+void unmapFile(void *data)
+{
+    QFile *file;
+    {
+        QMutexLocker locker(&mappedFilesMutex);
+        file = mappedFiles.take(data);
+    }
+
+    if (file)
+    {
+        file->unmap(static_cast<uchar*>(data));
+        delete file;
+    }
+}
+
+// Omple el fitxer amb zeros fins a la mida donada perquè tot l'espai quedi reservat a disc
+bool fillWithZeros(QFile *file, qint64 size)
+{
+    const qint64 ChunkSize = 1024 * 1024;
+    QByteArray zeros(ChunkSize, 0);
+
+    if (!file->seek(0))
+    {
+        return false;
+    }
+
+    for (qint64 written = 0; written < size; written += ChunkSize)
+    {
+        qint64 chunk = qMin(ChunkSize, size - written);
+        if (file->write(zeros.constData(), chunk) != chunk)
+        {
+            return false;
+        }
+    }
+
+    return file->flush();
+}
+
+// Reserva a disc tot l'espai del fitxer. Amb un fitxer dispers (el que deixa QFile::resize() a la majoria de sistemes), quedar-se sense espai
+// no es detectaria fins a escriure a la memòria mapejada, i llavors el sistema enviaria un SIGBUS en comptes de retornar un error.
+bool preallocate(QFile *file, qint64 size)
+{
+#if defined(Q_OS_WIN)
+    // A Windows canviar la mida del fitxer ja en reserva l'espai
+    return file->resize(size);
+#else
+#if defined(Q_OS_LINUX)
+    int result = posix_fallocate(file->handle(), 0, size);
+    if (result == 0)
+    {
+        return true;
+    }
+    // Si el sistema de fitxers no ho suporta, ho fem escrivint zeros. Qualsevol altre error (p.ex. ENOSPC) vol dir que no hi ha prou espai.
+    if (result != EINVAL && result != EOPNOTSUPP)
+    {
+        return false;
+    }
+#endif
+    return fillWithZeros(file, size);
+#endif
+}
+
+}
+
+vtkDataArray* MemoryMappedDataArray::create(QFile *file, qint64 offset, int scalarType, int numberOfComponents, qint64 numberOfTuples,
+                                            QFileDevice::MemoryMapFlags flags)
+{
+    vtkDataArray *array = vtkDataArray::CreateDataArray(scalarType);
+    if (!array || numberOfComponents < 1 || numberOfTuples < 1)
+    {
+        if (array)
+        {
+            array->Delete();
+        }
+        delete file;
+        return NULL;
+    }
+
+    qint64 numberOfValues = numberOfTuples * numberOfComponents;
+    uchar *data = file->map(offset, numberOfValues * array->GetDataTypeSize(), flags);
+    if (!data)
+    {
+        WARN_LOG(QString("No s'ha pogut mapejar el fitxer %1: %2").arg(file->fileName()).arg(file->errorString()));
+        array->Delete();
+        delete file;
+        return NULL;
+    }
+
+    {
+        QMutexLocker locker(&mappedFilesMutex);
+        mappedFiles.insert(data, file);
+    }
+
+    array->SetNumberOfComponents(numberOfComponents);
+    array->SetVoidArray(data, numberOfValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+    array->SetArrayFreeFunction(unmapFile);
+
+    return array;
+}
+
+vtkDataArray* MemoryMappedDataArray::createTemporary(const QString &directory, int scalarType, int numberOfComponents, qint64 numberOfTuples)
+{
+    QTemporaryFile *file = new QTemporaryFile(QDir(directory).filePath("volume-XXXXXX.raw"));
+
+    vtkDataArray *sizeProbe = vtkDataArray::CreateDataArray(scalarType);
+    if (!sizeProbe)
+    {
+        delete file;
+        return NULL;
+    }
+    qint64 size = numberOfTuples * numberOfComponents * sizeProbe->GetDataTypeSize();
+    sizeProbe->Delete();
+
+    if (!file->open() || !preallocate(file, size))
+    {
+        WARN_LOG(QString("No s'ha pogut crear un fitxer temporal de %1 bytes a %2").arg(size).arg(directory));
+        delete file;
+        return NULL;
+    }
+
+    return create(file, 0, scalarType, numberOfComponents, numberOfTuples);
+}
+
+} // End namespace udg
@@ -0,0 +1,47 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#ifndef UDGMEMORYMAPPEDDATAARRAY_H
+#define UDGMEMORYMAPPEDDATAARRAY_H
+
+#include <QFileDevice>
+
+class QFile;
+class vtkDataArray;
+
+namespace udg {
+
+/**
+    Crea arrays de VTK que fan servir com a memòria un fitxer mapejat en comptes de memòria del heap.
+
+    El fitxer es desmapeja i es destrueix quan VTK allibera l'array. D'aquesta manera el sistema operatiu pot treure de memòria les pàgines que
+    no es fan servir i tornar-les a llegir del fitxer quan es necessiten, i es poden tenir volums més grans que la memòria física.
+  */
+class MemoryMappedDataArray {
+public:
+    /// Crea un array amb els tuples del tipus i nombre de components donats mapejant el fitxer donat a partir de l'offset indicat.
+    /// El fitxer ha d'estar obert i l'array se'n fa propietari, també si falla. Retorna nul si no s'ha pogut mapejar.
+    static vtkDataArray* create(QFile *file, qint64 offset, int scalarType, int numberOfComponents, qint64 numberOfTuples,
+                                QFileDevice::MemoryMapFlags flags = QFileDevice::NoOptions);
+
+    /// Crea un array de la mida donada sobre un fitxer temporal nou dins del directori indicat, que s'esborra quan s'allibera l'array.
+    /// Tot l'espai del fitxer es reserva a disc abans de mapejar-lo. Retorna nul si no s'ha pogut crear o no hi ha prou espai, i en aquest cas
+    /// qui el crida ha de reservar les dades a memòria.
+    static vtkDataArray* createTemporary(const QString &directory, int scalarType, int numberOfComponents, qint64 numberOfTuples);
+};
+
+} // End namespace udg
+
+#endif
@@ -63,7 +63,7 @@ void NonClosedAngleTool::deleteTemporalRepresentation()
 
     if (hasToRefresh)
     {
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 
     m_state = None;
@@ -187,7 +187,7 @@ void NonClosedAngleTool::simulateLine(DrawerLine *line)
     line->setSecondPoint(clickedWorldPoint);
     // Actualitzem viewer
     line->update();
-    m_2DViewer->render();
+    m_2DViewer->requestRender();
 }
 
 void NonClosedAngleTool::computeAngle()
@@ -134,6 +134,11 @@ QList<Patient*> PatientFiller::processFiles(const QStringList &files)
     }
 }
 
+QList<Patient*> PatientFiller::getPatients() const
+{
+    return m_patientFillerInput->getPatientList();
+}
+
 void PatientFiller::createSteps()
 {
     m_firstStageSteps << new DICOMFileClassifierFillerStep() << new ImageFillerStep() << new EncapsulatedDocumentFillerStep();
@@ -53,6 +53,9 @@ public slots:
     /// Processes the given files executing both stages and post-processing. Returns the generated patients.
     QList<Patient*> processFiles(const QStringList &files);
 
+    /// Returns the patients generated so far. Useful after finishDICOMFilesProcess() when more than one patient can be generated.
+    QList<Patient*> getPatients() const;
+
 signals:
     /// This signal is emitted each time a file is processed.
     void progress(int numberOfProcessedFiles);
@@ -280,19 +280,19 @@ void PerpendicularDistanceTool::updateSecondPerpendicularLine()
 void PerpendicularDistanceTool::updateReferenceLineAndRender()
 {
     updateReferenceLine();
-    m_2DViewer->render();
+    m_2DViewer->requestRender();
 }
 
 void PerpendicularDistanceTool::updateFirstPerpendicularLineAndRender()
 {
     updateFirstPerpendicularLine();
-    m_2DViewer->render();
+    m_2DViewer->requestRender();
 }
 
 void PerpendicularDistanceTool::updateSecondPerpendicularLineAndRender()
 {
     updateSecondPerpendicularLine();
-    m_2DViewer->render();
+    m_2DViewer->requestRender();
 }
 
 void PerpendicularDistanceTool::drawDistance()
@@ -411,7 +411,7 @@ void PerpendicularDistanceTool::reset()
 
     if (hasToRender)
     {
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 
     m_state = NotDrawing;
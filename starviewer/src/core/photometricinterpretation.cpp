@@ -16,6 +16,36 @@
 
 namespace udg {
 
+namespace {
+
+// Creates the map between the enumerated values and the corresponding string
+QMap<PhotometricInterpretation::PhotometricType, QString> createTypeStringMap()
+{
+    QMap<PhotometricInterpretation::PhotometricType, QString> map;
+    map.insert(PhotometricInterpretation::Monochrome1, "MONOCHROME1");
+    map.insert(PhotometricInterpretation::Monochrome2, "MONOCHROME2");
+    map.insert(PhotometricInterpretation::RGB, "RGB");
+    map.insert(PhotometricInterpretation::Palette_Color, "PALETTE COLOR");
+    map.insert(PhotometricInterpretation::YBR_Full,  "YBR_FULL");
+    map.insert(PhotometricInterpretation::YBR_Full_422, "YBR_FULL_422");
+    map.insert(PhotometricInterpretation::YBR_Partial_422, "YBR_PARTIAL_422");
+    map.insert(PhotometricInterpretation::YBR_Partial_420, "YBR_PARTIAL_420");
+    map.insert(PhotometricInterpretation::YBR_ICT, "YBR_ICT");
+    map.insert(PhotometricInterpretation::YBR_RCT, "YBR_RCT");
+    map.insert(PhotometricInterpretation::None, "");
+    return map;
+}
+
+// Returns the map between the enumerated values and the corresponding string.
+// It's shared by all the instances instead of having a copy in each one, since every Image has a PhotometricInterpretation.
+const QMap<PhotometricInterpretation::PhotometricType, QString>& typeStringMap()
+{
+    static const QMap<PhotometricInterpretation::PhotometricType, QString> map = createTypeStringMap();
+    return map;
+}
+
+}
+
 PhotometricInterpretation::PhotometricInterpretation()
 {
     init();
@@ -40,24 +70,13 @@ PhotometricInterpretation::~PhotometricInterpretation()
 void PhotometricInterpretation::init()
 {
     m_value = None;
-    m_typeStringMap.insert(Monochrome1, "MONOCHROME1");
-    m_typeStringMap.insert(Monochrome2, "MONOCHROME2");
-    m_typeStringMap.insert(RGB, "RGB");
-    m_typeStringMap.insert(Palette_Color, "PALETTE COLOR");
-    m_typeStringMap.insert(YBR_Full,  "YBR_FULL");
-    m_typeStringMap.insert(YBR_Full_422, "YBR_FULL_422");
-    m_typeStringMap.insert(YBR_Partial_422, "YBR_PARTIAL_422");
-    m_typeStringMap.insert(YBR_Partial_420, "YBR_PARTIAL_420");
-    m_typeStringMap.insert(YBR_ICT, "YBR_ICT");
-    m_typeStringMap.insert(YBR_RCT, "YBR_RCT");
-    m_typeStringMap.insert(None, "");
 }
 
 PhotometricInterpretation::PhotometricType PhotometricInterpretation::getFromString(const QString &value) const
 {
     PhotometricType mappedValue = None;
     
-    QMapIterator<PhotometricType, QString> iterator(m_typeStringMap);
+    QMapIterator<PhotometricType, QString> iterator(typeStringMap());
     while (iterator.hasNext())
     {
         iterator.next();
@@ -110,7 +129,7 @@ bool PhotometricInterpretation::isColor() const
 
 QString PhotometricInterpretation::getAsQString() const
 {
-    return m_typeStringMap.value(m_value);
+    return typeStringMap().value(m_value);
 }
 
 bool PhotometricInterpretation::operator==(const PhotometricInterpretation &value) const
@@ -64,9 +64,6 @@ private:
 private:
     /// The photometric interpretation value
     PhotometricType m_value;
-    
-    /// Maps the enumerated values with the corresponding string
-    QMap<PhotometricType, QString> m_typeStringMap;
 };
 
 } // End namespace udg
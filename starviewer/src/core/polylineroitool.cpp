@@ -66,7 +66,7 @@ void PolylineROITool::deleteTemporalRepresentation()
 
     if (hasToRefresh)
     {
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 }
 
@@ -181,7 +181,7 @@ void PolylineROITool::simulateClosingPolyline()
             // Actualitzem els atributs de la polilínia
             m_closingPolyline->update();
         }
-        m_2DViewer->render();
+        m_2DViewer->requestRender();
     }
 }
 
@@ -1609,6 +1609,17 @@ void Q2DViewer::restoreRenderingQuality()
     }
 }
 
+void Q2DViewer::reduceRenderingQuality()
+{
+    if (m_displayUnitsHandler)
+    {
+        foreach (auto *volumeDisplayUnit, m_displayUnitsHandler->getVolumeDisplayUnitList())
+        {
+            volumeDisplayUnit->reduceRenderingQuality();
+        }
+    }
+}
+
 void Q2DViewer::restore()
 {
     if (!hasInput())
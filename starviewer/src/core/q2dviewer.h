@@ -175,7 +175,7 @@ public:
     SliceOrientedVolumePixelData getCurrentPixelDataFromInput(int i);
 
     /// Restores the standard rendering quality in this viewer.
-    void restoreRenderingQuality();
+    virtual void restoreRenderingQuality() override;
     
     /// Ens dóna la llesca mínima/màxima de llesques, tenint en compte totes les imatges,
     /// tant com si hi ha fases com si no
@@ -438,6 +438,9 @@ protected:
     /// Sets the current view plane.
     virtual void setCurrentViewPlane(const OrthogonalPlane &viewPlane);
 
+    /// Reduces the rendering quality of all the volume display units while interacting.
+    virtual void reduceRenderingQuality() override;
+
 private:
     /// Updates image orientation according to the preferred presentation depending on its attributes, like modality.
     /// At this moment it is only applying to mammography (MG) images
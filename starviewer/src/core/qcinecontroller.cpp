@@ -18,6 +18,9 @@
 #include <QToolButton>
 #include <QMenu>
 #include <QWidgetAction>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QProgressDialog>
 
 namespace udg {
 
@@ -46,6 +49,9 @@ QCINEController::QCINEController(QWidget *parent)
     boomerangWidgetAction->setDefaultWidget(m_boomerangCheckBox);
     menu->addAction(boomerangWidgetAction);
 
+    menu->addSeparator();
+    menu->addAction(tr("Export movie..."), this, SLOT(exportMovie()));
+
     m_playToolButton->setMenu(menu);
 }
 
@@ -92,4 +98,33 @@ void QCINEController::updateLoopStatus(bool enabled)
     m_cineController->enableBoomerang(m_boomerangCheckBox->isChecked());
 }
 
+void QCINEController::exportMovie()
+{
+    if (!m_cineController)
+    {
+        return;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Export movie"), QString(), tr("Animated PNG (*.png)"));
+    if (fileName.isEmpty())
+    {
+        return;
+    }
+
+    if (!fileName.endsWith(".png", Qt::CaseInsensitive))
+    {
+        fileName += ".png";
+    }
+
+    QProgressDialog progressDialog(tr("Exporting movie..."), QString(), 0, m_cineController->getNumberOfMovieFrames(), this);
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(500);
+    connect(m_cineController, SIGNAL(movieExportProgress(int)), &progressDialog, SLOT(setValue(int)));
+
+    if (!m_cineController->exportMovie(fileName))
+    {
+        QMessageBox::warning(this, tr("Export movie"), tr("The movie could not be exported to %1.").arg(fileName));
+    }
+}
+
 }
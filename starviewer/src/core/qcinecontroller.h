@@ -37,6 +37,9 @@ protected slots:
     void updateVelocityLabel(int value);
     void updateLoopStatus(bool enabled);
 
+    /// Demana un fitxer a l'usuari i hi exporta la seqüència de CINE
+    void exportMovie();
+
 protected:
     QViewerCINEController *m_cineController;
 };
@@ -15,6 +15,7 @@
 #include "qcustomwindowleveleditwidget.h"
 #include "customwindowlevelsrepository.h"
 #include "customwindowlevelswriter.h"
+#include "customwindowlevelsloader.h"
 #include "logging.h"
 
 #include <QMessageBox>
@@ -49,6 +50,8 @@ void QCustomWindowLevelEditWidget::setDefaultWindowLevel(const WindowLevel &wind
 
 void QCustomWindowLevelEditWidget::loadCustomWindowLevelPresets()
 {
+    CustomWindowLevelsLoader::loadDefaultsOnce();
+
     // Eliminem el que hi ha.
     int items = m_customWindowLevelTreeWidget->topLevelItemCount();
     for (int i = 0; i < items; i++)
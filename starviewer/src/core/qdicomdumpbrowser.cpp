@@ -137,12 +137,7 @@ void QDICOMDumpBrowser::setCurrentDisplayedImage(Image *currentImage)
 {
     if (currentImage->getPath() != m_lastImagePathDICOMDumpDisplayed)
     {
-        // \TODO Xapusa per sortir del pas, s'ha de fer ben fet el lazy loading
-        if (DICOMDumpDefaultTagsRepository::getRepository()->getNumberOfItems() == 0)
-        {
-            DICOMDumpDefaultTagsLoader dicomDumpDefaultTagsLoader;
-            dicomDumpDefaultTagsLoader.loadDefaults();
-        }
+        DICOMDumpDefaultTagsLoader::loadDefaultsOnce();
 
         DICOMTagReader dicomReader;
         bool ok = dicomReader.setFile(currentImage->getPath());
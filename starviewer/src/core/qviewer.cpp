@@ -37,6 +37,8 @@
 #include <QMessageBox>
 #include <QDir>
 #include <QScreen>
+#include <QElapsedTimer>
+#include <QTimer>
 
 // Include's vtk
 #include <QVTKWidget.h>
@@ -54,9 +56,19 @@
 
 namespace udg {
 
+namespace {
+
+// Default frame time budget for requested renders, equivalent to 30 fps
+const int DefaultInteractiveFrameTimeBudget = 33;
+// Time without requested renders after which the interaction is considered finished
+const int RestoreRenderingQualityDelay = 250;
+
+}
+
 QViewer::QViewer(QWidget *parent)
  : QWidget(parent), m_mainVolume(0), m_contextMenuActive(true), m_mouseHasMoved(false), m_voiLutData(0),
-   m_isRenderingEnabled(true), m_isActive(false)
+   m_isRenderingEnabled(true), m_isActive(false), m_renderCoalescingDepth(0), m_interactiveFrameTimeBudget(DefaultInteractiveFrameTimeBudget),
+   m_isRenderingQualityReduced(false)
 {
     m_lastAngleDelta = QPoint();
     m_defaultFitIntoViewportMarginRate = 0.0;
@@ -66,6 +78,16 @@ QViewer::QViewer(QWidget *parent)
 
     m_windowToImageFilter = vtkWindowToImageFilter::New();
 
+    m_requestedRenderTimer = new QTimer(this);
+    m_requestedRenderTimer->setSingleShot(true);
+    m_requestedRenderTimer->setInterval(0);
+    connect(m_requestedRenderTimer, SIGNAL(timeout()), SLOT(renderRequested()));
+
+    m_renderingQualityRestoreTimer = new QTimer(this);
+    m_renderingQualityRestoreTimer->setSingleShot(true);
+    m_renderingQualityRestoreTimer->setInterval(RestoreRenderingQualityDelay);
+    connect(m_renderingQualityRestoreTimer, SIGNAL(timeout()), SLOT(restoreRenderingQualityAfterInteraction()));
+
     setupRenderWindow();
 
     this->setCurrentViewPlane(OrthogonalPlane::XYPlane);
@@ -355,45 +377,13 @@ bool QViewer::saveGrabbedViews(const QString &baseName, FileType extension)
 {
     if (!m_grabList.empty())
     {
-        vtkImageWriter *writer;
         QString fileExtension;
-        switch (extension)
+        vtkImageWriter *writer = createImageWriter(extension, fileExtension);
+        if (!writer)
         {
-            case PNG:
-                writer = vtkPNGWriter::New();
-                fileExtension = "png";
-                break;
-
-            case JPEG:
-                writer = vtkJPEGWriter::New();
-                fileExtension = "jpg";
-                break;
-
-            case TIFF:
-                writer = vtkTIFFWriter::New();
-                fileExtension = "tiff";
-                break;
-
-            case PNM:
-                writer = vtkPNMWriter::New();
-                fileExtension = "pnm";
-                break;
-
-            case BMP:
-                writer = vtkBMPWriter::New();
-                fileExtension = "bmp";
-                break;
-
-            case DICOM:
-                // TODO A suportar
-                DEBUG_LOG("El format DICOM encara no està suportat per guardar imatges");
-                return false;
-
-            case META:
-                // TODO A suportar
-                DEBUG_LOG("El format META encara no està suportat per guardar imatges");
-                return false;
+            return false;
         }
+
         int count = m_grabList.count();
         if (count == 1)
         {
@@ -427,6 +417,44 @@ bool QViewer::saveGrabbedViews(const QString &baseName, FileType extension)
     }
 }
 
+vtkImageWriter* QViewer::createImageWriter(FileType fileType, QString &fileExtension)
+{
+    switch (fileType)
+    {
+        case PNG:
+            fileExtension = "png";
+            return vtkPNGWriter::New();
+
+        case JPEG:
+            fileExtension = "jpg";
+            return vtkJPEGWriter::New();
+
+        case TIFF:
+            fileExtension = "tiff";
+            return vtkTIFFWriter::New();
+
+        case PNM:
+            fileExtension = "pnm";
+            return vtkPNMWriter::New();
+
+        case BMP:
+            fileExtension = "bmp";
+            return vtkBMPWriter::New();
+
+        case DICOM:
+            // TODO A suportar
+            DEBUG_LOG("El format DICOM encara no està suportat per guardar imatges");
+            return NULL;
+
+        case META:
+            // TODO A suportar
+            DEBUG_LOG("El format META encara no està suportat per guardar imatges");
+            return NULL;
+    }
+
+    return NULL;
+}
+
 void QViewer::clearGrabbedViews()
 {
     foreach (vtkImageData *image, m_grabList)
@@ -438,6 +466,15 @@ void QViewer::clearGrabbedViews()
 
 void QViewer::render()
 {
+    if (m_renderCoalescingDepth > 0)
+    {
+        requestRender();
+        return;
+    }
+
+    // This render fulfils the pending request, if any
+    m_requestedRenderTimer->stop();
+
     // ATENCIO És important que només es faci render quan estem en estat VisualizingVolume
     // ja que sinó pot provocar que en alguns casos es presentin problemes de rendering
     // al no obtenir-se el context de rendering openGL adequat
@@ -455,6 +492,67 @@ void QViewer::render()
     }
 }
 
+void QViewer::requestRender()
+{
+    if (!m_requestedRenderTimer->isActive())
+    {
+        m_requestedRenderTimer->start();
+    }
+}
+
+void QViewer::beginRenderCoalescing()
+{
+    m_renderCoalescingDepth++;
+}
+
+void QViewer::endRenderCoalescing()
+{
+    if (m_renderCoalescingDepth > 0)
+    {
+        m_renderCoalescingDepth--;
+    }
+}
+
+void QViewer::setInteractiveFrameTimeBudget(int milliseconds)
+{
+    m_interactiveFrameTimeBudget = milliseconds;
+}
+
+void QViewer::restoreRenderingQuality()
+{
+}
+
+void QViewer::reduceRenderingQuality()
+{
+}
+
+void QViewer::renderRequested()
+{
+    QElapsedTimer frameTimer;
+    frameTimer.start();
+
+    render();
+
+    if (!m_isRenderingQualityReduced && frameTimer.elapsed() > m_interactiveFrameTimeBudget)
+    {
+        DEBUG_LOG(QString("Requested render took %1 ms, reducing rendering quality while interacting").arg(frameTimer.elapsed()));
+        reduceRenderingQuality();
+        m_isRenderingQualityReduced = true;
+    }
+
+    if (m_isRenderingQualityReduced)
+    {
+        m_renderingQualityRestoreTimer->start();
+    }
+}
+
+void QViewer::restoreRenderingQualityAfterInteraction()
+{
+    m_isRenderingQualityReduced = false;
+    restoreRenderingQuality();
+    render();
+}
+
 void QViewer::absoluteZoom(double factor)
 {
     double currentFactor = getCurrentZoomFactor();
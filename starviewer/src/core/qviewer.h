@@ -25,12 +25,14 @@
 
 // Fordward declarations
 class QStackedLayout;
+class QTimer;
 class QVTKWidget;
 class vtkCamera;
 class vtkRenderer;
 class vtkRenderWindow;
 class vtkRenderWindowInteractor;
 class vtkWindowToImageFilter;
+class vtkImageWriter;
 class vtkEventQtSlotConnect;
 
 namespace udg {
@@ -112,6 +114,10 @@ public:
     /// Retorna TRUE si hi havia imatges per guardar, FALSE altrament
     bool saveGrabbedViews(const QString &baseName, FileType extension);
 
+    /// Crea un writer pel tipus de fitxer donat i assigna a fileExtension l'extensió que han de tenir els fitxers.
+    /// Retorna NULL si el tipus no està suportat. Qui crida és responsable d'esborrar el writer.
+    static vtkImageWriter* createImageWriter(FileType fileType, QString &fileExtension);
+
     /// Retorna el nombre de vistes capturades que estan desades
     int grabbedViewsCount()
     {
@@ -176,6 +182,17 @@ public:
     /// Returns the VOI LUT that is currently applied to the image in this viewer. The default implementation returns a default VoiLut.
     virtual VoiLut getCurrentVoiLut() const;
 
+    /// While render coalescing is active, calls to render() are turned into calls to requestRender(). Calls can be nested and must be balanced.
+    /// Useful when several operations that render on their own are applied at once, e.g. when synchronizing viewers.
+    void beginRenderCoalescing();
+    void endRenderCoalescing();
+
+    /// Sets the maximum time in milliseconds that a requested render can take before the rendering quality is reduced while interacting.
+    void setInteractiveFrameTimeBudget(int milliseconds);
+
+    /// Restores the standard rendering quality in this viewer. The default implementation does nothing.
+    virtual void restoreRenderingQuality();
+
 public slots:
     /// Indiquem les dades d'entrada
     virtual void setInput(Volume *volume) = 0;
@@ -186,6 +203,10 @@ public slots:
     /// Força l'execució de la visualització
     void render();
 
+    /// Requests a render of the viewer, which is done in the next iteration of the event loop.
+    /// All the requests made before then, and any direct render() done in between, are coalesced into a single render.
+    void requestRender();
+
     /// Assignem si aquest visualitzador és actiu, és a dir, amb el que s'està interactuant
     /// @param active
     void setActive(bool active);
@@ -289,12 +310,22 @@ protected:
     /// Handles errors produced by lack of memory space for visualization.
     void handleNotEnoughMemoryForVisualizationError();
 
+    /// Reduces the rendering quality to keep the interaction fluent when requested renders exceed the frame time budget.
+    /// The default implementation does nothing.
+    virtual void reduceRenderingQuality();
+
 private slots:
     /// Slot que s'utilitza quan s'ha seleccionat una sèrie amb el PatientBrowserMenu
     /// Mètode que especifica un input seguit d'una crida al mètode render()
     /// TODO: Convertit en virtual per tal de poder ser reimplementat per Q2DViewer per càrrega asíncrona
     virtual void setInputAndRender(Volume *volume);
 
+    /// Renders the viewer to fulfil the pending render requests and checks the frame time budget.
+    void renderRequested();
+
+    /// Restores the rendering quality once the interaction has finished and renders again.
+    void restoreRenderingQualityAfterInteraction();
+
 private:
     /// Actualitza quin és el widget actual que es mostra per pantalla a partir de l'estat del viewer
     void setCurrentWidgetByViewerStatus(ViewerStatus status);
@@ -364,6 +395,17 @@ private:
 
     /// Layout que ens permet crear widgets diferents per els estats diferents del visor.
     QStackedLayout *m_stackedLayout;
+
+    /// Single shot timer that fires in the next iteration of the event loop when there are pending render requests.
+    QTimer *m_requestedRenderTimer;
+    /// Single shot timer that restores the rendering quality when there have been no requested renders for a while.
+    QTimer *m_renderingQualityRestoreTimer;
+    /// Nesting level of beginRenderCoalescing() calls.
+    int m_renderCoalescingDepth;
+    /// Maximum time in milliseconds that a requested render can take before the rendering quality is reduced.
+    int m_interactiveFrameTimeBudget;
+    /// True while the rendering quality is reduced because of the frame time budget.
+    bool m_isRenderingQualityReduced;
 };
 
 };  // End namespace udg
@@ -20,6 +20,8 @@
 
 #include "volume.h"
 #include "logging.h"
+#include "apngwriter.h"
+#include "viewerbatchcapturer.h"
 
 // Qt
 #include <QAction>
@@ -104,6 +106,59 @@ QAction *QViewerCINEController::getBoomerangAction() const
     return m_boomerangAction;
 }
 
+bool QViewerCINEController::exportMovie(const QString &fileName)
+{
+    if (!m_2DViewer || !m_2DViewer->hasInput())
+    {
+        return false;
+    }
+
+    ViewerBatchCapturer capturer(m_2DViewer);
+    foreach (int imageIndex, getMovieImageIndices())
+    {
+        if (m_cineDimension == TemporalDimension)
+        {
+            capturer.addSliceAndPhase(m_2DViewer->getCurrentSlice(), imageIndex);
+        }
+        else
+        {
+            capturer.addSliceAndPhase(imageIndex, m_2DViewer->getCurrentPhase());
+        }
+    }
+    connect(&capturer, SIGNAL(progress(int)), SIGNAL(movieExportProgress(int)));
+
+    // Si s'està reproduint es para perquè el timer no canviï la llesca mentre es captura
+    if (m_playing)
+    {
+        pause();
+    }
+
+    ApngWriter writer;
+    if (!writer.open(fileName, m_velocity, m_loopEnabled))
+    {
+        return false;
+    }
+
+    bool ok = capturer.captureToAnimatedPng(&writer);
+    ok = writer.close() && ok;
+
+    if (ok)
+    {
+        INFO_LOG(QString("S'ha exportat la seqüència de CINE amb %1 frames a %2").arg(writer.getNumberOfFrames()).arg(fileName));
+    }
+    else
+    {
+        ERROR_LOG("No s'ha pogut exportar la seqüència de CINE a " + fileName);
+    }
+
+    return ok;
+}
+
+int QViewerCINEController::getNumberOfMovieFrames() const
+{
+    return getMovieImageIndices().count();
+}
+
 void QViewerCINEController::play()
 {
     if (!m_playing)
@@ -252,6 +307,26 @@ void QViewerCINEController::handleCINETimerEvent()
     }
 }
 
+QList<int> QViewerCINEController::getMovieImageIndices() const
+{
+    QList<int> indices;
+    for (int i = m_firstSliceInterval; i <= m_lastSliceInterval; i++)
+    {
+        indices << i;
+    }
+
+    // En mode boomerang es torna enrere sense repetir els extrems, perquè en repetir l'animació no quedin frames duplicats
+    if (m_boomerangEnabled)
+    {
+        for (int i = m_lastSliceInterval - 1; i > m_firstSliceInterval; i--)
+        {
+            indices << i;
+        }
+    }
+
+    return indices;
+}
+
 void QViewerCINEController::resetCINEInformation(Volume *input)
 {
     if (input)
@@ -16,6 +16,7 @@
 #define UDGQVIEWERCINECONTROLLER_H
 
 #include <QObject>
+#include <QList>
 
 class QAction;
 class QBasicTimer;
@@ -47,11 +48,21 @@ public:
     QAction* getLoopAction() const;
     QAction* getBoomerangAction() const;
 
+    /// Exporta la seqüència de CINE com a PNG animat al fitxer donat, amb el mateix interval, velocitat, loop i boomerang que la reproducció.
+    /// Els frames es renderitzen sense mostrar-se per pantalla i s'escriuen a mesura que es generen. Retorna cert si s'ha pogut exportar.
+    bool exportMovie(const QString &fileName);
+
+    /// Retorna el nombre de frames que tindria la seqüència exportada
+    int getNumberOfMovieFrames() const;
+
 signals:
     void playing();
     void paused();
     void velocityChanged(int velocity);
 
+    /// S'emet durant l'exportació amb el nombre de frames exportats
+    void movieExportProgress(int numberOfFrames);
+
 public slots:
     /// Engega la reproducció
     void play();
@@ -88,6 +99,9 @@ private:
     /// durant la reproducció
     void handleCINETimerEvent();
 
+    /// Retorna els índexs de llesca o fase, segons la dimensió de CINE, que formen la seqüència en ordre de reproducció
+    QList<int> getMovieImageIndices() const;
+
 private:
     /// Variables de reproducció
     int m_firstSliceInterval;
@@ -0,0 +1,306 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#include "rawpixeldatacache.h"
+
+#include "coresettings.h"
+#include "logging.h"
+#include "memorymappeddataarray.h"
+#include "volumepixeldata.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QScopedPointer>
+
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+
+namespace udg {
+
+const quint32 RawPixelDataCache::FormatVersion = 1;
+
+namespace {
+
+// Identificador dels fitxers raw de la cache
+const quint32 MagicNumber = 0x53565058;
+// Les dades comencen en aquest offset perquè el mapejat quedi alineat a pàgina
+const qint64 DataOffset = 4096;
+// Subdirectori del directori de la sèrie on es guarden els fitxers raw
+const QString CacheDirectoryName("pixeldatacache");
+
+// Retorna el path donat normalitzat per poder-lo comparar
+QString getNormalizedPath(const QString &path)
+{
+    return QDir::cleanPath(QDir::fromNativeSeparators(path));
+}
+
+#ifdef Q_OS_WIN
+// Crea un array amb les dades del fitxer donat a partir de l'offset indicat, llegides a memòria. Esborra el fitxer, que queda tancat.
+vtkDataArray* readDataArray(QFile *file, qint64 offset, int scalarType, int numberOfComponents, qint64 numberOfTuples)
+{
+    QScopedPointer<QFile> fileDeleter(file);
+
+    vtkDataArray *array = vtkDataArray::CreateDataArray(scalarType);
+    if (!array)
+    {
+        return NULL;
+    }
+
+    array->SetNumberOfComponents(numberOfComponents);
+    array->SetNumberOfTuples(numberOfTuples);
+    qint64 size = numberOfTuples * numberOfComponents * array->GetDataTypeSize();
+    char *data = static_cast<char*>(array->GetVoidPointer(0));
+
+    if (!data || !file->seek(offset) || file->read(data, size) != size)
+    {
+        WARN_LOG(QString("No s'ha pogut llegir el fitxer de la cache de pixel data %1").arg(file->fileName()));
+        array->Delete();
+        return NULL;
+    }
+
+    return array;
+}
+#endif
+
+}
+
+RawPixelDataCache::RawPixelDataCache(const QStringList &files, const QList<int> &frameNumbers, const QString &readerName)
+    : m_files(files), m_frameNumbers(frameNumbers), m_readerName(readerName)
+{
+    m_maximumDataSize = Settings().getValue(CoreSettings::CacheDecodedPixelDataMaximumVolumeSize).toLongLong() * 1024 * 1024;
+}
+
+bool RawPixelDataCache::isEnabled() const
+{
+    if (m_files.isEmpty())
+    {
+        return false;
+    }
+
+    Settings settings;
+    if (!settings.getValue(CoreSettings::CacheDecodedPixelData).toBool())
+    {
+        return false;
+    }
+
+    // Només es guarden fitxers de la base de dades local, mai al costat de fitxers oberts des del disc o d'un DICOMDIR
+    QString localDatabaseCachePath = getNormalizedPath(settings.getValue(CoreSettings::LocalDatabaseCachePath).toString());
+    if (localDatabaseCachePath.isEmpty())
+    {
+        return false;
+    }
+
+    return getNormalizedPath(QFileInfo(m_files.first()).absoluteFilePath()).startsWith(localDatabaseCachePath + "/");
+}
+
+void RawPixelDataCache::setMaximumDataSize(qint64 maximumDataSize)
+{
+    m_maximumDataSize = maximumDataSize;
+}
+
+qint64 RawPixelDataCache::getMaximumDataSize() const
+{
+    return m_maximumDataSize;
+}
+
+VolumePixelData* RawPixelDataCache::load() const
+{
+    QFile *file = new QFile(getCacheFilePath());
+
+    if (!file->open(QIODevice::ReadOnly))
+    {
+        delete file;
+        return NULL;
+    }
+
+    QDataStream stream(file);
+    quint32 magicNumber, version;
+    QByteArray signature;
+    qint32 scalarType, numberOfComponents;
+    qint32 extent[6];
+    double spacing[3], origin[3];
+    qint64 dataSize;
+
+    stream >> magicNumber >> version >> signature >> scalarType >> numberOfComponents;
+    for (int i = 0; i < 6; i++)
+    {
+        stream >> extent[i];
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        stream >> spacing[i];
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        stream >> origin[i];
+    }
+    stream >> dataSize;
+
+    if (stream.status() != QDataStream::Ok || magicNumber != MagicNumber || version != FormatVersion || file->size() != DataOffset + dataSize)
+    {
+        DEBUG_LOG(QString("Fitxer de la cache de pixel data invàlid: %1").arg(file->fileName()));
+        delete file;
+        return NULL;
+    }
+
+    if (signature != computeSourceSignature())
+    {
+        DEBUG_LOG(QString("Els fitxers d'origen han canviat, no es fa servir el fitxer de la cache de pixel data %1").arg(file->fileName()));
+        delete file;
+        return NULL;
+    }
+
+    qint64 numberOfPoints = static_cast<qint64>(extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1);
+    if (numberOfPoints < 1 || numberOfComponents < 1 || dataSize % (numberOfPoints * numberOfComponents) != 0)
+    {
+        DEBUG_LOG(QString("Fitxer de la cache de pixel data invàlid: %1").arg(file->fileName()));
+        delete file;
+        return NULL;
+    }
+
+#ifdef Q_OS_WIN
+    vtkSmartPointer<vtkDataArray> scalars = vtkSmartPointer<vtkDataArray>::Take(
+        readDataArray(file, DataOffset, scalarType, numberOfComponents, numberOfPoints));
+#else
+    // El mapejat és privat perquè les modificacions que es facin al volum no arribin mai al fitxer
+    vtkSmartPointer<vtkDataArray> scalars = vtkSmartPointer<vtkDataArray>::Take(
+        MemoryMappedDataArray::create(file, DataOffset, scalarType, numberOfComponents, numberOfPoints, QFileDevice::MapPrivateOption));
+#endif
+    if (!scalars || dataSize != numberOfPoints * numberOfComponents * scalars->GetDataTypeSize())
+    {
+        return NULL;
+    }
+
+    vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+    int imageExtent[6] = { extent[0], extent[1], extent[2], extent[3], extent[4], extent[5] };
+    imageData->SetExtent(imageExtent);
+    imageData->SetSpacing(spacing);
+    imageData->SetOrigin(origin);
+    imageData->GetPointData()->SetScalars(scalars);
+
+    VolumePixelData *pixelData = new VolumePixelData();
+    pixelData->setData(imageData);
+
+    return pixelData;
+}
+
+bool RawPixelDataCache::save(VolumePixelData *pixelData) const
+{
+    vtkImageData *imageData = pixelData ? pixelData->getVtkData() : NULL;
+    vtkDataArray *scalars = imageData ? imageData->GetPointData()->GetScalars() : NULL;
+
+    if (!scalars)
+    {
+        return false;
+    }
+
+    qint64 dataSize = static_cast<qint64>(scalars->GetNumberOfTuples()) * scalars->GetNumberOfComponents() * scalars->GetDataTypeSize();
+    if (dataSize > m_maximumDataSize)
+    {
+        DEBUG_LOG(QString("El pixel data ocupa %1 bytes, més que el màxim de la cache (%2), no es guarda").arg(dataSize).arg(m_maximumDataSize));
+        return false;
+    }
+
+    QString cacheFilePath = getCacheFilePath();
+    if (!QDir().mkpath(QFileInfo(cacheFilePath).absolutePath()))
+    {
+        WARN_LOG(QString("No s'ha pogut crear el directori de la cache de pixel data per %1").arg(cacheFilePath));
+        return false;
+    }
+
+    // QSaveFile escriu en un fitxer temporal i el reanomena al final, així mai es pot mapejar un fitxer a mig escriure
+    QSaveFile file(cacheFilePath);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        WARN_LOG(QString("No s'ha pogut crear el fitxer de la cache de pixel data %1").arg(cacheFilePath));
+        return false;
+    }
+
+    int extent[6];
+    double spacing[3], origin[3];
+    imageData->GetExtent(extent);
+    imageData->GetSpacing(spacing);
+    imageData->GetOrigin(origin);
+
+    QDataStream stream(&file);
+    stream << MagicNumber << FormatVersion << computeSourceSignature() << static_cast<qint32>(scalars->GetDataType())
+           << static_cast<qint32>(scalars->GetNumberOfComponents());
+    for (int i = 0; i < 6; i++)
+    {
+        stream << static_cast<qint32>(extent[i]);
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        stream << spacing[i];
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        stream << origin[i];
+    }
+    stream << dataSize;
+
+    if (stream.status() != QDataStream::Ok || file.pos() > DataOffset || !file.seek(DataOffset)
+        || file.write(static_cast<const char*>(scalars->GetVoidPointer(0)), dataSize) != dataSize)
+    {
+        WARN_LOG(QString("No s'ha pogut escriure el fitxer de la cache de pixel data %1").arg(cacheFilePath));
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+QString RawPixelDataCache::getCacheFilePath() const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(m_readerName.toUtf8());
+
+    foreach (const QString &file, m_files)
+    {
+        hash.addData(getNormalizedPath(file).toUtf8());
+    }
+
+    foreach (int frameNumber, m_frameNumbers)
+    {
+        hash.addData(QByteArray::number(frameNumber));
+        hash.addData(",");
+    }
+
+    QString seriesDirectory = QFileInfo(m_files.first()).absolutePath();
+    return seriesDirectory + "/" + CacheDirectoryName + "/" + QString::fromLatin1(hash.result().toHex()) + ".raw";
+}
+
+QByteArray RawPixelDataCache::computeSourceSignature() const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    foreach (const QString &file, m_files)
+    {
+        QFileInfo fileInfo(file);
+        hash.addData(QByteArray::number(fileInfo.size()));
+        hash.addData(QByteArray::number(fileInfo.lastModified().toMSecsSinceEpoch()));
+    }
+
+    return hash.result();
+}
+
+} // End namespace udg
@@ -0,0 +1,81 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#ifndef UDGRAWPIXELDATACACHE_H
+#define UDGRAWPIXELDATACACHE_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace udg {
+
+class VolumePixelData;
+
+/**
+    Cache a disc del pixel data ja descodificat dels volums de la base de dades local.
+
+    Després de llegir un volum, el buffer de vòxels i la seva geometria (extent, spacing i origen) es guarden en un fitxer raw versionat dins
+    del directori de la sèrie, a LocalDatabaseManager::getCachePath(). Les següents lectures del mateix volum mapegen aquest fitxer directament
+    a memòria, sense parsejar ni descodificar els DICOM. Com que el fitxer és dins del directori de l'estudi, s'esborra amb l'estudi.
+
+    El fitxer guarda una signatura de la mida i la data de modificació dels fitxers d'origen: si algun ha canviat, el fitxer raw no es fa servir
+    i se'n torna a crear un de nou a la següent lectura. Els volums més grans que CoreSettings::CacheDecodedPixelDataMaximumVolumeSize no
+    es guarden, ja que ocuparien massa espai al disc.
+
+    A Windows no es pot esborrar un fitxer mentre està mapejat, i això impediria esborrar l'estudi mentre el volum és obert. Per això allà
+    les dades es llegeixen a memòria i el fitxer es tanca de seguida en comptes de mapejar-lo.
+
+    Només s'activa si el setting CoreSettings::CacheDecodedPixelData és cert i només per fitxers que són dins de la cache de la base de dades local.
+  */
+class RawPixelDataCache {
+public:
+    /// Prepara la cache per als fitxers donats, els números de frame a llegir de cadascun i el nom del lector que se'n fa servir
+    RawPixelDataCache(const QStringList &files, const QList<int> &frameNumbers, const QString &readerName);
+
+    /// Retorna cert si es pot fer servir la cache pels fitxers donats
+    bool isEnabled() const;
+
+    /// Assigna/Obté la mida màxima en bytes del pixel data que es guarda a la cache. Per defecte és la del setting corresponent.
+    void setMaximumDataSize(qint64 maximumDataSize);
+    qint64 getMaximumDataSize() const;
+
+    /// Retorna el pixel data guardat a la cache si n'hi ha un de vàlid, o nul altrament. Excepte a Windows, el pixel data retornat fa servir
+    /// la memòria mapejada del fitxer.
+    VolumePixelData* load() const;
+
+    /// Guarda el pixel data donat a la cache. Retorna cert si s'ha pogut guardar. No es guarda si és més gran que la mida màxima.
+    bool save(VolumePixelData *pixelData) const;
+
+private:
+    /// Retorna el path del fitxer raw corresponent als fitxers, frames i lector
+    QString getCacheFilePath() const;
+
+    /// Retorna una signatura de l'estat actual dels fitxers d'origen
+    QByteArray computeSourceSignature() const;
+
+private:
+    /// Versió del format del fitxer raw. Cal incrementar-la cada vegada que canviï.
+    static const quint32 FormatVersion;
+
+    QStringList m_files;
+    QList<int> m_frameNumbers;
+    QString m_readerName;
+    qint64 m_maximumDataSize;
+};
+
+} // End namespace udg
+
+#endif
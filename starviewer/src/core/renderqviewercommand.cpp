@@ -26,7 +26,7 @@ RenderQViewerCommand::RenderQViewerCommand(Q2DViewer *viewer, QObject *parent)
 
 void RenderQViewerCommand::execute()
 {
-    m_viewer->render();
+    m_viewer->requestRender();
 }
 
 } // End namespace udg
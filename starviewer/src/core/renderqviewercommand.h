@@ -22,7 +22,7 @@ namespace udg {
 class Q2DViewer;
 
 /**
-    Command de Q2Viewer que realitza un render() del viewer.
+    Command de Q2Viewer que demana un render del viewer amb requestRender().
   */
 class RenderQViewerCommand : public QViewerCommand {
 Q_OBJECT
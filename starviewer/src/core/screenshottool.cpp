@@ -14,7 +14,7 @@
 
 #include "screenshottool.h"
 #include "qviewer.h"
-#include "q2dviewer.h"
+#include "viewerbatchcapturer.h"
 #include "logging.h"
 #include "volume.h"
 #include "coresettings.h"
@@ -30,6 +30,7 @@
 #include <QString>
 // Pel "wait cursor"
 #include <QApplication>
+#include <QProgressDialog>
 
 namespace udg {
 
@@ -125,44 +126,6 @@ void ScreenShotTool::screenShot(bool singleShot)
         // Guardem el nom de l'ultim fitxer
         m_lastScreenShotFileName = QFileInfo(filename).fileName();
 
-        // Pel que pugui trigar el procés
-        QApplication::setOverrideCursor(Qt::WaitCursor);
-        if (singleShot)
-        {
-            m_viewer->grabCurrentView();
-        }
-        else
-        {
-            Q2DViewer *viewer2D = Q2DViewer::castFromQViewer(m_viewer);
-            if (viewer2D)
-            {
-                // Tenim un  Q2DViewer, llavors podem guardar totes les imatges
-
-                // Guardem la llesca i fase actual per restaurar
-                int currentSlice = viewer2D->getCurrentSlice();
-                int currentPhase = viewer2D->getCurrentPhase();
-                int maxSlice = viewer2D->getMaximumSlice() + 1;
-                // En cas que tinguem fases farem tantes passades com fases
-                int phases = viewer2D->getNumberOfPhases();
-                for (int i = 0; i < maxSlice; i++)
-                {
-                    viewer2D->setSlice(i);
-                    for (int j = 0; j < phases; j++)
-                    {
-                        viewer2D->setPhase(j);
-                        viewer2D->grabCurrentView();
-                    }
-                }
-                // Restaurem
-                viewer2D->setSlice(currentSlice);
-                viewer2D->setPhase(currentPhase);
-            }
-            // Tenim un visor que no és 2D, per tant fem un "single shot"
-            else
-            {
-                m_viewer->grabCurrentView();
-            }
-        }
         // Determinem l'extensió del fitxer
         QViewer::FileType fileExtension;
         if (m_lastScreenShotExtensionFilter == PngFileFilter)
@@ -187,8 +150,30 @@ void ScreenShotTool::screenShot(bool singleShot)
             fileExtension = QViewer::PNG;
             m_lastScreenShotExtensionFilter = PngFileFilter;
         }
-        // Guardem totes les imatges capturades
-        m_viewer->saveGrabbedViews(filename, fileExtension);
+
+        // Pel que pugui trigar el procés
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        if (singleShot)
+        {
+            m_viewer->grabCurrentView();
+            // Guardem la imatge capturada
+            m_viewer->saveGrabbedViews(filename, fileExtension);
+        }
+        else
+        {
+            // Si és un Q2DViewer es capturen totes les llesques i fases sense mostrar-les per pantalla i s'escriuen en paral·lel,
+            // altrament només es captura la vista actual
+            ViewerBatchCapturer capturer(m_viewer);
+            capturer.addAllSlicesAndPhases();
+
+            // El diàleg modal processa els events a cada pas, així la finestra es continua repintant mentre es fan les captures
+            QProgressDialog progressDialog(tr("Saving images..."), QString(), 0, capturer.getNumberOfCaptures(), m_viewer);
+            progressDialog.setWindowModality(Qt::WindowModal);
+            progressDialog.setMinimumDuration(500);
+            connect(&capturer, SIGNAL(progress(int)), &progressDialog, SLOT(setValue(int)));
+
+            capturer.captureToFiles(filename, fileExtension);
+        }
         QApplication::restoreOverrideCursor();
 
         writeSettings();
@@ -145,7 +145,7 @@ void SeedTool::updateSeedPosition()
         else
         {
             m_myData->getPoint()->update();
-            m_2DViewer->render();
+            m_2DViewer->requestRender();
         }
 
         //m_2DViewer->getDrawer()->draw(m_myData->getPoint(), m_2DViewer->getView(), m_2DViewer->getCurrentSlice());
@@ -74,6 +74,7 @@ bool Series::addImage(Image *image)
     {
         image->setParentSeries(this);
         m_imageSet << image;
+        m_imageIdentifiers.insert(imageIdentifierKey);
         m_numberOfImages++;
     }
 
@@ -82,14 +83,7 @@ bool Series::addImage(Image *image)
 
 bool Series::imageExists(const QString &identifier)
 {
-    if (this->findImageIndex(identifier) != -1)
-    {
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+    return m_imageIdentifiers.contains(identifier);
 }
 
 QList<Image*> Series::getImages() const
@@ -103,6 +97,12 @@ void Series::setImages(QList<Image*> imageSet)
     m_imageSet.clear();
     m_imageSet = imageSet;
     m_numberOfImages = m_imageSet.count();
+
+    m_imageIdentifiers.clear();
+    foreach (Image *image, m_imageSet)
+    {
+        m_imageIdentifiers.insert(image->getKeyIdentifier());
+    }
 }
 
 int Series::getNumberOfImages() const
@@ -687,29 +687,6 @@ QTime Series::getRetrievedTime() const
     return m_retrieveTime;
 }
 
-int Series::findImageIndex(const QString &identifier)
-{
-    int i = 0;
-    bool found = false;
-    while (i < m_imageSet.size() && !found)
-    {
-        if (m_imageSet.at(i)->getKeyIdentifier() == identifier)
-        {
-            found = true;
-        }
-        else
-        {
-            ++i;
-        }
-    }
-    if (!found)
-    {
-        i = -1;
-    }
-
-    return i;
-}
-
 Volume* Series::getVolumeOfImage(Image *image)
 {
     bool found = false;
@@ -272,12 +272,6 @@ public slots:
     void unSelect();
     void setSelectStatus(bool select);
 
-private:
-    /// Troba l'índex de la imatge amb el identificadir donat a la llista d'imatges
-    /// @param identifier L'identificador de la imatge que volem trobar
-    /// @return L'índex d'aquella imatge dins de la llista, -1 si no existeix la imatge amb aquell identificador.
-    int findImageIndex(const QString &identifier);
-
 private:
     /// Identificació única del tipus de SOP. Veure PS 3.4 per conèixer el possibles valors que pot tenir.
     QString m_sopClassUID;
@@ -343,6 +337,9 @@ private:
     /// TODO falta definir quina és l'estrategia d'ordenació per defecte
     QList<Image*> m_imageSet;
 
+    /// Identificadors de les imatges de m_imageSet, per poder comprovar ràpidament si una imatge ja hi és sense recórrer tota la llista
+    QSet<QString> m_imageIdentifiers;
+
     /// List of encapsulated documents contained in this series.
     QList<EncapsulatedDocument*> m_encapsulatedDocumentSet;
 
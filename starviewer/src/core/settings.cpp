@@ -18,6 +18,7 @@
 #include "starviewerapplication.h"
 #include "settingsregistry.h"
 #include "settingsparser.h"
+#include "settingscache.h"
 
 #include <QTreeWidget>
 // Pel restoreColumnsWidths
@@ -29,11 +30,6 @@ namespace udg {
 
 Settings::Settings()
 {
-    QSettings *userSettings = new QSettings(QSettings::UserScope, OrganizationNameString, ApplicationNameString);
-    QSettings *systemSettings = new QSettings(QSettings::SystemScope, OrganizationNameString, ApplicationNameString);
-
-    m_qsettingsObjectsMap.insert(UserLevel, userSettings);
-    m_qsettingsObjectsMap.insert(SystemLevel, systemSettings);
 }
 
 Settings::~Settings()
@@ -48,14 +44,19 @@ Settings::~Settings()
 QVariant Settings::getValue(const QString &key) const
 {
     QVariant value;
-    // Primer mirem si tenim valor als settings
-    // Si estigués buit, llavors agafem el valor per defecte que tinguem al registre
-    // TODO hauríem d'obtenir l'objecte de settings amb getSettingsObject(key)
-    // però cal resoldre abans un problema de linkatge produit per projectes externs (crashreporter/sapwrapper)
-    value = m_qsettingsObjectsMap.value(SettingsRegistry::instance()->getAccessLevel(key))->value(key);
-    if (value == QVariant())
+    // Primer mirem si el valor ja és a la cache, així evitem accedir a QSettings
+    SettingsCache *cache = SettingsCache::instance();
+    if (!cache->getValue(key, value))
     {
-        value = SettingsRegistry::instance()->getDefaultValue(key);
+        quint64 generation = cache->getGeneration();
+        // Mirem si tenim valor als settings
+        // Si estigués buit, llavors agafem el valor per defecte que tinguem al registre
+        value = getSettingsObject(SettingsRegistry::instance()->getAccessLevel(key))->value(key);
+        if (value == QVariant())
+        {
+            value = SettingsRegistry::instance()->getDefaultValue(key);
+        }
+        cache->insert(key, value, generation);
     }
 
     // Obtenir les propietats del setting
@@ -72,18 +73,18 @@ QVariant Settings::getValue(const QString &key) const
 void Settings::setValue(const QString &key, const QVariant &value)
 {
     getSettingsObject(key)->setValue(key, value);
+    SettingsCache::instance()->invalidate(key);
 }
 
 bool Settings::contains(const QString &key) const
 {
-    // TODO hauríem d'obtenir l'objecte de settings amb getSettingsObject(key)
-    // però cal resoldre abans un problema de linkatge produit per projectes externs (crashreporter/sapwrapper)
-    return m_qsettingsObjectsMap.value(SettingsRegistry::instance()->getAccessLevel(key))->contains(key);
+    return getSettingsObject(SettingsRegistry::instance()->getAccessLevel(key))->contains(key);
 }
 
 void Settings::remove(const QString &key)
 {
     getSettingsObject(key)->remove(key);
+    SettingsCache::instance()->invalidate(key);
 }
 
 QStringList Settings::getValueAsQStringList(const QString &key, const QString &separator) const
@@ -145,6 +146,7 @@ void Settings::addListItem(const QString &key, const SettingsListItemType &item)
     // Omplim
     dumpSettingsListItem(item, qsettings);
     qsettings->endArray();
+    SettingsCache::instance()->invalidate(key);
 }
 
 void Settings::setListItem(int index, const QString &key, const SettingsListItemType &item)
@@ -192,6 +194,7 @@ void Settings::setList(const QString &key, const SettingListType &list)
         index++;
     }
     qsettings->endArray();
+    SettingsCache::instance()->invalidate(key);
 }
 
 void Settings::saveColumnsWidths(const QString &key, QTreeWidget *treeWidget)
@@ -277,7 +280,20 @@ void Settings::dumpSettingsListItem(const SettingsListItemType &item, QSettings
 
 QSettings *Settings::getSettingsObject(const QString &key)
 {
-    return m_qsettingsObjectsMap.value(SettingsRegistry::instance()->getAccessLevel(key));
+    return getSettingsObject(SettingsRegistry::instance()->getAccessLevel(key));
+}
+
+QSettings *Settings::getSettingsObject(AccessLevel accessLevel) const
+{
+    QSettings *qsettings = m_qsettingsObjectsMap.value(accessLevel);
+    if (!qsettings)
+    {
+        QSettings::Scope scope = accessLevel == SystemLevel ? QSettings::SystemScope : QSettings::UserScope;
+        qsettings = new QSettings(scope, OrganizationNameString, ApplicationNameString);
+        m_qsettingsObjectsMap.insert(accessLevel, qsettings);
+    }
+
+    return qsettings;
 }
 
 }  // End namespace udg
@@ -34,6 +34,8 @@ namespace udg {
     L'escriptura d'un setting no es farà efectiva a disc fins que no es destrueixi la instància.
     Aquest mecanisme funciona d'aquesta manera per raons d'eficiència, així podem assignar diversos
     settings alhora sense penalitzar un accés a disc fins que no es destrueixi l'objecte de Settings.
+    Els valors llegits amb getValue() es guarden a SettingsCache i els objectes QSettings només es creen quan cal accedir-hi,
+    de manera que una lectura d'un valor ja consultat no toca el disc.
   */
 class Settings : public SettingsInterface {
 public:
@@ -120,9 +122,12 @@ private:
     /// segons com estigui configurada la clau en qüestió
     QSettings* getSettingsObject(const QString &key);
 
+    /// Ens retorna l'objecte QSettings del nivell d'accés donat. El crea el primer cop que es demana.
+    QSettings* getSettingsObject(AccessLevel accessLevel) const;
+
 private:
-    /// Objectes QSettings amb el que manipularem les configuracions
-    QMap<int, QSettings*> m_qsettingsObjectsMap;
+    /// Objectes QSettings amb el que manipularem les configuracions. Es creen sota demanda.
+    mutable QMap<int, QSettings*> m_qsettingsObjectsMap;
 };
 } // End namespace udg
 Q_DECLARE_OPERATORS_FOR_FLAGS(udg::Settings::Properties)
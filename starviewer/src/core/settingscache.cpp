@@ -0,0 +1,145 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+#include "settingscache.h"
+
+#include "logging.h"
+#include "starviewerapplication.h"
+
+#include <QFileSystemWatcher>
+#include <QFileInfo>
+#include <QSettings>
+
+namespace udg {
+
+SettingsCache::SettingsCache()
+    : m_generation(0), m_fileSystemWatcher(0)
+{
+}
+
+SettingsCache::~SettingsCache()
+{
+}
+
+bool SettingsCache::getValue(const QString &key, QVariant &value) const
+{
+    QReadLocker locker(&m_lock);
+
+    QHash<QString, QVariant>::const_iterator iterator = m_values.constFind(key);
+    if (iterator == m_values.constEnd())
+    {
+        return false;
+    }
+
+    value = iterator.value();
+    return true;
+}
+
+quint64 SettingsCache::getGeneration() const
+{
+    QReadLocker locker(&m_lock);
+    return m_generation;
+}
+
+void SettingsCache::insert(const QString &key, const QVariant &value, quint64 generation)
+{
+    QWriteLocker locker(&m_lock);
+
+    if (generation == m_generation)
+    {
+        m_values.insert(key, value);
+    }
+}
+
+void SettingsCache::invalidate(const QString &key)
+{
+    if (key.isEmpty())
+    {
+        clear();
+        return;
+    }
+
+    {
+        QWriteLocker locker(&m_lock);
+
+        ++m_generation;
+        m_values.remove(key);
+
+        QString subKeysPrefix = key + "/";
+        QHash<QString, QVariant>::iterator iterator = m_values.begin();
+        while (iterator != m_values.end())
+        {
+            if (iterator.key().startsWith(subKeysPrefix))
+            {
+                iterator = m_values.erase(iterator);
+            }
+            else
+            {
+                ++iterator;
+            }
+        }
+    }
+
+    emit changed(key);
+}
+
+void SettingsCache::clear()
+{
+    {
+        QWriteLocker locker(&m_lock);
+
+        ++m_generation;
+        m_values.clear();
+    }
+
+    emit changed(QString());
+}
+
+void SettingsCache::startWatchingSettingsFiles()
+{
+    if (m_fileSystemWatcher)
+    {
+        return;
+    }
+
+    m_fileSystemWatcher = new QFileSystemWatcher(this);
+    connect(m_fileSystemWatcher, SIGNAL(fileChanged(QString)), SLOT(settingsFileChanged(QString)));
+
+    QStringList settingsFiles;
+    settingsFiles << QSettings(QSettings::UserScope, OrganizationNameString, ApplicationNameString).fileName();
+    settingsFiles << QSettings(QSettings::SystemScope, OrganizationNameString, ApplicationNameString).fileName();
+
+    foreach (const QString &fileName, settingsFiles)
+    {
+        // Al registre de Windows no hi ha cap fitxer a vigilar
+        if (QFileInfo(fileName).exists())
+        {
+            m_fileSystemWatcher->addPath(fileName);
+        }
+    }
+}
+
+void SettingsCache::settingsFileChanged(const QString &fileName)
+{
+    DEBUG_LOG("S'ha modificat el fitxer de settings " + fileName + ". Es buida la cache de settings.");
+    clear();
+
+    // QSettings reescriu el fitxer sencer i en alguns sistemes el watcher deixa de vigilar-lo, per això el tornem a afegir
+    if (!m_fileSystemWatcher->files().contains(fileName) && QFileInfo(fileName).exists())
+    {
+        m_fileSystemWatcher->addPath(fileName);
+    }
+}
+
+} // End namespace udg
@@ -0,0 +1,90 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+#ifndef UDGSETTINGSCACHE_H
+#define UDGSETTINGSCACHE_H
+
+#include "singleton.h"
+
+#include <QObject>
+#include <QHash>
+#include <QVariant>
+#include <QReadWriteLock>
+
+class QFileSystemWatcher;
+
+namespace udg {
+
+/**
+    Cache en memòria dels valors de settings llegits per Settings::getValue().
+    Evita haver de crear els objectes QSettings i tornar a llegir el fitxer cada cop que es consulta un setting des d'un camí calent.
+    Settings invalida les claus que s'escriuen o s'eliminen i, un cop s'ha cridat startWatchingSettingsFiles(), la cache es buida
+    quan algú altre modifica els fitxers de settings. Es pot fer servir des de diferents threads.
+    A Windows QSettings guarda els valors al registre i no hi ha cap fitxer a vigilar, per tant els canvis fets per un altre procés
+    no es veuran fins que es reiniciï l'aplicació. Els canvis fets per aquest mateix procés sí que invaliden la cache a totes les plataformes.
+  */
+class SettingsCache : public QObject, public Singleton<SettingsCache> {
+Q_OBJECT
+public:
+    /// Si la clau és a la cache, n'assigna el valor a value i retorna cert. Altrament retorna fals.
+    bool getValue(const QString &key, QVariant &value) const;
+
+    /// Retorna la generació actual de la cache. Cada invalidació la incrementa.
+    quint64 getGeneration() const;
+
+    /// Guarda el valor de la clau sempre que la cache no s'hagi invalidat des de la generació indicada.
+    /// Així no es guarda un valor llegit abans d'una escriptura concurrent.
+    void insert(const QString &key, const QVariant &value, quint64 generation);
+
+    /// Elimina la clau i totes les seves sub-claus de la cache. Si la clau és buida, buida tota la cache.
+    void invalidate(const QString &key);
+
+    /// Buida tota la cache
+    void clear();
+
+    /// Comença a vigilar els fitxers de settings d'usuari i de sistema per buidar la cache quan canviïn.
+    /// A Windows no té cap efecte perquè els settings són al registre.
+    /// S'ha de cridar des del thread principal, un cop creada l'aplicació.
+    void startWatchingSettingsFiles();
+
+signals:
+    /// S'emet quan s'invalida la clau indicada. Si la clau és buida s'ha invalidat tota la cache.
+    void changed(const QString &key);
+
+protected:
+    friend class Singleton<SettingsCache>;
+    SettingsCache();
+    ~SettingsCache();
+
+private slots:
+    /// Buida la cache quan es modifica un dels fitxers de settings
+    void settingsFileChanged(const QString &fileName);
+
+private:
+    /// Valors guardats per clau
+    QHash<QString, QVariant> m_values;
+
+    /// Generació actual de la cache
+    quint64 m_generation;
+
+    /// Protegeix l'accés a m_values i m_generation
+    mutable QReadWriteLock m_lock;
+
+    /// Vigila els fitxers de settings
+    QFileSystemWatcher *m_fileSystemWatcher;
+};
+
+} // End namespace udg
+
+#endif
@@ -81,7 +81,8 @@ protected:
     serien problemes en l'ordre de destrucció d'objectes estàtics (com el cas de la DcmDatasetCache per culpa de dcmtk).
     El problema que té aquesta implementació és que el la classe T ha de ser una classe de Qt i derivi de QObject.
     El singleton es destruirà quan l'aplicació principal es destrueixi, és a dir, quan el signal QCoreApplication::aboutToQuit sigui
-    llançat.
+    llançat. Si la primera crida a instance() es fa des d'un thread secundari, l'objecte es mou al thread principal perquè el
+    deleteLater() s'executi encara que aquell thread no tingui event loop o ja hagi acabat.
     Aquesta implementació sí que és thread-safe.
 */
 template<typename T>
@@ -96,8 +97,13 @@ public:
             // Fem double checking per evitar bloquejos innecessaris
             if (m_theSinglePointer == NULL)
             {
-                m_theSinglePointer = new T();
-                m_theSinglePointer->connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), SLOT(deleteLater()));
+                T *singlePointer = new T();
+                if (singlePointer->thread() != QCoreApplication::instance()->thread())
+                {
+                    singlePointer->moveToThread(QCoreApplication::instance()->thread());
+                }
+                singlePointer->connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), SLOT(deleteLater()));
+                m_theSinglePointer = singlePointer;
             }
         }
         return m_theSinglePointer;
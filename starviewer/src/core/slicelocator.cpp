@@ -16,6 +16,7 @@
 
 #include "imageplane.h"
 #include "mathtools.h"
+#include "sliceprojectionindex.h"
 #include "volume.h"
 
 namespace udg {
@@ -52,6 +53,32 @@ int SliceLocator::getNearestSlice(double point[3])
     
     double nearestSliceDistance = MathTools::DoubleMaximumValue;
     int nearestSlice = -1;
+
+    // When all the slices are parallel the nearest one is found with a binary search on the sorted slice positions
+    QSharedPointer<SliceProjectionIndex> sliceProjectionIndex = m_volume->getSliceProjectionIndex(m_volumePlane);
+    if (sliceProjectionIndex->isValid())
+    {
+        nearestSlice = sliceProjectionIndex->getNearestSlice(Vector3(point), nearestSliceDistance);
+    }
+    else
+    {
+        nearestSlice = getNearestSliceCheckingAllSlices(point, nearestSliceDistance);
+    }
+
+    if (isWithinProximityBounds(nearestSliceDistance))
+    {
+        return nearestSlice;
+    }
+    else
+    {
+        return -1;
+    }
+}
+
+int SliceLocator::getNearestSliceCheckingAllSlices(double point[3], double &nearestSliceDistance)
+{
+    nearestSliceDistance = MathTools::DoubleMaximumValue;
+    int nearestSlice = -1;
     
     for (int i = 0; i <= m_volume->getMaximumSlice(m_volumePlane); ++i)
     {
@@ -69,14 +96,7 @@ int SliceLocator::getNearestSlice(double point[3])
         }
     }
 
-    if (isWithinProximityBounds(nearestSliceDistance))
-    {
-        return nearestSlice;
-    }
-    else
-    {
-        return -1;
-    }
+    return nearestSlice;
 }
 
 int SliceLocator::getNearestSlice(ImagePlane *imagePlane)
@@ -43,6 +43,10 @@ public:
     int getNearestSlice(ImagePlane *imagePlane);
 
 private:
+    /// Returns the nearest slice to the given point computing the distance to every slice, and sets its distance in nearestSliceDistance.
+    /// Used when the slices are not parallel and the volume's SliceProjectionIndex can't be used.
+    int getNearestSliceCheckingAllSlices(double point[3], double &nearestSliceDistance);
+
     /// Returns true if the given slice distance could be considered to be within a certain proximity
     /// regarding the slice spacing values of the current volume, false otherwise
     bool isWithinProximityBounds(double distanceToSlice);
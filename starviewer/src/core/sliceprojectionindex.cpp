@@ -0,0 +1,146 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#include "sliceprojectionindex.h"
+
+#include "imageplane.h"
+#include "mathtools.h"
+#include "volume.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace udg {
+
+namespace {
+
+/// Maximum difference between the normals of two slices to consider them parallel
+const double ParallelNormalsTolerance = 1e-5;
+
+}
+
+SliceProjectionIndex::SliceProjectionIndex(Volume *volume, const OrthogonalPlane &plane)
+ : m_valid(true)
+{
+    Q_ASSERT(volume);
+
+    volume->getOrigin(m_origin);
+    volume->getSpacing(m_spacing);
+    volume->getDimensions(m_dimensions);
+
+    int maximumSlice = volume->getMaximumSlice(plane);
+    m_sliceProjections.reserve(maximumSlice + 1);
+
+    for (int i = 0; i <= maximumSlice && m_valid; ++i)
+    {
+        ImagePlane *imagePlane = volume->getImagePlane(i, plane);
+        if (imagePlane)
+        {
+            Vector3 normal(imagePlane->getImageOrientation().getNormalVector());
+            if (m_sliceProjections.isEmpty())
+            {
+                m_normal = normal;
+            }
+            else if ((normal - m_normal).length() > ParallelNormalsTolerance)
+            {
+                m_valid = false;
+            }
+
+            m_sliceProjections.append(qMakePair(m_normal * imagePlane->getOrigin(), i));
+            delete imagePlane;
+        }
+    }
+
+    if (m_valid)
+    {
+        std::sort(m_sliceProjections.begin(), m_sliceProjections.end());
+    }
+    else
+    {
+        m_sliceProjections.clear();
+    }
+}
+
+SliceProjectionIndex::~SliceProjectionIndex()
+{
+}
+
+bool SliceProjectionIndex::isValid() const
+{
+    return m_valid;
+}
+
+bool SliceProjectionIndex::hasSameGeometryAs(Volume *volume) const
+{
+    double origin[3];
+    double spacing[3];
+    int dimensions[3];
+    volume->getOrigin(origin);
+    volume->getSpacing(spacing);
+    volume->getDimensions(dimensions);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (origin[i] != m_origin[i] || spacing[i] != m_spacing[i] || dimensions[i] != m_dimensions[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int SliceProjectionIndex::getNearestSlice(const Vector3 &point, double &distance) const
+{
+    distance = MathTools::DoubleMaximumValue;
+    if (!m_valid || m_sliceProjections.isEmpty())
+    {
+        return -1;
+    }
+
+    double pointProjection = m_normal * point;
+    int lowestSlice = std::numeric_limits<int>::min();
+
+    // First slice at or after the point: it's the lowest slice among those with the same projection
+    QVector<QPair<double, int> >::const_iterator after = std::lower_bound(m_sliceProjections.constBegin(), m_sliceProjections.constEnd(),
+                                                                           qMakePair(pointProjection, lowestSlice));
+
+    int nearestSlice = -1;
+
+    if (after != m_sliceProjections.constEnd())
+    {
+        nearestSlice = after->second;
+        distance = after->first - pointProjection;
+    }
+
+    if (after != m_sliceProjections.constBegin())
+    {
+        // Last slice before the point. Go back to the lowest slice with the same projection.
+        double beforeProjection = (after - 1)->first;
+        QVector<QPair<double, int> >::const_iterator before = std::lower_bound(m_sliceProjections.constBegin(), after,
+                                                                                qMakePair(beforeProjection, lowestSlice));
+        double beforeDistance = pointProjection - before->first;
+
+        if (beforeDistance < distance || (beforeDistance == distance && before->second < nearestSlice))
+        {
+            nearestSlice = before->second;
+            distance = beforeDistance;
+        }
+    }
+
+    return nearestSlice;
+}
+
+} // End namespace udg
@@ -0,0 +1,71 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#ifndef UDGSLICEPROJECTIONINDEX_H
+#define UDGSLICEPROJECTIONINDEX_H
+
+#include "orthogonalplane.h"
+#include "vector3.h"
+
+#include <QPair>
+#include <QVector>
+
+namespace udg {
+
+class Volume;
+
+/**
+    Index of the slices of a Volume on an orthogonal plane sorted by their position along the plane normal.
+
+    When all the slices are parallel the distance from a point to a slice is the difference between the projections of the point and the slice
+    origin on the common normal, so the nearest slice can be found with a binary search instead of checking every slice.
+    If the slices are not parallel the index is not valid and the caller must check the slices one by one.
+ */
+class SliceProjectionIndex {
+public:
+    /// Builds the index for the slices of the given volume on the given plane
+    SliceProjectionIndex(Volume *volume, const OrthogonalPlane &plane);
+    ~SliceProjectionIndex();
+
+    /// Returns true if all the slices are parallel and the index can be used
+    bool isValid() const;
+
+    /// Returns true if the origin, spacing and dimensions of the given volume are the ones the index was built from.
+    /// The geometry can change without the volume noticing, e.g. when the spacing or origin of its pixel data are modified directly.
+    bool hasSameGeometryAs(Volume *volume) const;
+
+    /// Returns the slice nearest to the given point and sets its distance in the given parameter. When several slices are at the same distance
+    /// the lowest slice is returned. Returns -1 and the maximum double value as distance if the index is not valid or empty.
+    int getNearestSlice(const Vector3 &point, double &distance) const;
+
+private:
+    /// Normal common to all the slices
+    Vector3 m_normal;
+
+    /// Projection of the origin of each slice on the normal together with the slice number, sorted by projection and slice
+    QVector<QPair<double, int> > m_sliceProjections;
+
+    /// True if all the slices are parallel
+    bool m_valid;
+
+    /// Geometry of the volume when the index was built
+    double m_origin[3];
+    double m_spacing[3];
+    int m_dimensions[3];
+};
+
+} // End namespace udg
+
+#endif
@@ -33,7 +33,7 @@ const QString StarviewerBuildPlatform("Linux");
 #endif
 
 // Indica per aquesta versió d'starviewer quina és la revisió de bd necessària
-const int StarviewerDatabaseRevisionRequired(9593);
+const int StarviewerDatabaseRevisionRequired(9594);
 
 const QString OrganizationNameString("GILab");
 const QString OrganizationDomainString("starviewer.udg.edu");
@@ -12,37 +12,58 @@
   terms contained in the LICENSE file.
  *************************************************************************************/
 
-#include "qdeleteoldstudiesthread.h"
 
-#include "logging.h"
+#include "stringinterner.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
 
 namespace udg {
 
-QDeleteOldStudiesThread::QDeleteOldStudiesThread(QObject *parent)
- : QThread(parent)
-{
-    m_lastError = LocalDatabaseManager::Ok;
+const int StringInterner::MaximumSize = 65536;
+
+namespace {
+
+QMutex mutex;
+QSet<QString> strings;
+
 }
 
-void QDeleteOldStudiesThread::deleteOldStudies()
+QString StringInterner::intern(const QString &string)
 {
-    start();
+    if (string.isEmpty())
+    {
+        return string;
+    }
+
+    QMutexLocker locker(&mutex);
+
+    QSet<QString>::const_iterator iterator = strings.constFind(string);
+    if (iterator != strings.constEnd())
+    {
+        return *iterator;
+    }
+
+    if (strings.size() >= MaximumSize)
+    {
+        strings.clear();
+    }
+
+    strings.insert(string);
+    return string;
 }
 
-LocalDatabaseManager::LastError QDeleteOldStudiesThread::getLastError()
+int StringInterner::getSize()
 {
-    return m_lastError;
+    QMutexLocker locker(&mutex);
+    return strings.size();
 }
 
-void QDeleteOldStudiesThread::run()
+void StringInterner::clear()
 {
-    LocalDatabaseManager localDatabaseManager;
-
-    localDatabaseManager.deleteOldStudies();
-
-    m_lastError = localDatabaseManager.getLastError();
-
-    emit finished();
+    QMutexLocker locker(&mutex);
+    strings.clear();
 }
 
 }
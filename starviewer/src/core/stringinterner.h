@@ -0,0 +1,48 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#ifndef UDGSTRINGINTERNER_H
+#define UDGSTRINGINTERNER_H
+
+#include <QString>
+
+namespace udg {
+
+/**
+    Manté un conjunt global de cadenes perquè els valors que es repeteixen en moltes instàncies (transfer syntax, image type, view position, etc.)
+    només s'emmagatzemin un cop a memòria. Les cadenes retornades per intern() comparteixen les dades gràcies a l'implicit sharing de QString.
+    Es pot fer servir des de diferents threads alhora.
+
+    No s'hi han de posar valors que siguin únics per cada instància (UIDs, paths complets, etc.) perquè només farien créixer el conjunt.
+  */
+class StringInterner {
+public:
+    /// Retorna una cadena igual a la donada que comparteix les dades amb totes les cadenes iguals retornades anteriorment
+    static QString intern(const QString &string);
+
+    /// Retorna el nombre de cadenes diferents que hi ha al conjunt
+    static int getSize();
+
+    /// Buida el conjunt. Les cadenes retornades fins ara continuen sent vàlides, però les noves ja no compartiran dades amb elles.
+    static void clear();
+
+private:
+    /// Nombre màxim de cadenes del conjunt. Quan s'arriba a aquest nombre es buida el conjunt per evitar que creixi indefinidament.
+    static const int MaximumSize;
+};
+
+}
+
+#endif
@@ -57,6 +57,7 @@
 #include <vtkImageData.h>
 
 #include "logging.h"
+#include "floodfill.h"
 
 namespace udg {
 
@@ -193,7 +194,17 @@ double StrokeSegmentationMethod::applyMethodVTK()
     index[2] = (int)(((double)m_pz - origin[2]) / spacing[2]);
     DEBUG_LOG(QString("Tractant llesca %1").arg(index[2]));
 
-    applyMethodVTKRecursive(imMask, index[0], index[1], index[2], 0);
+    int extent[6];
+    imMask->GetExtent(extent);
+    void *scalarPointer = imMask->GetScalarPointer(extent[0], extent[2], extent[4]);
+    switch (imMask->GetScalarType())
+    {
+        vtkTemplateMacro(m_cont = FloodFill::replaceValue(static_cast<VTK_TT*>(scalarPointer), extent, index[0], index[1], index[2],
+                                                          static_cast<VTK_TT>(m_insideMaskValue - 100), static_cast<VTK_TT>(m_insideMaskValue)));
+
+        default:
+            ERROR_LOG("Unknown scalar type");
+    }
 
     DEBUG_LOG(QString("Tractant llesca %1").arg(index[2]));
 
@@ -203,26 +214,6 @@ double StrokeSegmentationMethod::applyMethodVTK()
     return m_cont * spacing[0] * spacing[1] * spacing[2];
 }
 
-void StrokeSegmentationMethod::applyMethodVTKRecursive(vtkImageData* imMask, int a, int b, int c, int prof)
-{
-    if ((a >= m_Volume->getExtent()[0]) && (a <= m_Volume->getExtent()[1]) && (b >= m_Volume->getExtent()[2]) && (b <=
-        m_Volume->getExtent()[3]) && (c >= m_Volume->getExtent()[4]) && (c <= m_Volume->getExtent()[5]))
-    {
-        double maskValue = imMask->GetScalarComponentAsDouble(a, b, c, 0);
-        if (maskValue == m_insideMaskValue - 100)
-        {
-            imMask->SetScalarComponentFromDouble(a, b, c, 0, m_insideMaskValue);
-            m_cont++;
-            applyMethodVTKRecursive(imMask, a, b, c + 1, prof + 1);
-            applyMethodVTKRecursive(imMask, a, b, c - 1, prof + 1);
-            applyMethodVTKRecursive(imMask, a + 1, b, c, prof + 1);
-            applyMethodVTKRecursive(imMask, a - 1, b, c, prof + 1);
-            applyMethodVTKRecursive(imMask, a, b + 1, c, prof + 1);
-            applyMethodVTKRecursive(imMask, a, b - 1, c, prof + 1);
-        }
-    }
-}
-
 double StrokeSegmentationMethod::applyCleanSkullMethod()
 {
     DEBUG_LOG("Clean Skull!!");
@@ -233,7 +233,10 @@ void SyncActionManager::applySyncAction(SyncAction *syncAction)
         {
             if (isSyncActionApplicable(syncAction, viewer))
             {
+                // All the renders caused by the action are coalesced into a single one done in the next iteration of the event loop
+                viewer->beginRenderCoalescing();
                 syncAction->run(viewer);
+                viewer->endRenderCoalescing();
 
                 if (m_synchronizingAll)
                 {
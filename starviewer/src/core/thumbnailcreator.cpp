@@ -17,7 +17,6 @@
 #include <QObject>
 #include <QImage>
 #include <QIcon>
-#include <QPixmap>
 #include <QString>
 #include <QPainter>
 
@@ -36,11 +35,32 @@ namespace udg {
 
 const QString PreviewNotAvailableText(QObject::tr("Preview image not available"));
 
+const Image* ThumbnailCreator::getRepresentativeImage(const Series *series)
+{
+    if (series->getModality() == "KO" || series->getModality() == "PR" || series->getModality() == "SR")
+    {
+        return NULL;
+    }
+
+    QList<Image*> images = series->getImages();
+    if (images.isEmpty())
+    {
+        return NULL;
+    }
+
+    return images.at(images.size() / 2);
+}
+
 QImage ThumbnailCreator::getThumbnail(const Series *series, int resolution)
 {
     QImage thumbnail;
+    const Image *representativeImage = getRepresentativeImage(series);
 
-    if (series->getModality() == "KO")
+    if (representativeImage)
+    {
+        thumbnail = createImageThumbnail(representativeImage->getPath(), resolution);
+    }
+    else if (series->getModality() == "KO")
     {
         thumbnail = createIconThumbnail(":/images/icons/mime-ko.svg", resolution);
     }
@@ -54,18 +74,10 @@ QImage ThumbnailCreator::getThumbnail(const Series *series, int resolution)
     }
     else
     {
-        int numberOfImages = series->getImages().size();
-        if (numberOfImages > 0)
-        {
-            thumbnail = createImageThumbnail(series->getImages()[numberOfImages / 2]->getPath(), resolution);
-        }
-        else
-        {
-            thumbnail = createIconThumbnail(":/images/icons/mime-unknown.svg", resolution);
+        thumbnail = createIconThumbnail(":/images/icons/mime-unknown.svg", resolution);
 
-            // Si la sèrie no conté imatges en el thumbnail ho indicarem
-            //thumbnail = makeEmptyThumbnailWithCustomText(QObject::tr("No Images Available"));
-        }
+        // Si la sèrie no conté imatges en el thumbnail ho indicarem
+        //thumbnail = makeEmptyThumbnailWithCustomText(QObject::tr("No Images Available"));
     }
 
     return thumbnail;
@@ -179,8 +191,8 @@ QImage ThumbnailCreator::createThumbnail(DicomImage *dicomImage, int resolution)
         }
         else if (scaledImage->getStatus() == EIS_Normal)
         {
-            QPixmap pixmap = convertToQPixmap(scaledImage);
-            if (pixmap.isNull())
+            QImage image = convertToQImage(scaledImage);
+            if (image.isNull())
             {
                 DEBUG_LOG("No s'ha pogut convertir la DicomImage a QImage. Es crea un thumbnail de Preview not available.");
                 ok = false;
@@ -188,25 +200,25 @@ QImage ThumbnailCreator::createThumbnail(DicomImage *dicomImage, int resolution)
             else
             {
                 // The smallest side will be of "resolution" size.
-                pixmap = pixmap.scaled(resolution,resolution, Qt::AspectRatioMode::KeepAspectRatioByExpanding, Qt::TransformationMode::SmoothTransformation);
+                image = image.scaled(resolution, resolution, Qt::AspectRatioMode::KeepAspectRatioByExpanding, Qt::TransformationMode::SmoothTransformation);
 
                 // By cropping the longer side, a squared image is made.
-                int width = pixmap.width();
-                int height = pixmap.height();
+                int width = image.width();
+                int height = image.height();
                 if (width > height) // heigth == resolution
                 {
-                    pixmap = pixmap.copy((width-resolution) / 2, 0, height, height);
+                    image = image.copy((width-resolution) / 2, 0, height, height);
                 }
                 else if (height > width) // width == resolution
                 {
-                    pixmap = pixmap.copy(0, (height-resolution) / 2, width, width);
+                    image = image.copy(0, (height-resolution) / 2, width, width);
                 }
                 else
                 {
                     // A perfect square, nothing to do
                 }
 
-                thumbnail = pixmap.toImage();
+                thumbnail = image;
                 ok = true;
             }
 
@@ -251,7 +263,7 @@ bool ThumbnailCreator::isSuitableForThumbnailCreation(const DICOMTagReader *read
     return true;
 }
 
-QPixmap ThumbnailCreator::convertToQPixmap(DicomImage *dicomImage)
+QImage ThumbnailCreator::convertToQImage(DicomImage *dicomImage)
 {
     Q_ASSERT(dicomImage);
 
@@ -279,8 +291,8 @@ QPixmap ThumbnailCreator::convertToQPixmap(DicomImage *dicomImage)
     const int height = (int)(dicomImage->getHeight());
     imageHeader += QString("\n%1 %2\n255\n").arg(width).arg(height);
 
-    // QPixmap en la que carregarem el buffer de dades
-    QPixmap thumbnail;
+    // QImage en la que carregarem el buffer de dades
+    QImage thumbnail;
     // Create output buffer for DicomImage class
     const int offset = imageHeader.size();
     const unsigned int length = (width * height) * bytesPerComponent + offset;
@@ -16,7 +16,6 @@
 #define UDGTHUMBNAILCREATOR_H
 
 class QImage;
-class QPixmap;
 class QString;
 class DicomImage;
 
@@ -26,8 +25,15 @@ class Series;
 class Image;
 class DICOMTagReader;
 
+/**
+    Crea els thumbnails de sèries i imatges. Només fa servir QImage, per tant es pot fer servir des de threads que no siguin el de la GUI,
+    excepte pels thumbnails de sèries que es fan a partir d'una icona (KO, PR, SR...), que necessiten QIcon.
+  */
 class ThumbnailCreator {
 public:
+    /// Retorna la imatge a partir de la qual es crea el thumbnail de la sèrie, o nul si el thumbnail de la sèrie és una icona
+    static const Image* getRepresentativeImage(const Series *series);
+
     /// Crea un thumbnail a partir de les imatges de la sèrie
     QImage getThumbnail(const Series *series, int resolution = 96);
 
@@ -57,8 +63,8 @@ private:
     /// Retorna true si és un dataset vàlid, false altrament
     bool isSuitableForThumbnailCreation(const DICOMTagReader *reader) const;
 
-    /// Converteix la DicomImage a una QPixmap
-    QPixmap convertToQPixmap(DicomImage *dicomImage);
+    /// Converteix la DicomImage a una QImage
+    QImage convertToQImage(DicomImage *dicomImage);
 };
 
 }
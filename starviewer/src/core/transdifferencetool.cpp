@@ -152,7 +152,7 @@ void TransDifferenceTool::doTransDifference()
     this->increaseSingleDifferenceImage(m_dx, m_dy);
 
     // Necessari perquè es torni a renderitzar a alta resolució en el 3D
-    m_viewer->render();
+    m_viewer->requestRender();
 }
 
 void TransDifferenceTool::endTransDifference()
@@ -163,7 +163,7 @@ void TransDifferenceTool::endTransDifference()
     m_myData->increaseSliceTranslationX(m_2DViewer->getCurrentSlice(), m_dx);
     m_myData->increaseSliceTranslationY(m_2DViewer->getCurrentSlice(), m_dy);
     // Necessari perquè es torni a renderitzar a alta resolució en el 3D
-    m_viewer->render();
+    m_viewer->requestRender();
 }
 
 void TransDifferenceTool::initializeDifferenceImage()
@@ -221,7 +221,7 @@ void TransDifferenceTool::initializeDifferenceImage()
     m_2DViewer->setInput(differenceVolume);
     m_2DViewer->setVoiLut(WindowLevel(2 * max, 0.0));
 
-    m_2DViewer->render();
+    m_2DViewer->requestRender();
 }
 
 void TransDifferenceTool::increaseSingleDifferenceImage(int dx, int dy)
@@ -93,7 +93,7 @@ void TranslateTool::endTranslate()
     m_viewer->unsetCursor();
     m_state = None;
     m_viewer->getInteractor()->GetRenderWindow()->SetDesiredUpdateRate(m_viewer->getInteractor()->GetStillUpdateRate());
-    m_viewer->render();
+    m_viewer->requestRender();
 }
 
 }
@@ -0,0 +1,295 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#include "viewerbatchcapturer.h"
+
+#include "apngwriter.h"
+#include "boundedfuturequeue.h"
+#include "logging.h"
+#include "q2dviewer.h"
+#include "volumebuilderfromcaptures.h"
+
+#include <QFuture>
+#include <QImage>
+#include <QThread>
+#include <QtConcurrentRun>
+
+#include <vtkImageData.h>
+#include <vtkImageWriter.h>
+#include <vtkRenderWindow.h>
+#include <vtkWindowToImageFilter.h>
+
+namespace udg {
+
+const int ViewerBatchCapturer::CurrentValue = -1;
+
+namespace {
+
+// Escriu la imatge donada al fitxer donat. Es crida des dels threads del QThreadPool, per tant cada crida crea el seu propi writer.
+bool writeImage(vtkSmartPointer<vtkImageData> image, QString fileName, QViewer::FileType fileType)
+{
+    QString fileExtension;
+    vtkImageWriter *writer = QViewer::createImageWriter(fileType, fileExtension);
+    if (!writer)
+    {
+        return false;
+    }
+
+    writer->SetInputData(image);
+    writer->SetFileName(qPrintable(fileName));
+    writer->Write();
+    bool ok = writer->GetErrorCode() == 0;
+    writer->Delete();
+
+    if (!ok)
+    {
+        ERROR_LOG("No s'ha pogut escriure la captura al fitxer " + fileName);
+    }
+
+    return ok;
+}
+
+// Converteix una captura RGB o RGBA de la finestra a QImage. Les files de la captura van de baix a dalt.
+QImage toQImage(vtkImageData *image)
+{
+    int *dimensions = image->GetDimensions();
+    int numberOfComponents = image->GetNumberOfScalarComponents();
+    if (image->GetScalarType() != VTK_UNSIGNED_CHAR || (numberOfComponents != 3 && numberOfComponents != 4))
+    {
+        return QImage();
+    }
+
+    QImage qImage(dimensions[0], dimensions[1], numberOfComponents == 3 ? QImage::Format_RGB888 : QImage::Format_RGBA8888);
+    const uchar *source = static_cast<const uchar*>(image->GetScalarPointer());
+    int rowSize = dimensions[0] * numberOfComponents;
+    for (int y = 0; y < dimensions[1]; y++)
+    {
+        memcpy(qImage.scanLine(dimensions[1] - 1 - y), source + y * rowSize, rowSize);
+    }
+
+    return qImage;
+}
+
+}
+
+ViewerBatchCapturer::ViewerBatchCapturer(QViewer *viewer, QObject *parent)
+ : QObject(parent), m_viewer(viewer), m_previousSlice(0), m_previousPhase(0)
+{
+    Q_ASSERT(m_viewer);
+
+    m_windowToImageFilter = vtkWindowToImageFilter::New();
+    m_windowToImageFilter->SetInput(m_viewer->getRenderWindow());
+    m_windowToImageFilter->ReadFrontBufferOff();
+    m_windowToImageFilter->ShouldRerenderOn();
+}
+
+ViewerBatchCapturer::~ViewerBatchCapturer()
+{
+    m_windowToImageFilter->Delete();
+}
+
+void ViewerBatchCapturer::addCurrentView()
+{
+    m_captures << qMakePair(CurrentValue, CurrentValue);
+}
+
+void ViewerBatchCapturer::addSliceAndPhase(int slice, int phase)
+{
+    m_captures << qMakePair(slice, phase);
+}
+
+void ViewerBatchCapturer::addAllSlicesAndPhases()
+{
+    Q2DViewer *viewer2D = Q2DViewer::castFromQViewer(m_viewer);
+    if (!viewer2D)
+    {
+        addCurrentView();
+        return;
+    }
+
+    int numberOfSlices = viewer2D->getMaximumSlice() + 1;
+    int numberOfPhases = viewer2D->getNumberOfPhases();
+    for (int slice = 0; slice < numberOfSlices; slice++)
+    {
+        for (int phase = 0; phase < numberOfPhases; phase++)
+        {
+            addSliceAndPhase(slice, phase);
+        }
+    }
+}
+
+void ViewerBatchCapturer::addAllSlicesOfCurrentPhase()
+{
+    Q2DViewer *viewer2D = Q2DViewer::castFromQViewer(m_viewer);
+    if (!viewer2D)
+    {
+        return;
+    }
+
+    int numberOfSlices = viewer2D->getMaximumSlice() + 1;
+    for (int slice = 0; slice < numberOfSlices; slice++)
+    {
+        addSliceAndPhase(slice, CurrentValue);
+    }
+}
+
+void ViewerBatchCapturer::addAllPhasesOfCurrentSlice()
+{
+    Q2DViewer *viewer2D = Q2DViewer::castFromQViewer(m_viewer);
+    if (!viewer2D)
+    {
+        return;
+    }
+
+    int numberOfPhases = viewer2D->getNumberOfPhases();
+    for (int phase = 0; phase < numberOfPhases; phase++)
+    {
+        addSliceAndPhase(CurrentValue, phase);
+    }
+}
+
+int ViewerBatchCapturer::getNumberOfCaptures() const
+{
+    return m_captures.count();
+}
+
+void ViewerBatchCapturer::captureToVolumeBuilder(VolumeBuilderFromCaptures *builder)
+{
+    Q_ASSERT(builder);
+
+    beginCapture();
+    for (int i = 0; i < m_captures.count(); i++)
+    {
+        builder->addCapture(captureAt(i));
+        emit progress(i + 1);
+    }
+    endCapture();
+}
+
+bool ViewerBatchCapturer::captureToFiles(const QString &baseName, QViewer::FileType fileType)
+{
+    QString fileExtension;
+    vtkImageWriter *writer = QViewer::createImageWriter(fileType, fileExtension);
+    if (!writer)
+    {
+        return false;
+    }
+    writer->Delete();
+
+    int count = m_captures.count();
+    int padding = QString::number(count).size();
+    // Cada escriptura pendent reté la seva captura a memòria. Se'n limita el nombre perquè amb una sèrie llarga no s'acumulin totes les captures:
+    // quan n'hi ha prou de pendents, s'espera que acabi la més antiga abans de fer la següent captura
+    BoundedFutureQueue pendingWrites(qMax(2, QThread::idealThreadCount()));
+
+    beginCapture();
+    for (int i = 0; i < count; i++)
+    {
+        QString fileName;
+        if (count == 1)
+        {
+            fileName = QString("%1.%2").arg(baseName).arg(fileExtension);
+        }
+        else
+        {
+            fileName = QString("%1-%2.%3").arg(baseName).arg(i, padding, 10, QChar('0')).arg(fileExtension);
+        }
+
+        // Mentre s'escriu aquesta captura ja es renderitza la següent
+        pendingWrites.enqueue(QtConcurrent::run(writeImage, captureAt(i), fileName, fileType));
+        emit progress(i + 1);
+    }
+    endCapture();
+
+    return pendingWrites.waitForAll();
+}
+
+bool ViewerBatchCapturer::captureToAnimatedPng(ApngWriter *writer)
+{
+    Q_ASSERT(writer);
+
+    bool ok = true;
+
+    beginCapture();
+    for (int i = 0; i < m_captures.count() && ok; i++)
+    {
+        ok = writer->addFrame(toQImage(captureAt(i)));
+        emit progress(i + 1);
+    }
+    endCapture();
+
+    return ok;
+}
+
+void ViewerBatchCapturer::beginCapture()
+{
+    Q2DViewer *viewer2D = Q2DViewer::castFromQViewer(m_viewer);
+    if (viewer2D)
+    {
+        m_previousSlice = viewer2D->getCurrentSlice();
+        m_previousPhase = viewer2D->getCurrentPhase();
+    }
+
+    // Les captures s'han de fer amb la qualitat completa
+    m_viewer->restoreRenderingQuality();
+    // Els renders que farien els canvis de llesca i fase queden pendents i es fan un sol cop en acabar
+    m_viewer->beginRenderCoalescing();
+    // Es renderitza al back buffer i no s'intercanvien els buffers, perquè les captures no es vegin per pantalla
+    m_viewer->getRenderWindow()->SwapBuffersOff();
+}
+
+void ViewerBatchCapturer::endCapture()
+{
+    m_viewer->getRenderWindow()->SwapBuffersOn();
+    m_viewer->endRenderCoalescing();
+
+    Q2DViewer *viewer2D = Q2DViewer::castFromQViewer(m_viewer);
+    if (viewer2D)
+    {
+        viewer2D->setSlice(m_previousSlice);
+        viewer2D->setPhase(m_previousPhase);
+    }
+
+    m_viewer->render();
+}
+
+vtkSmartPointer<vtkImageData> ViewerBatchCapturer::captureAt(int index)
+{
+    const QPair<int, int> &sliceAndPhase = m_captures.at(index);
+
+    Q2DViewer *viewer2D = Q2DViewer::castFromQViewer(m_viewer);
+    if (viewer2D)
+    {
+        if (sliceAndPhase.first != CurrentValue)
+        {
+            viewer2D->setSlice(sliceAndPhase.first);
+        }
+        if (sliceAndPhase.second != CurrentValue)
+        {
+            viewer2D->setPhase(sliceAndPhase.second);
+        }
+    }
+
+    // El filtre torna a renderitzar la finestra abans de llegir-ne el contingut
+    m_windowToImageFilter->Modified();
+    m_windowToImageFilter->Update();
+
+    vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+    image->ShallowCopy(m_windowToImageFilter->GetOutput());
+
+    return image;
+}
+
+}
@@ -0,0 +1,115 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#ifndef UDGVIEWERBATCHCAPTURER_H
+#define UDGVIEWERBATCHCAPTURER_H
+
+#include <QObject>
+
+#include "qviewer.h"
+
+#include <QList>
+#include <QPair>
+
+#include <vtkSmartPointer.h>
+
+class vtkImageData;
+class vtkWindowToImageFilter;
+
+namespace udg {
+
+class ApngWriter;
+class VolumeBuilderFromCaptures;
+
+/**
+    Captura d'un sol cop moltes vistes d'un visor (per exemple totes les llesques i fases d'un Q2DViewer) sense mostrar-les per pantalla.
+
+    Cada vista es renderitza al back buffer de la finestra del visor i es llegeix d'allà sense intercanviar buffers, de manera que es fa servir
+    tal qual el pipeline del visor (VOI LUT, orientació, anotacions, etc.) però l'usuari no veu passar les llesques.
+    El renderitzat s'ha de fer al thread de la GUI perquè depèn del context OpenGL del visor, però la codificació i escriptura dels fitxers
+    es fa en paral·lel en altres threads mentre es continuen renderitzant les següents vistes.
+    En acabar es restaura la llesca i fase que tenia el visor.
+  */
+class ViewerBatchCapturer : public QObject {
+Q_OBJECT
+public:
+    ViewerBatchCapturer(QViewer *viewer, QObject *parent = 0);
+    ~ViewerBatchCapturer();
+
+    /// Afegeix a la llista de captures la vista actual del visor
+    void addCurrentView();
+
+    /// Afegeix a la llista de captures la llesca i fase donades. El visor ha de ser un Q2DViewer.
+    void addSliceAndPhase(int slice, int phase);
+
+    /// Afegeix a la llista de captures totes les llesques i, per cada llesca, totes les fases. Si el visor no és un Q2DViewer afegeix la vista actual.
+    void addAllSlicesAndPhases();
+
+    /// Afegeix a la llista de captures totes les llesques de la fase actual. El visor ha de ser un Q2DViewer.
+    void addAllSlicesOfCurrentPhase();
+
+    /// Afegeix a la llista de captures totes les fases de la llesca actual. El visor ha de ser un Q2DViewer.
+    void addAllPhasesOfCurrentSlice();
+
+    /// Retorna el nombre de captures que es faran
+    int getNumberOfCaptures() const;
+
+    /// Fa totes les captures i les afegeix al builder donat en el mateix ordre en què s'han afegit, a mesura que es fan
+    void captureToVolumeBuilder(VolumeBuilderFromCaptures *builder);
+
+    /// Fa totes les captures i les desa en fitxers amb el nom base i format donats, amb el mateix criteri de noms que QViewer::saveGrabbedViews().
+    /// Els fitxers s'escriuen en paral·lel a mesura que es fan les captures, amb un nombre limitat d'escriptures pendents perquè les captures
+    /// no s'acumulin a memòria. Retorna cert si s'han pogut escriure tots.
+    bool captureToFiles(const QString &baseName, QViewer::FileType fileType);
+
+    /// Fa totes les captures i les afegeix com a frames al writer donat, que ja ha d'estar obert, a mesura que es fan.
+    /// Retorna cert si s'han pogut afegir tots els frames.
+    bool captureToAnimatedPng(ApngWriter *writer);
+
+signals:
+    /// S'emet cada cop que s'ha fet una captura
+    void progress(int numberOfCaptures);
+
+private:
+    /// Prepara el visor per renderitzar sense mostrar el resultat per pantalla
+    void beginCapture();
+
+    /// Restaura l'estat que tenia el visor abans de beginCapture()
+    void endCapture();
+
+    /// Renderitza i retorna la captura amb l'índex donat
+    vtkSmartPointer<vtkImageData> captureAt(int index);
+
+private:
+    /// Valor de llesca o fase que indica que s'ha de mantenir la que tingui el visor
+    static const int CurrentValue;
+
+    /// Visor del qual es fan les captures
+    QViewer *m_viewer;
+
+    /// Llista de parelles llesca, fase que s'han de capturar
+    QList<QPair<int, int> > m_captures;
+
+    /// Filtre que llegeix el back buffer de la finestra del visor
+    vtkWindowToImageFilter *m_windowToImageFilter;
+
+    /// Llesca i fase del visor abans de començar a capturar
+    int m_previousSlice;
+    int m_previousPhase;
+};
+
+}
+
+#endif
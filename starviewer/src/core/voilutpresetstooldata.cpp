@@ -15,6 +15,7 @@
 #include "voilutpresetstooldata.h"
 
 #include "customwindowlevelsrepository.h"
+#include "customwindowlevelsloader.h"
 
 #include <QStringList>
 
@@ -190,6 +191,9 @@ void VoiLutPresetsToolData::setCurrentPreset(const VoiLut &preset)
 
 void VoiLutPresetsToolData::loadCustomWindowLevelPresets()
 {
+    // Els custom window levels no es carreguen a l'arrencada sinó el primer cop que es necessiten
+    CustomWindowLevelsLoader::loadDefaultsOnce();
+
     foreach (WindowLevel *customWindowLevel, CustomWindowLevelsRepository::getRepository()->getItems())
     {
         addPreset(*customWindowLevel, UserDefined);
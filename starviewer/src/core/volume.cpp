@@ -22,6 +22,7 @@
 #include "mathtools.h"
 #include "volumepixeldataiterator.h"
 #include "imageplane.h"
+#include "sliceprojectionindex.h"
 #include "dicomtagreader.h"
 #include "volumehelper.h"
 
@@ -55,11 +56,13 @@ vtkImageData* Volume::getVtkData()
 void Volume::setData(ItkImageTypePointer itkImage)
 {
     m_volumePixelData->setData(itkImage);
+    invalidateSliceProjectionIndexes();
 }
 
 void Volume::setData(vtkImageData *vtkImage)
 {
     m_volumePixelData->setData(vtkImage);
+    invalidateSliceProjectionIndexes();
 }
 
 void Volume::setPixelData(VolumePixelData *pixelData)
@@ -68,6 +71,7 @@ void Volume::setPixelData(VolumePixelData *pixelData)
     m_volumePixelData = pixelData;
     // Set the number of phases to the new pixel data
     m_volumePixelData->setNumberOfPhases(m_numberOfPhases);
+    invalidateSliceProjectionIndexes();
 }
 
 VolumePixelData* Volume::getPixelData()
@@ -161,6 +165,7 @@ void Volume::setNumberOfPhases(int phases)
     if (phases >= 1)
     {
         m_numberOfPhases = phases;
+        invalidateSliceProjectionIndexes();
 
         // Set the number of phases to the pixel data only if it's already loaded, because we don't want to load it now
         if (isPixelDataLoaded())
@@ -212,6 +217,7 @@ QList<Image*> Volume::getPhaseImages(int index)
 void Volume::setNumberOfSlicesPerPhase(int slicesPerPhase)
 {
     m_numberOfSlicesPerPhase = slicesPerPhase;
+    invalidateSliceProjectionIndexes();
 }
 
 int Volume::getNumberOfSlicesPerPhase() const
@@ -245,6 +251,7 @@ void Volume::addImage(Image *image)
         }
 
         m_checkedImagesAnatomicalPlane = false;
+        invalidateSliceProjectionIndexes();
     }
 }
 
@@ -261,6 +268,7 @@ void Volume::setImages(const QList<Image*> &imageList)
     }
 
     m_checkedImagesAnatomicalPlane = false;
+    invalidateSliceProjectionIndexes();
 }
 
 QList<Image*> Volume::getImages() const
@@ -487,6 +495,12 @@ QString Volume::getPTPixelUnits(const Image *image)
     return m_PTPixelUnits;
 }
 
+void Volume::invalidateSliceProjectionIndexes()
+{
+    QMutexLocker locker(&m_sliceProjectionIndexesMutex);
+    m_sliceProjectionIndexes.clear();
+}
+
 ImagePlane* Volume::getImagePlane(int sliceNumber, const OrthogonalPlane &plane, bool vtkReconstructionHack)
 {
     ImagePlane *imagePlane = 0;
@@ -585,6 +599,23 @@ ImagePlane* Volume::getImagePlane(int sliceNumber, const OrthogonalPlane &plane,
     return imagePlane;
 }
 
+QSharedPointer<SliceProjectionIndex> Volume::getSliceProjectionIndex(const OrthogonalPlane &plane)
+{
+    // The pixel data is loaded before locking because reading it invalidates the indexes
+    getPixelData();
+
+    QMutexLocker locker(&m_sliceProjectionIndexesMutex);
+
+    QSharedPointer<SliceProjectionIndex> index = m_sliceProjectionIndexes.value(plane);
+    if (!index || !index->hasSameGeometryAs(this))
+    {
+        index = QSharedPointer<SliceProjectionIndex>(new SliceProjectionIndex(this, plane));
+        m_sliceProjectionIndexes.insert(plane, index);
+    }
+
+    return index;
+}
+
 void Volume::getSliceRange(int &min, int &max, const OrthogonalPlane &plane)
 {
     if (m_numberOfPhases > 1 && plane == OrthogonalPlane::XYPlane)
@@ -677,6 +708,7 @@ double Volume::getScalarValue(int x, int y, int z)
 void Volume::convertToNeutralVolume()
 {
     m_volumePixelData->convertToNeutralPixelData();
+    invalidateSliceProjectionIndexes();
 
     // Quan creem el volum neutre indiquem que només tenim 1 sola fase
     // TODO Potser s'haurien de crear tantes fases com les que indiqui la sèrie?
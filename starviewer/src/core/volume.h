@@ -22,7 +22,10 @@
 #include "anatomicalplane.h"
 #include "orthogonalplane.h"
 // Qt
+#include <QHash>
+#include <QMutex>
 #include <QPixmap>
+#include <QSharedPointer>
 #include <QVector>
 // FWD declarations
 class vtkImageData;
@@ -35,6 +38,7 @@ class Study;
 class Patient;
 class VolumeReader;
 class ImagePlane;
+class SliceProjectionIndex;
 
 /**
     Aquesta classe respresenta un volum de dades. Aquesta serà la classe on es guardaran les dades que voldrem tractar.
@@ -147,6 +151,11 @@ public:
     /// @return The corresponding image plane
     ImagePlane* getImagePlane(int sliceNumber, const OrthogonalPlane &plane, bool vtkReconstructionHack = false);
     
+    /// Returns the index of the slices on the given plane sorted by their position, building it the first time it's requested.
+    /// The index is rebuilt when the images, pixel data or geometry of the volume change. It can be requested and invalidated from different
+    /// threads: the returned pointer keeps the index alive even if the volume drops it in the meantime.
+    QSharedPointer<SliceProjectionIndex> getSliceProjectionIndex(const OrthogonalPlane &plane);
+
     /// Returns the pixel units for this volume. If the units cannot be specified, an empty string will be returned
     QString getPixelUnits();
     
@@ -229,6 +238,9 @@ private:
     /// Lazy loading of the units of the pixels of PT series
     QString getPTPixelUnits(const Image *image);
 
+    /// Deletes the slice projection indexes, which have to be rebuilt after a change in the images or pixel data
+    void invalidateSliceProjectionIndexes();
+
 private:
 
     /// Conjunt d'imatges que composen el volum
@@ -251,6 +263,11 @@ private:
     int m_numberOfPhases;
     int m_numberOfSlicesPerPhase;
 
+    /// Slice projection indexes built so far, by orthogonal plane
+    QHash<int, QSharedPointer<SliceProjectionIndex> > m_sliceProjectionIndexes;
+    /// Protects the access to the slice projection indexes, which are invalidated from the reader thread when the pixel data is set
+    QMutex m_sliceProjectionIndexesMutex;
+
     /// Stores the units of the pixel values of PT series. getPTPixelUnits should always be used to get this value
     QString m_PTPixelUnits;
 };
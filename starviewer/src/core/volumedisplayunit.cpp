@@ -199,6 +199,12 @@ SliceOrientedVolumePixelData VolumeDisplayUnit::getCurrentPixelData()
 void VolumeDisplayUnit::restoreRenderingQuality()
 {
     m_mapper->ResampleToScreenPixelsOn();
+    m_imageSlice->GetProperty()->SetInterpolationTypeToCubic();
+}
+
+void VolumeDisplayUnit::reduceRenderingQuality()
+{
+    m_imageSlice->GetProperty()->SetInterpolationTypeToLinear();
 }
 
 Image* VolumeDisplayUnit::getCurrentDisplayedImage() const
@@ -477,7 +483,12 @@ void VolumeDisplayUnit::setShutterData(vtkImageData *shutterData)
         }
 
         shutterData->SetSpacing(m_volume->getSpacing());
-        m_shutterImageSlice->GetMapper()->SetInputData(shutterData);
+
+        // Avoid updating the pipeline when the mask is already the current one (e.g. when the displayed image has not changed)
+        if (m_shutterImageSlice->GetMapper()->GetInput() != shutterData)
+        {
+            m_shutterImageSlice->GetMapper()->SetInputData(shutterData);
+        }
 
         if (!m_imageStack->HasImage(m_shutterImageSlice))
         {
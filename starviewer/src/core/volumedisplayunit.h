@@ -92,8 +92,10 @@ public:
     /// Gets the current pixel data according to the current state.
     SliceOrientedVolumePixelData getCurrentPixelData();
 
-    /// Restores the standard rendering quality (resample to screen pixels on) of this volume display unit.
+    /// Restores the standard rendering quality (resample to screen pixels on and cubic interpolation) of this volume display unit.
     void restoreRenderingQuality();
+    /// Reduces the rendering quality (linear interpolation) of this volume display unit to render faster while interacting.
+    void reduceRenderingQuality();
     
     /// Returns current displayed image.
     /// If some orthogonal reconstruction different from original acquisition is applied, returns null
@@ -14,12 +14,14 @@
 
 #include "volumefillerstep.h"
 
+#include "asynchronousthumbnailcreator.h"
 #include "image.h"
 #include "patientfillerinput.h"
 #include "series.h"
-#include "thumbnailcreator.h"
+#include "singleton.h"
 
 #include <QFileInfo>
+#include <QStringList>
 
 namespace udg {
 
@@ -115,15 +117,17 @@ void VolumeFillerStep::saveThumbnail(const Image *image)
     int volumeNumber = m_input->getCurrentVolumeNumber();
     QString thumbnailPath = QFileInfo(image->getPath()).absolutePath();
 
-    ThumbnailCreator thumbnailCreator;
-    QImage thumbnail = thumbnailCreator.getThumbnail(image);
-    thumbnail.save(QString("%1/thumbnail%2.png").arg(thumbnailPath).arg(volumeNumber), "PNG");
+    QStringList thumbnailFilePaths;
+    thumbnailFilePaths << QString("%1/thumbnail%2.png").arg(thumbnailPath).arg(volumeNumber);
 
     // Si és el primer thumbnail, també creem el thumbnail ordinari que s'havia fet sempre
     if (volumeNumber == 1)
     {
-        thumbnail.save(QString("%1/thumbnail.png").arg(thumbnailPath), "PNG");
+        thumbnailFilePaths << QString("%1/thumbnail.png").arg(thumbnailPath);
     }
+
+    // Els thumbnails es creen en un thread de fons per no alentir l'emplenat
+    SingletonPointer<AsynchronousThumbnailCreator>::instance()->enqueue(image->getPath(), thumbnailFilePaths);
 }
 
 VolumeFillerStep::ImageProperties::ImageProperties(const Image *image)
@@ -44,6 +44,7 @@ private:
     /// multiframe i enhanced ja que actualment és molt costós perquè hem de carregar tot el volum
     /// a memòria i aquí podem aprofitar que el dataset està a memòria evitant la càrrega posterior
     /// Tot i així es pot fer servir en altres casos que es cregui necessari avançar la creació del thumbnail
+    /// El thumbnail es crea i es guarda en segon pla amb AsynchronousThumbnailCreator
     void saveThumbnail(const Image *image);
 
 private:
@@ -18,15 +18,20 @@
 #include "voxel.h"
 #include "mathtools.h"
 
+#include <vtkDataArray.h>
+#include <vtkImageCast.h>
 #include <vtkImageChangeInformation.h>
 #include <vtkImageData.h>
+#include <vtkPointData.h>
 
 #include "logging.h"
 
+#include <limits>
+
 namespace udg {
 
 VolumePixelData::VolumePixelData(QObject *parent) :
-    QObject(parent), m_loaded(false)
+    QObject(parent), m_loaded(false), m_compressedScalarType(VTK_VOID), m_compressedNumberOfComponents(0)
 {
     setNumberOfPhases(1);
     
@@ -38,7 +43,21 @@ VolumePixelData::VolumePixelData(QObject *parent) :
 
 VolumePixelData::ItkImageTypePointer VolumePixelData::getItkData()
 {
-    m_vtkToItkFilter->SetInput(this->getVtkData());
+    vtkImageData *imageData = this->getVtkData();
+
+    if (imageData->GetScalarType() != VTK_SHORT)
+    {
+        // Les dades es guarden amb el seu tipus original; només les convertim al tipus d'ITK quan algú les necessita en aquest format.
+        // No es guarda cap còpia: el filtre VTK->ITK en manté la referència mentre la imatge ITK es faci servir, fins a la següent crida.
+        vtkSmartPointer<vtkImageCast> imageCast = vtkSmartPointer<vtkImageCast>::New();
+        imageCast->SetInputData(imageData);
+        imageCast->SetOutputScalarTypeToShort();
+        imageCast->ClampOverflowOn();
+        imageCast->Update();
+        imageData = imageCast->GetOutput();
+    }
+
+    m_vtkToItkFilter->SetInput(imageData);
     try
     {
         m_vtkToItkFilter->GetImporter()->Update();
@@ -66,6 +85,11 @@ void VolumePixelData::setData(ItkImageTypePointer itkImage)
 
 vtkImageData* VolumePixelData::getVtkData()
 {
+    if (!m_compressedSlices.isEmpty())
+    {
+        decompress();
+    }
+
     return m_imageDataVTK;
 }
 
@@ -81,6 +105,8 @@ void VolumePixelData::setData(vtkImageData *vtkImage)
         m_imageDataVTK->ReleaseData();
     }
     m_imageDataVTK = vtkImage;
+    releaseItkData();
+    m_compressedSlices.clear();
     // Si el punter que ens assignen no és nul considerem que són dades carregades
     m_loaded = vtkImage != 0;
 }
@@ -227,6 +253,8 @@ Voxel VolumePixelData::getVoxelValue(int index[3])
 
 void VolumePixelData::convertToNeutralPixelData()
 {
+    releaseItkData();
+    m_compressedSlices.clear();
     // Creem un objecte vtkImageData "neutre"
     m_imageDataVTK = vtkSmartPointer<vtkImageData>::New();
     // Inicialitzem les dades
@@ -278,7 +306,7 @@ void VolumePixelData::setSpacing(double spacing[3])
 void VolumePixelData::setSpacing(double x, double y, double z)
 {
     vtkImageChangeInformation *changeInformation = vtkImageChangeInformation::New();
-    changeInformation->SetInputData(m_imageDataVTK);
+    changeInformation->SetInputData(this->getVtkData());
     changeInformation->SetOutputSpacing(x, y, z);
     changeInformation->Update();
     this->setData(changeInformation->GetOutput());
@@ -297,16 +325,31 @@ void VolumePixelData::getExtent(int extent[6])
 
 int VolumePixelData::getNumberOfScalarComponents()
 {
+    if (isCompressed())
+    {
+        return m_compressedNumberOfComponents;
+    }
+
     return m_imageDataVTK->GetNumberOfScalarComponents();
 }
 
 int VolumePixelData::getScalarSize()
 {
+    if (isCompressed())
+    {
+        return vtkDataArray::GetDataTypeSize(m_compressedScalarType);
+    }
+
     return m_imageDataVTK->GetScalarSize();
 }  
 
 int VolumePixelData::getScalarType()
 {
+    if (isCompressed())
+    {
+        return m_compressedScalarType;
+    }
+
     return m_imageDataVTK->GetScalarType();
 }
 
@@ -314,4 +357,103 @@ int VolumePixelData::getNumberOfPoints()
 {
     return m_imageDataVTK->GetNumberOfPoints();
 } 
+
+bool VolumePixelData::compress()
+{
+    if (!m_loaded || isCompressed())
+    {
+        return false;
+    }
+
+    // Si algun pipeline o filtre de VTK fa referència a les dades, s'estan fent servir i no es poden comprimir
+    if (m_imageDataVTK->GetReferenceCount() > 1)
+    {
+        return false;
+    }
+
+    vtkDataArray *scalars = m_imageDataVTK->GetPointData()->GetScalars();
+    if (!scalars)
+    {
+        return false;
+    }
+
+    // Les còpies superficials (ShallowCopy) comparteixen l'array d'escalars sense referenciar la imatge. En aquest cas el buffer original
+    // no s'alliberaria i la còpia comprimida s'hi afegiria a sobre
+    if (scalars->GetReferenceCount() > 1)
+    {
+        return false;
+    }
+
+    int dimensions[3];
+    m_imageDataVTK->GetDimensions(dimensions);
+    qint64 sliceSize = static_cast<qint64>(dimensions[0]) * dimensions[1] * scalars->GetNumberOfComponents() * scalars->GetDataTypeSize();
+    qint64 totalSize = sliceSize * dimensions[2];
+    // qCompress treballa amb mides int
+    if (sliceSize <= 0 || sliceSize > std::numeric_limits<int>::max())
+    {
+        return false;
+    }
+
+    const char *sliceData = static_cast<const char*>(scalars->GetVoidPointer(0));
+    QVector<QByteArray> compressedSlices;
+    compressedSlices.reserve(dimensions[2]);
+    qint64 compressedSize = 0;
+
+    for (int z = 0; z < dimensions[2]; z++)
+    {
+        // Fem servir el nivell de compressió més ràpid, ja que les dades es tornaran a descomprimir quan es tornin a fer servir
+        compressedSlices.append(qCompress(reinterpret_cast<const uchar*>(sliceData + z * sliceSize), sliceSize, 1));
+        compressedSize += compressedSlices.last().size();
+
+        // Si no estalviem com a mínim una quarta part, no val la pena
+        if (compressedSize > totalSize * 3 / 4)
+        {
+            return false;
+        }
+    }
+
+    m_compressedScalarType = scalars->GetDataType();
+    m_compressedNumberOfComponents = scalars->GetNumberOfComponents();
+    m_compressedScalarsName = scalars->GetName() ? QByteArray(scalars->GetName()) : QByteArray();
+    m_compressedSlices = compressedSlices;
+    releaseItkData();
+    m_imageDataVTK->GetPointData()->SetScalars(NULL);
+
+    DEBUG_LOG(QString("Pixel data comprimit de %1 a %2 bytes").arg(totalSize).arg(compressedSize));
+
+    return true;
+}
+
+bool VolumePixelData::isCompressed() const
+{
+    return !m_compressedSlices.isEmpty();
+}
+
+void VolumePixelData::decompress()
+{
+    vtkSmartPointer<vtkDataArray> scalars = vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(m_compressedScalarType));
+    scalars->SetNumberOfComponents(m_compressedNumberOfComponents);
+    scalars->SetNumberOfTuples(m_imageDataVTK->GetNumberOfPoints());
+    if (!m_compressedScalarsName.isEmpty())
+    {
+        scalars->SetName(m_compressedScalarsName.constData());
+    }
+
+    char *sliceData = static_cast<char*>(scalars->GetVoidPointer(0));
+    foreach (const QByteArray &compressedSlice, m_compressedSlices)
+    {
+        QByteArray slice = qUncompress(compressedSlice);
+        memcpy(sliceData, slice.constData(), slice.size());
+        sliceData += slice.size();
+    }
+
+    m_compressedSlices.clear();
+    m_imageDataVTK->GetPointData()->SetScalars(scalars);
+}
+
+void VolumePixelData::releaseItkData()
+{
+    m_vtkToItkFilter = VtkToItkFilterType::New();
+}
+
 } // End namespace udg
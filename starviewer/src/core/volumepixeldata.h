@@ -15,6 +15,7 @@
 #ifndef UDGVOLUMEPIXELDATA_H
 #define UDGVOLUMEPIXELDATA_H
 
+#include <QByteArray>
 #include <QObject>
 #include <QVector>
 
@@ -52,6 +53,9 @@ public:
     explicit VolumePixelData(QObject *parent = 0);
 
     /// Assignem/Retornem les dades en format ITK
+    /// Les dades es guarden amb el seu tipus d'escalar original. Només es converteixen a ItkPixelType quan es demanen en format ITK i són d'un
+    /// altre tipus, i en aquest cas els valors fora del rang d'ItkPixelType es saturen. La conversió es fa de nou a cada crida i el resultat és
+    /// una còpia: els canvis que es facin a les dades ITK no arriben a les dades VTK.
     void setData(ItkImageTypePointer itkImage);
     ItkImageTypePointer getItkData();
 
@@ -128,7 +132,22 @@ public:
 
     //  Obté el nombre de punts
     int getNumberOfPoints();
+
+    /// Comprimeix sense pèrdues les dades en memòria, llesca a llesca. Només es fa si cap pipeline de VTK no fa servir les dades i si la compressió
+    /// estalvia memòria. Les dades es descomprimeixen automàticament el primer cop que s'hi torna a accedir. Retorna cert si s'han comprimit.
+    /// Ni la compressió ni la descompressió són thread-safe: s'han de fer des del thread que fa servir el volum.
+    bool compress();
+
+    /// Retorna cert si les dades estan comprimides
+    bool isCompressed() const;
    
+private:
+    /// Restaura les dades a partir de les llesques comprimides
+    void decompress();
+
+    /// Deixa anar les dades que el filtre VTK->ITK té referenciades, entre elles la còpia convertida que hagi creat getItkData()
+    void releaseItkData();
+
 private:
     /// Filtres per importar/exportar
     typedef itk::ImageToVTKImageFilter<ItkImageType> ItkToVtkFilterType;
@@ -146,6 +165,13 @@ private:
     /// Filtres per passar de vtk a itk
     ItkToVtkFilterType::Pointer m_itkToVtkFilter;
     VtkToItkFilterType::Pointer m_vtkToItkFilter;
+
+    /// Llesques de les dades comprimides. És buida si les dades no estan comprimides.
+    QVector<QByteArray> m_compressedSlices;
+    /// Característiques dels escalars comprimits, per poder-los restaurar
+    int m_compressedScalarType;
+    int m_compressedNumberOfComponents;
+    QByteArray m_compressedScalarsName;
 };
 
 }
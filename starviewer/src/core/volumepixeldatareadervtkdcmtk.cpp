@@ -14,10 +14,12 @@
 
 #include "volumepixeldatareadervtkdcmtk.h"
 
+#include "coresettings.h"
 #include "logging.h"
 #include "volumepixeldata.h"
 #include "vtkdcmtkimagereader.h"
 
+#include <QDir>
 #include <QStringList>
 
 #include <vtkEventQtSlotConnect.h>
@@ -25,6 +27,35 @@
 
 namespace udg {
 
+namespace {
+
+// Returns the directory where the memory-mapped files of the out-of-core volumes are created, or an empty string if there is none.
+// The system temporary directory is not used because on many systems it is a tmpfs, which would keep the volume in memory anyway.
+QString getOutOfCoreDirectory()
+{
+    Settings settings;
+    QString directory = settings.getValue(CoreSettings::OutOfCoreVolumeDirectory).toString();
+    if (directory.isEmpty())
+    {
+        QString localDatabaseCachePath = settings.getValue(CoreSettings::LocalDatabaseCachePath).toString();
+        if (localDatabaseCachePath.isEmpty())
+        {
+            return QString();
+        }
+        directory = QDir(localDatabaseCachePath).filePath("outofcore");
+    }
+
+    if (!QDir().mkpath(directory))
+    {
+        WARN_LOG("Couldn't create the out-of-core volume directory " + directory);
+        return QString();
+    }
+
+    return directory;
+}
+
+}
+
 VolumePixelDataReaderVTKDCMTK::VolumePixelDataReaderVTKDCMTK(QObject *parent) :
     VolumePixelDataReader(parent)
 {
@@ -75,6 +106,10 @@ int VolumePixelDataReaderVTKDCMTK::read(const QStringList &filenames)
     // Set frame numbers to the reader (needed for multiframe files)
     m_reader->setFrameNumbers(m_frameNumbers);
 
+    // Volumes bigger than the threshold are kept in a temporary memory-mapped file so that they can be bigger than the physical memory
+    qint64 outOfCoreThreshold = Settings().getValue(CoreSettings::OutOfCoreVolumeThreshold).toLongLong() * 1024 * 1024;
+    m_reader->setOutOfCoreStorage(outOfCoreThreshold > 0 ? getOutOfCoreDirectory() : QString(), outOfCoreThreshold);
+
     try
     {
         m_reader->Update();
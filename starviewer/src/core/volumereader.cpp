@@ -17,8 +17,10 @@
 #include "image.h"
 #include "logging.h"
 #include "postprocessor.h"
+#include "rawpixeldatacache.h"
 #include "starviewerapplication.h"
 #include "volume.h"
+#include "volumepixeldata.h"
 #include "volumepixeldatareader.h"
 #include "volumepixeldatareaderfactory.h"
 
@@ -84,7 +86,19 @@ void VolumeReader::executePixelDataReader(Volume *volume)
         QList<int> frameNumbers = QtConcurrent::blockingMapped(volume->getImages(), getFrameNumber);
         m_volumePixelDataReader->setFrameNumbers(frameNumbers);
 
-        if (m_abortRequested)
+        // Si el volum ja s'havia llegit abans i el seu pixel data descodificat és a la cache, el carreguem d'allà sense llegir els fitxers
+        RawPixelDataCache rawPixelDataCache(fileList, frameNumbers, m_volumePixelDataReader->metaObject()->className());
+        bool useRawPixelDataCache = rawPixelDataCache.isEnabled();
+        VolumePixelData *cachedPixelData = useRawPixelDataCache ? rawPixelDataCache.load() : NULL;
+
+        if (cachedPixelData)
+        {
+            volume->setPixelData(cachedPixelData);
+            runPostprocessors(volume);
+            fixSpacingIssues(volume);
+            emit progress(100);
+        }
+        else if (m_abortRequested)
         {
             m_lastError = VolumePixelDataReader::ReadAborted;
         }
@@ -93,6 +107,12 @@ void VolumeReader::executePixelDataReader(Volume *volume)
             m_lastError = m_volumePixelDataReader->read(fileList);
             if (m_lastError == VolumePixelDataReader::NoError)
             {
+                // Es guarda abans dels postprocessats, que es tornen a aplicar quan es carrega de la cache
+                if (useRawPixelDataCache)
+                {
+                    rawPixelDataCache.save(m_volumePixelDataReader->getVolumePixelData());
+                }
+
                 // Tot ha anat ok, assignem les dades al volum
                 volume->setPixelData(m_volumePixelDataReader->getVolumePixelData());
                 runPostprocessors(volume);
@@ -14,7 +14,9 @@
 
 #include "volumerepository.h"
 #include "volume.h"
+#include "volumepixeldata.h"
 #include "logging.h"
+#include "coresettings.h"
 #include "volumereaderjobfactory.h"
 
 namespace udg {
@@ -30,6 +32,10 @@ Identifier VolumeRepository::addVolume(Volume *model)
     id = this->addItem(model);
     emit itemAdded(id);
     INFO_LOG("S'ha afegit al repositori el volum amb id: " + QString::number(id.getValue()));
+
+    // Quan s'obren volums nous, els que ja no es fan servir deixen d'ocupar tanta memòria
+    compressInactiveVolumes();
+
     return id;
 }
 
@@ -64,4 +70,31 @@ int VolumeRepository::getNumberOfVolumes()
     return this->getNumberOfItems();
 }
 
+int VolumeRepository::compressInactiveVolumes()
+{
+    if (!Settings().getValue(CoreSettings::CompressInactiveVolumes).toBool())
+    {
+        return 0;
+    }
+
+    VolumeReaderJobFactory *volumeReaderJobFactory = VolumeReaderJobFactory::instance();
+    int numberOfCompressedVolumes = 0;
+
+    foreach (Volume *volume, this->getItems())
+    {
+        // Els volums que s'estan carregant els està fent servir un altre thread
+        if (volume->isPixelDataLoaded() && !volumeReaderJobFactory->isVolumeLoading(volume) && volume->getPixelData()->compress())
+        {
+            numberOfCompressedVolumes++;
+        }
+    }
+
+    if (numberOfCompressedVolumes > 0)
+    {
+        INFO_LOG(QString("S'han comprimit en memòria %1 volums inactius").arg(numberOfCompressedVolumes));
+    }
+
+    return numberOfCompressedVolumes;
+}
+
 }
@@ -58,6 +58,11 @@ public:
     /// Retorna el nombre de volums que hi ha al repositori
     int getNumberOfVolumes();
 
+    /// Si el setting CoreSettings::CompressInactiveVolumes és cert, comprimeix en memòria el pixel data dels volums carregats que no s'estan
+    /// fent servir en cap visor ni s'estan carregant. Es descomprimiran automàticament quan es tornin a fer servir.
+    /// Retorna el nombre de volums que s'han comprimit.
+    int compressInactiveVolumes();
+
     /// Ens retorna l'única instància del repositori.
     static VolumeRepository* getRepository()
     {
@@ -64,7 +64,7 @@ void VoxelInformationTool::handleEvent(unsigned long eventID)
             m_caption->visibilityOff();
             m_caption->update();
             m_2DViewer->restoreRenderingQuality();
-            m_2DViewer->render();
+            m_2DViewer->requestRender();
             break;
 
         default:
@@ -131,7 +131,7 @@ void VoxelInformationTool::updateCaption()
         m_caption->visibilityOff();
         m_caption->update();
     }
-    m_2DViewer->render();
+    m_2DViewer->requestRender();
 }
 
 QString VoxelInformationTool::computeVoxelValueOnInput(double worldCoordinate[3], int i)
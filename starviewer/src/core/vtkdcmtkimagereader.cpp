@@ -14,14 +14,17 @@
 
 #include "vtkdcmtkimagereader.h"
 
+#include "dcmdatasetcache.h"
 #include "dicomsequenceattribute.h"
 #include "dicomsequenceitem.h"
 #include "dicomtagreader.h"
 #include "dicomvalueattribute.h"
 #include "logging.h"
 #include "mathtools.h"
+#include "memorymappeddataarray.h"
 #include "photometricinterpretation.h"
 #include "imageorientation.h"
+#include "singleton.h"
 
 #include <QSharedPointer>
 #include <QStringList>
@@ -228,8 +231,16 @@ size_t voxelSize(int scalarType, int numberOfComponents)
 }
 
 // Returns a DcmDataset initialized from the given filename.
+// If the file has just been retrieved and its dataset is still in the DcmDatasetCache, that one is used instead of loading the file again.
 QSharedPointer<DcmDataset> getDataset(const char *filename)
 {
+    QSharedPointer<DcmDataset> cachedDataset = SingletonPointer<DcmDatasetCache>::instance()->take(filename);
+
+    if (cachedDataset)
+    {
+        return cachedDataset;
+    }
+
     DcmFileFormat dicomFile;
     OFCondition status = dicomFile.loadFile(filename);
 
@@ -268,7 +279,14 @@ void VtkDcmtkImageReader::setFrameNumbers(const QList<int> &frameNumbers)
     m_frameNumbers = frameNumbers;
 }
 
+void VtkDcmtkImageReader::setOutOfCoreStorage(const QString &directory, qint64 minimumSize)
+{
+    m_outOfCoreDirectory = directory;
+    m_outOfCoreMinimumSize = minimumSize;
+}
+
 VtkDcmtkImageReader::VtkDcmtkImageReader()
+    : m_outOfCoreMinimumSize(0)
 {
     this->SetNumberOfInputPorts(0);
     this->SetNumberOfOutputPorts(1);
@@ -656,11 +674,40 @@ bool VtkDcmtkImageReader::decideInitialScalarTypeAndNumberOfComponents(const cha
     return true;
 }
 
+void VtkDcmtkImageReader::allocateScalars(vtkImageData *output)
+{
+    if (!m_outOfCoreDirectory.isEmpty())
+    {
+        int dimensions[3];
+        output->GetDimensions(dimensions);
+        qint64 numberOfPoints = static_cast<qint64>(dimensions[0]) * dimensions[1] * dimensions[2];
+        qint64 size = numberOfPoints * voxelSize(this->DataScalarType, this->NumberOfScalarComponents);
+
+        if (size >= m_outOfCoreMinimumSize)
+        {
+            vtkDataArray *scalars = MemoryMappedDataArray::createTemporary(m_outOfCoreDirectory, this->DataScalarType, this->NumberOfScalarComponents,
+                                                                           numberOfPoints);
+
+            if (scalars)
+            {
+                INFO_LOG(QString("Volume of %1 MB stored out of core in %2").arg(size / (1024 * 1024)).arg(m_outOfCoreDirectory));
+                output->GetPointData()->SetScalars(scalars);
+                scalars->Delete();
+                return;
+            }
+
+            WARN_LOG("Couldn't store the volume out of core, it will be allocated in memory");
+        }
+    }
+
+    output->AllocateScalars(this->GetOutputInformation(0));
+}
+
 bool VtkDcmtkImageReader::loadData(int updateExtent[6])
 {
     vtkImageData *output = this->GetOutput(0);
     output->SetExtent(updateExtent);
-    output->AllocateScalars(this->GetOutputInformation(0));
+    allocateScalars(output);
     output->GetPointData()->GetScalars()->SetName("DCMTKImage");
 
     void *scalarPointer = output->GetScalarPointerForExtent(updateExtent);
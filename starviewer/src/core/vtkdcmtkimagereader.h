@@ -20,6 +20,7 @@
 #include <vtkImageReader2.h>
 
 #include <QList>
+#include <QString>
 
 class DicomImage;
 
@@ -50,6 +51,11 @@ public:
     /// Sets the list of frame numbers in the order they must be read from a multiframe file. No need to specify for single-frame files.
     void setFrameNumbers(const QList<int> &frameNumbers);
 
+    /// Sets the directory and minimum size in bytes from which the output scalars are stored in a temporary memory-mapped file instead of in memory,
+    /// so that volumes bigger than the physical memory can be read and the operating system pages slices in and out on demand.
+    /// An empty directory (the default) keeps all the volumes in memory.
+    void setOutOfCoreStorage(const QString &directory, qint64 minimumSize);
+
 protected:
 
     VtkDcmtkImageReader();
@@ -86,6 +92,8 @@ private:
     /// Returns false in case of error, if it can't decide the scalar type.
     bool decideInitialScalarTypeAndNumberOfComponents(const char *filename);
 
+    /// Allocates the scalars of the given output for its extent, in a memory-mapped file if the out-of-core storage is enabled and they are big enough.
+    void allocateScalars(vtkImageData *output);
     /// Loads image data from the file(s) for the given update extent.
     bool loadData(int updateExtent[6]);
     /// Loads image data from a single frame file into the given buffer.
@@ -121,6 +129,10 @@ private:
     double m_maximumVoxelValue;
     /// If it's true, a float scalar type will be used.
     bool m_needsFloatScalarType;
+    /// Directory where the out-of-core scalars are stored. If empty, the scalars are always allocated in memory.
+    QString m_outOfCoreDirectory;
+    /// Minimum size in bytes of the scalars to store them out of core.
+    qint64 m_outOfCoreMinimumSize;
 
 };
 
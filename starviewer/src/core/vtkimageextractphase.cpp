@@ -22,6 +22,8 @@
 #include <vtkObjectFactory.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
 
+#include <cstring>
+
 namespace udg {
 
 vtkStandardNewMacro(VtkImageExtractPhase)
@@ -119,30 +121,31 @@ void execute(vtkImageData *inData, vtkImageData *outData, int inExtent[6], int o
     vtkIdType outIncX, outIncY, outIncZ;
     outData->GetContinuousIncrements(outExtent, outIncX, outIncY, outIncZ);
 
+    // Rows are contiguous in both images, so they can be copied as a whole (incX is always 0 according to the documentation)
+    vtkIdType rowLength = static_cast<vtkIdType>(outExtent[1] - outExtent[0] + 1) * outData->GetNumberOfScalarComponents();
+    int numberOfRows = outExtent[3] - outExtent[2] + 1;
+    // If there are no gaps between rows in the input nor in the output each slice is a single contiguous block
+    bool contiguousSlices = inIncY == 0 && outIncY == 0;
+
     for (int iz = inExtent[4], oz = outExtent[4]; oz <= outExtent[5]; iz += numberOfPhases, oz++)
     {
         // Extract each time the input pointer for the current slice
         inExtent[4] = iz;
         T *inPtr = static_cast<T*>(inData->GetScalarPointerForExtent(inExtent));
 
-        for (int y = outExtent[2]; y <= outExtent[3]; y++)
+        if (contiguousSlices)
+        {
+            memcpy(outPtr, inPtr, rowLength * numberOfRows * sizeof(T));
+            outPtr += rowLength * numberOfRows;
+        }
+        else
         {
-            for (int x = outExtent[0]; x <= outExtent[1]; x++)
+            for (int y = 0; y < numberOfRows; y++)
             {
-                for (int c = 0; c < outData->GetNumberOfScalarComponents(); c++)
-                {
-                    // TODO progress
-                    *outPtr = *inPtr;
-                    inPtr++;
-                    outPtr++;
-                }
-
-//                inPtr += inIncX;      // incX is always 0 according to the documentation
-//                outPtr += outIncX;    // incX is always 0 according to the documentation
+                memcpy(outPtr, inPtr, rowLength * sizeof(T));
+                inPtr += rowLength + inIncY;
+                outPtr += rowLength + outIncY;
             }
-
-            inPtr += inIncY;
-            outPtr += outIncY;
         }
 
         outPtr += outIncZ;
@@ -151,6 +154,20 @@ void execute(vtkImageData *inData, vtkImageData *outData, int inExtent[6], int o
 
 }
 
+int VtkImageExtractPhase::RequestData(vtkInformation *request, vtkInformationVector **inputVector, vtkInformationVector *outputVector)
+{
+    if (m_numberOfPhases == 1 && m_phase == 0)
+    {
+        // The only phase is the whole input, so the output can share its scalars instead of copying them
+        vtkImageData *input = vtkImageData::GetData(inputVector[0]);
+        vtkImageData *output = vtkImageData::GetData(outputVector);
+        output->ShallowCopy(input);
+        return 1;
+    }
+
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
 void VtkImageExtractPhase::ThreadedRequestData(vtkInformation *vtkNotUsed(request), vtkInformationVector **inputVector,
                                                vtkInformationVector *vtkNotUsed(outputVector), vtkImageData ***inData, vtkImageData **outData, int outExtent[6],
                                                int vtkNotUsed(threadId))
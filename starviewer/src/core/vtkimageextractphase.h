@@ -53,7 +53,10 @@ protected:
     /// Sets the input update extent corresponding to the output update extent.
     virtual int RequestUpdateExtent(vtkInformation *request, vtkInformationVector **inputVector, vtkInformationVector *outputVector) override;
 
-    /// Copies the selected phase from the input data to the output data.
+    /// If there is only one phase the output shares the input data, otherwise the selected phase is copied by the threaded implementation.
+    virtual int RequestData(vtkInformation *request, vtkInformationVector **inputVector, vtkInformationVector *outputVector) override;
+
+    /// Copies the selected phase from the input data to the output data. Each thread copies its own range of output slices.
     virtual void ThreadedRequestData(vtkInformation *request, vtkInformationVector **inputVector, vtkInformationVector *outputVector, vtkImageData ***inData,
                                      vtkImageData **outData, int outExtent[6], int threadId) override;
 
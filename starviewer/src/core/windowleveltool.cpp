@@ -172,7 +172,7 @@ void WindowLevelTool::endWindowLevel()
     m_state = None;
     m_viewer->getInteractor()->GetRenderWindow()->SetDesiredUpdateRate(m_viewer->getInteractor()->GetStillUpdateRate());
     // Necessari perquè es torni a renderitzar a alta resolució en el 3D
-    m_viewer->render();
+    m_viewer->requestRender();
 }
 
 void WindowLevelTool::updateWindowLevellingBehaviour()
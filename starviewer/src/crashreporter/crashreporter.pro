@@ -14,6 +14,7 @@ HEADERS = qcrashreporter.h \
           ../core/settingsregistry.h \
           ../core/settings.h \
           ../core/settingsparser.h \
+          ../core/settingscache.h \
           ../core/defaultsettings.h \
           ../core/coresettings.h \
           ../core/settingsaccesslevelfilereader.h \
@@ -25,6 +26,7 @@ SOURCES = crashreporter.cpp \
           ../core/settingsregistry.cpp \
           ../core/settings.cpp \
           ../core/settingsparser.cpp \
+          ../core/settingscache.cpp \
           ../core/defaultsettings.cpp \
           ../core/coresettings.cpp \
           ../core/settingsaccesslevelfilereader.cpp \
@@ -14,12 +14,13 @@
 
 #include "converttodicomdir.h"
 
+#include <QMutexLocker>
 #include <QProgressDialog>
 #include <QTextStream>
 #include <QFile>
+#include <QtConcurrentMap>
 
 #include "logging.h"
-#include "status.h"
 #include "dicommask.h"
 #include "convertdicomtolittleendian.h"
 #include "directoryutilities.h"
@@ -44,6 +45,21 @@ ConvertToDicomdir::ConvertToDicomdir()
     m_anonymizeDICOMDIR = false;
     m_progress = NULL;
     m_DICOMAnonymizer = NULL;
+    m_copyFolderContent = false;
+    m_copyInitialProgressValue = 0;
+
+    connect(&m_copyFutureWatcher, SIGNAL(progressValueChanged(int)), SLOT(updateCopyProgress(int)));
+    connect(&m_copyFutureWatcher, SIGNAL(finished()), SLOT(queuedImagesCopied()));
+}
+
+ConvertToDicomdir::~ConvertToDicomdir()
+{
+    // Els fils de còpia fan servir aquest objecte, no es pot destruir fins que hagin acabat
+    m_copyFutureWatcher.cancel();
+    m_copyFutureWatcher.waitForFinished();
+
+    delete m_DICOMAnonymizer;
+    delete m_progress;
 }
 
 void ConvertToDicomdir::setAnonymizeDICOMDIR(bool anonymizeDICOMDIR, QString patientNameAnonymized)
@@ -110,13 +126,16 @@ void ConvertToDicomdir::addStudy(const QString &studyUID)
 // TODO:Si la creació del DICOMDIR Falla aquest mètode esborra el contingut del directori on s'havia de crear el DICOMDIR, al fer això
 //      la classe abans de crear el DICOMDIR hauria de comprovar que el directori està buit, perquè sinó podríem eliminar contingut del usuari.
 //      Ara aquesta comprovació es fa a la QCreateDicomdir i s'hauria de fer aquí
-Status ConvertToDicomdir::convert(const QString &dicomdirPath, CreateDicomdir::recordDeviceDicomDir selectedDevice, bool copyFolderContent)
+void ConvertToDicomdir::convert(const QString &dicomdirPath, CreateDicomdir::recordDeviceDicomDir selectedDevice, bool copyFolderContent)
 {
     // Primer copiem els estudis al directori desti, i posteriorment convertim el directori en un dicomdir
     Status state;
+    state.setStatus("", true, 0);
     int totalNumberOfItems = 0;
 
     m_dicomDirPath = dicomdirPath;
+    m_selectedDevice = selectedDevice;
+    m_copyFolderContent = copyFolderContent;
 
     QString pathFolderContentToCopyToDICOMDIR = Settings().getValue(InputOutputSettings::DICOMDIRFolderPathToCopy).toString();
     if (copyFolderContent && !AreValidRequirementsOfFolderContentToCopyToDICOMDIR(pathFolderContentToCopyToDICOMDIR))
@@ -124,7 +143,8 @@ Status ConvertToDicomdir::convert(const QString &dicomdirPath, CreateDicomdir::r
         ERROR_LOG(QString("No es pot crear el DICOMDIR perquè el path %1 conte un element amb el nom DICOM o DICOMDIR")
                      .arg(pathFolderContentToCopyToDICOMDIR));
         state.setStatus("", false, 4003);
-        return state;
+        emit finished(state);
+        return;
     }
 
     DicomMask studyMask;
@@ -162,8 +182,8 @@ Status ConvertToDicomdir::convert(const QString &dicomdirPath, CreateDicomdir::r
 
     if (!state.good())
     {
-        DirectoryUtilities().deleteDirectory(m_dicomDirPath, false);
-        return state;
+        finishConversion(state);
+        return;
     }
 
     // Sumem una imatge més per evitar que arribi el 100 % la progress bar, i així s'esperi a que es crei el dicomdir, que es fa quan s'invoca
@@ -187,57 +207,86 @@ Status ConvertToDicomdir::convert(const QString &dicomdirPath, CreateDicomdir::r
         m_DICOMAnonymizer = NULL;
     }
 
-    // Copiem les imatges dels estudis seleccionats al directori desti
+    // Creem l'estructura de directoris dels estudis seleccionats al directori desti i copiem les seves imatges
     state = copyStudiesToDicomdirPath(studyList);
 
     if (!state.good())
     {
-        m_progress->close();
-        DirectoryUtilities().deleteDirectory(m_dicomDirPath, false);
-        return state;
+        finishConversion(state);
+        return;
     }
-    // Una vegada copiada les imatges les creem
-    state = createDicomdir(m_dicomDirPath, selectedDevice);
 
-    if (!state.good() && state.code() != 4001)
+    startCopyingQueuedImagesToDicomdirPath();
+}
+
+void ConvertToDicomdir::queuedImagesCopied()
+{
+    Status state;
+    state.setStatus("", true, 0);
+
+    foreach (const Status &imageState, m_copyFutureWatcher.future().results())
     {
-        // L'error 4001 és que les imatges no compleixen l'estàndard al 100, però el dicomdir es pot utilitzar
-        DirectoryUtilities().deleteDirectory(m_dicomDirPath, false);
+        if (!imageState.good())
+        {
+            state = imageState;
+            break;
+        }
     }
-    else
+
+    m_imagesToCopy.clear();
+
+    if (!state.good())
+    {
+        finishConversion(state);
+        return;
+    }
+
+    // Una vegada copiada les imatges les creem
+    state = createDicomdir(m_dicomDirPath, m_selectedDevice);
+
+    if (state.good() || state.code() == 4001)
     {
-        if (copyFolderContent)
+        // L'error 4001 és que les imatges no compleixen l'estàndard al 100, però el dicomdir es pot utilitzar
+        if (m_copyFolderContent)
         {
             // Copiar el contingut del directory s'ha de fer una vegada s'hagi creat el DICOMDIR, perquè si dcmtk detecta al directori on s'ha de crear
             // el DICOMDIR que hi ha fitxers no DICOM fallarà.
 
             if (!copyFolderContentToDICOMDIR())
             {
-                m_progress->close();
-                DirectoryUtilities().deleteDirectory(m_dicomDirPath, false);
                 state.setStatus("", false, 4002);
-                return state;
+                finishConversion(state);
+                return;
             }
         }
 
         createReadmeTxt();
     }
 
-    m_progress->close();
+    finishConversion(state);
+}
 
-    if (m_DICOMAnonymizer)
+void ConvertToDicomdir::finishConversion(const Status &state)
+{
+    if (!state.good() && state.code() != 4001)
     {
-        delete m_DICOMAnonymizer;
-        m_DICOMAnonymizer = NULL;
+        DirectoryUtilities().deleteDirectory(m_dicomDirPath, false);
     }
 
     if (m_progress)
     {
+        m_progress->close();
         delete m_progress;
         m_progress = NULL;
     }
 
-    return state;
+    if (m_DICOMAnonymizer)
+    {
+        delete m_DICOMAnonymizer;
+        m_DICOMAnonymizer = NULL;
+    }
+
+    emit finished(state);
 }
 
 Status ConvertToDicomdir::createDicomdir(const QString &dicomdirPath, CreateDicomdir::recordDeviceDicomDir selectedDevice)
@@ -309,10 +358,12 @@ Status ConvertToDicomdir::copyStudiesToDicomdirPath(QList<Study*> studyList)
     QString patientNameDir;
     QDir patientDir;
     Status state;
+    state.setStatus("", true, 0);
     QChar fillChar = '0';
     Study *study;
 
     m_patient = 0;
+    m_imagesToCopy.clear();
 
     // Agrupem estudis1 per pacient, com que tenim la llista ordenada per patientId
     while (!m_studiesToConvert.isEmpty())
@@ -401,51 +452,79 @@ Status ConvertToDicomdir::copySeriesToDicomdirPath(Series *series)
     m_dicomDirSeriesPath = m_dicomDirStudyPath + seriesName;
     seriesDir.mkdir(m_dicomDirSeriesPath);
 
-    state = copyImages(series->getImages());
+    copyImages(series->getImages());
+    state.setStatus("", true, 0);
 
     return state;
 }
 
-Status ConvertToDicomdir::copyImages(QList<Image*> images)
+void ConvertToDicomdir::copyImages(QList<Image*> images)
 {
-    Status state;
     m_currentItemNumber = 0;
     // HACK per evitar els casos en que siguin imatges procedents d'un multiframe
     // que copiem més d'una vegada un arxiu
     QString lastPath;
-    foreach (Image *imageToCopy, images)
+    foreach (Image *image, images)
     {
-        if (lastPath != imageToCopy->getPath())
+        if (lastPath != image->getPath())
         {
-            lastPath = imageToCopy->getPath();
-            
+            lastPath = image->getPath();
+
             m_currentItemNumber++;
-            state = copyImageToDicomdirPath(imageToCopy);
-            
-            // La barra de progrés avança
-            m_progress->setValue(m_progress->value() + 1);
-            m_progress->repaint();
-            
-            if (!state.good())
-            {
-                break;
-            }
+
+            ImageToCopy imageToCopy;
+            imageToCopy.sourcePath = image->getPath();
+            // El nom del fitxer de l'imatge té el format IMGXXXXX, on XXXXX és el numero d'imatge dins la sèrie
+            imageToCopy.destinationPath = getCurrentItemOutputPath();
+            m_imagesToCopy.append(imageToCopy);
         }
     }
+}
 
-    return state;
+void ConvertToDicomdir::startCopyingQueuedImagesToDicomdirPath()
+{
+    m_copyFailed.store(0);
+    m_copyInitialProgressValue = m_progress->value();
+
+    // Les còpies es fan al QThreadPool global; cada fil només té carregat el fitxer que està convertint.
+    // m_imagesToCopy no es pot modificar fins que s'hagi acabat la còpia
+    m_copyFutureWatcher.setFuture(QtConcurrent::mapped(m_imagesToCopy, ImageToCopyCopier(this)));
 }
 
-Status ConvertToDicomdir::copyImageToDicomdirPath(Image *image)
+void ConvertToDicomdir::updateCopyProgress(int numberOfCopiedImages)
 {
-    // Creem el nom del fitxer de l'imatge, el format és IMGXXXXX, on XXXXX és el numero d'imatge dins la sèrie
-    QString imageOutputPath = getCurrentItemOutputPath();
+    if (m_progress)
+    {
+        // La barra de progrés avança
+        m_progress->setValue(m_copyInitialProgressValue + numberOfCopiedImages);
+    }
+}
+
+ConvertToDicomdir::ImageToCopyCopier::ImageToCopyCopier(ConvertToDicomdir *convertToDicomdir)
+    : m_convertToDicomdir(convertToDicomdir)
+{
+}
+
+Status ConvertToDicomdir::ImageToCopyCopier::operator()(const ImageToCopy &imageToCopy) const
+{
+    return m_convertToDicomdir->copyImageToDicomdirPath(imageToCopy);
+}
+
+Status ConvertToDicomdir::copyImageToDicomdirPath(const ImageToCopy &imageToCopy)
+{
+    const QString &imageOutputPath = imageToCopy.destinationPath;
     Status state;
 
+    if (m_copyFailed.load())
+    {
+        // Ja ha fallat alguna còpia, el DICOMDIR s'esborrarà i no cal seguir copiant
+        return state.setStatus("", true, 0);
+    }
+
     if (getConvertDicomdirImagesToLittleEndian())
     {
         // Convertim la imatge a littleEndian, demanat per la normativa DICOM i la guardem al directori desti
-        state = ConvertDicomToLittleEndian().convert(image->getPath(), imageOutputPath);
+        state = ConvertDicomToLittleEndian().convert(imageToCopy.sourcePath, imageOutputPath);
 
         if (m_anonymizeDICOMDIR && state.good())
         {
@@ -459,14 +538,19 @@ Status ConvertToDicomdir::copyImageToDicomdirPath(Image *image)
         // que no s'han de convertir a LittleEndian és més ràpid.
         if (m_anonymizeDICOMDIR)
         {
-            anonymizeFile(image->getPath(), imageOutputPath, state, false);
+            anonymizeFile(imageToCopy.sourcePath, imageOutputPath, state, false);
         }
         else
         {
-            copyFileToDICOMDIRDestination(image->getPath(), imageOutputPath, state);
+            copyFileToDICOMDIRDestination(imageToCopy.sourcePath, imageOutputPath, state);
         }
     }
 
+    if (!state.good())
+    {
+        m_copyFailed.store(1);
+    }
+
     return state;
 }
 
@@ -496,6 +580,8 @@ void ConvertToDicomdir::copyFileToDICOMDIRDestination(const QString &sourceFile,
 
 void ConvertToDicomdir::anonymizeFile(const QString &sourceFile, const QString &destinationFile, Status &status, bool isLittleEndian)
 {
+    QMutexLocker locker(&m_anonymizerMutex);
+
     if (m_DICOMAnonymizer->anonymizeDICOMFile(sourceFile, destinationFile))
     {
         status.setStatus("", true, 0);
@@ -15,10 +15,14 @@
 #ifndef UDGCONVERTTODICOMDIR_H
 #define UDGCONVERTTODICOMDIR_H
 
+#include <QAtomicInt>
+#include <QFutureWatcher>
+#include <QMutex>
 #include <QObject>
 #include <QStringList>
 
 #include "createdicomdir.h"
+#include "status.h"
 
 // Fordward declarations
 class QProgressDialog;
@@ -26,7 +30,6 @@ class QProgressDialog;
 namespace udg {
 
 // Fordward declarations
-class Status;
 class Study;
 class Series;
 class Image;
@@ -34,6 +37,10 @@ class DICOMAnonymizer;
 
 /**
     Converteix un estudi a DICOMDIR, invocant el mètodes i classes necessàries.
+    La conversió es fa en dues fases: primer es recorre la jerarquia Pacient/Estudi/Sèrie/Imatge creant els directoris i la llista de fitxers a copiar, i
+    després es copien (convertint-los a Little Endian i anonimitzant-los si cal) en paral·lel amb QtConcurrent. Com que cada fil només té carregat el fitxer
+    que està convertint, la memòria utilitzada queda limitada pel nombre de fils del QThreadPool global.
+    La còpia no bloqueja l'event loop: convert() només la inicia i quan s'acaba tota la conversió s'emet finished().
     Per crear un dicomdir, s'han de seguir les normes especificades a la IHE per PDI (portable data information) i DICOM : Aquestes normes són :
     El nom dels directoris i imatges no pot ser de mes de 8 caràcters, i ha d'estar en majúscules
     Les imatges no poden tenir extensió
@@ -44,6 +51,7 @@ class ConvertToDicomdir : public QObject {
 Q_OBJECT
 public:
     ConvertToDicomdir();
+    ~ConvertToDicomdir();
 
     /// Ens permet indicar que volem anonimitzar l'estudi DICOMDIR, i en el cas que l'anonimitzem se li pot indicar quin nom de pacient que han de tenir els
     /// estudis anonimitzats. Si s'indica que no es vol anonimitzar l'estudi i es passar un valor al segon paràmetre aquest s'ignorarà.
@@ -55,13 +63,13 @@ public:
     /// @param studyUID UID de l'estudi a convertir a dicomdir
     void addStudy (const QString &studyUID);
 
-    /// Converteix a DICOMDIR en el path especificat els estudis que hi ha a la llista. ATENCIÓ!!! Si al crear el DICOMDIR falla s'esborrar el contingut
+    /// Inicia la conversió a DICOMDIR en el path especificat dels estudis que hi ha a la llista. Quan acaba s'emet finished() amb l'estat final, que pot
+    /// ser abans de retornar si falla abans de començar a copiar les imatges. ATENCIÓ!!! Si al crear el DICOMDIR falla s'esborrar el contingut
     /// de la carpeta destí. La carpeta destí ha d'estar buida sinó la creació del DICOMDIR fallà i esborrarà tot el contingut del a carperta destí.
     /// @param dicomdirPath directori on es guardarà el dicomdir
     /// @param indica si s'ha de copiar el contingut del directori guardat al settings InputOutputSettings::DICOMDIRFolderPathToCopy al DICOMDIR
-    /// @return Indica l'estat en què finalitza el mètode
     // TODO:La comprovació de que la carpeta destí estigui buida es fa a QCreateDicomdir s'hauria de traslladar en aquesta classe
-    Status convert(const QString &dicomdirPath, CreateDicomdir::recordDeviceDicomDir selectedDevice, bool copyFolderContent);
+    void convert(const QString &dicomdirPath, CreateDicomdir::recordDeviceDicomDir selectedDevice, bool copyFolderContent);
 
     /// Crea un fitxer README.TXT, amb informació sobre quina institució ha generat el dicomdir per quan es grava en un cd o dvd en el path que se
     /// li especifiqui. En el cas que el txt es vulgui afegir en el mateix directori arrel on hi ha el dicomdir s'haura de fer després d'haver convertir
@@ -78,6 +86,17 @@ public:
     /// Aquest mètode ens comprova que es compleixi aquest requeriment.
     bool AreValidRequirementsOfFolderContentToCopyToDICOMDIR(QString path);
 
+signals:
+    /// S'emet quan acaba la conversió iniciada amb convert(), amb l'estat en què ha finalitzat
+    void finished(const Status &state);
+
+private slots:
+    /// Fa avançar la barra de progrés a mesura que es copien les imatges
+    void updateCopyProgress(int numberOfCopiedImages);
+
+    /// Acaba la conversió un cop s'han copiat totes les imatges: crea el DICOMDIR i hi copia el contingut de la carpeta si cal
+    void queuedImagesCopied();
+
 private:
     /// Estructura que conté la informació d'un estudi a convertir a dicomdir.
     /// És necessari guardar el Patient ID perquè segons la normativa de l'IHE,
@@ -88,6 +107,25 @@ private:
             QString studyUID;
         };
 
+    /// Fitxer pendent de copiar al DICOMDIR amb el seu path d'origen i de destí
+    struct ImageToCopy
+    {
+        QString sourcePath;
+        QString destinationPath;
+    };
+
+    /// Functor per poder copiar les imatges pendents amb QtConcurrent::mapped
+    class ImageToCopyCopier {
+    public:
+        typedef Status result_type;
+
+        ImageToCopyCopier(ConvertToDicomdir *convertToDicomdir);
+        Status operator()(const ImageToCopy &imageToCopy) const;
+
+    private:
+        ConvertToDicomdir *m_convertToDicomdir;
+    };
+
     /// Crea un dicomdir, al directori especificat
     /// @param dicomdirPath lloc a crear el dicomdir
     /// @param selectedDevice dispositiu on es crearà el dicomdir
@@ -107,13 +145,20 @@ private:
     /// @return Indica l'estat en què finalitza el mètode
     Status copySeriesToDicomdirPath(Series *series);
 
-    /// Does the process of copying a list of images to the corresponding DICOMDIR destination 
-    Status copyImages(QList<Image*> images);
-    
-    /// Converteix una imatge al format littleendian, i la copia al directori dicomdir
-    /// @param image
+    /// Adds the files of the given images to the list of files pending to be copied to the corresponding DICOMDIR destination
+    void copyImages(QList<Image*> images);
+
+    /// Starts copying in parallel all the files queued by copyImages(). queuedImagesCopied() is called when all of them have been copied.
+    /// Once a copy fails, the pending ones are skipped.
+    void startCopyingQueuedImagesToDicomdirPath();
+
+    /// Allibera els recursos de la conversió, esborra el directori destí si ha fallat i emet finished()
+    void finishConversion(const Status &state);
+
+    /// Converteix una imatge al format littleendian, i la copia al directori dicomdir. Pot ser cridat des de qualsevol fil.
+    /// @param imageToCopy
     /// @return Indica l'estat en què finalitza el mètode
-    Status copyImageToDicomdirPath(Image *image);
+    Status copyImageToDicomdirPath(const ImageToCopy &imageToCopy);
 
     /// Gets the corresponding output prefix name
     QString getDICOMDIROutputFilenamePrefix() const;
@@ -124,7 +169,7 @@ private:
     /// Copies source file to destination file and sets the Status for the operation
     void copyFileToDICOMDIRDestination(const QString &sourceFile, const QString &destinationFile, Status &status);
 
-    /// Anonymizes sourceFile and puts the result in destinationFile.
+    /// Anonymizes sourceFile and puts the result in destinationFile. Calls are serialized because the anonymizer must keep the consistency of the UIDs.
     /// isLittleEndian is needed in order to give an accurate message in status in case there are some error.
     void anonymizeFile(const QString &sourceFile, const QString &destinationFile, Status &status, bool isLittleEndian);
     
@@ -144,6 +189,19 @@ private:
 
     QStringList m_patientDirectories;
 
+    /// Dispositiu i opció de copiar el contingut de la carpeta de la conversió en curs, per acabar-la quan s'hagin copiat les imatges
+    CreateDicomdir::recordDeviceDicomDir m_selectedDevice;
+    bool m_copyFolderContent;
+
+    /// Fitxers pendents de copiar al DICOMDIR
+    QList<ImageToCopy> m_imagesToCopy;
+    /// Segueix la còpia en paral·lel dels fitxers pendents
+    QFutureWatcher<Status> m_copyFutureWatcher;
+    /// Valor de la barra de progrés quan ha començat la còpia dels fitxers
+    int m_copyInitialProgressValue;
+    /// Indica que alguna còpia ha fallat i que no cal continuar copiant
+    QAtomicInt m_copyFailed;
+
     int m_patient;
     int m_study;
     int m_series;
@@ -152,6 +210,8 @@ private:
 
     /// És necessari crear-la global per mantenir la consistència dels UID dels fitxers DICOM
     DICOMAnonymizer *m_DICOMAnonymizer;
+    /// Serialitza l'accés a m_DICOMAnonymizer des dels fils de còpia
+    QMutex m_anonymizerMutex;
     bool m_anonymizeDICOMDIR;
     QString m_patientNameAnonymized;
 };
@@ -74,6 +74,8 @@ DICOMDIRReader::DICOMDIRReader()
 
 DICOMDIRReader::~DICOMDIRReader()
 {
+    clearIndex();
+    delete m_dicomdir;
 }
 
 Status DICOMDIRReader::open(const QString &dicomdirFilePath)
@@ -82,6 +84,7 @@ Status DICOMDIRReader::open(const QString &dicomdirFilePath)
 
     // No existeix cap comanda per tancar un dicomdir, quan en volem obrir un de nou, l'única manera d'obrir un nou dicomdir, és a través del construtor de
     // DcmDicomDir, passant el path per paràmetre, per això si ja existia un Dicomdir ober, fem un delete, per tancar-lo
+    clearIndex();
     if (m_dicomdir != NULL)
     {
         delete m_dicomdir;
@@ -113,12 +116,17 @@ Status DICOMDIRReader::open(const QString &dicomdirFilePath)
 
     m_dicomdir = new DcmDicomDir(qPrintable(QDir::toNativeSeparators(dicomdirFilePath)));
 
-    return state.setStatus(m_dicomdir->error());
+    state.setStatus(m_dicomdir->error());
+    if (state.good())
+    {
+        buildIndex();
+    }
+
+    return state;
 }
 
-// El dicomdir segueix una estructura d'abre on tenim n pacients, que tenen n estudis, que conté n series, i que conté n imatges, per llegir la informació
-// hem d'accedir a través d'aquesta estructura d'arbre, primer llegim el primer pacient, amb el primer pacient, podem accedir el segon nivell de l'arbre, els
-// estudis del pacient, i anar fent així fins arribar al nivell de baix de tot, les imatges,
+// El dicomdir segueix una estructura d'abre on tenim n pacients, que tenen n estudis, que conté n series, i que conté n imatges. L'índex construït en obrir
+// el dicomdir ens permet filtrar els pacients sense tornar a llegir els seus registres i accedir directament als registres dels seus estudis
 Status DICOMDIRReader::readStudies(QList<Patient*> &outResultsStudyList, DicomMask studyMask)
 {
     Status state;
@@ -129,65 +137,48 @@ Status DICOMDIRReader::readStudies(QList<Patient*> &outResultsStudyList, DicomMa
         return state.setStatus("Error: Not open dicomfile", false, 1302);
     }
 
-    // Accedim a l'estructura d'arbres del dicomdir
-    DcmDirectoryRecord *root = &(m_dicomdir->getRootRecord());
-    // Accedim al primer pacient
-    DcmDirectoryRecord *patientRecord = root->getSub(0);
-
-    // En aquest primer while accedim al patient Record a nivell de dades de pacient
-    while (patientRecord != NULL)
+    foreach (const PatientIndexEntry &patientIndexEntry, m_patientIndex)
     {
-        Patient *patient = fillPatient(patientRecord);
+        // Si no compleix a nivell de pacient ja no accedim als seus estudis
+        if (!matchPatientToDicomMask(patientIndexEntry.patient, &studyMask))
+        {
+            continue;
+        }
+
+        Patient *patient = NULL;
 
-        // Si no compleix a nivelld de pacient ja no accedim als seus estudis
-        if (matchPatientToDicomMask(patient, &studyMask))
+        foreach (DcmDirectoryRecord *studyRecord, patientIndexEntry.studyRecords)
         {
-            // Indiquem que volem el primer estudi del pacient
-            DcmDirectoryRecord *studyRecord = patientRecord->getSub(0);
+            Study *study = fillStudy(studyRecord);
 
-            // En aquest while accedim a les dades de l'estudi
-            while (studyRecord != NULL)
+            // Comprovem si l'estudi compleix la màscara de cerca que ens han passat
+            if (matchStudyToDicomMask(study, &studyMask))
             {
-                Study *study = fillStudy(studyRecord);
-
-                // Comprovem si l'estudi compleix la màscara de cerca que ens han passat
-                if (matchStudyToDicomMask(study, &studyMask))
-                {
-                    patient->addStudy(study);
-                }
-                else
+                if (!patient)
                 {
-                    delete study;
+                    patient = new Patient();
+                    patient->setFullName(patientIndexEntry.patient->getFullName());
+                    patient->setID(patientIndexEntry.patient->getID());
                 }
 
-                // Accedim al següent estudi del pacient
-                studyRecord = patientRecord->nextSub(studyRecord);
-            }
-
-            // Si cap estudi ha complert la màscara de cerca ja no afegim el pacient
-            if (patient->getNumberOfStudies() > 0)
-            {
-                outResultsStudyList.append(patient);
+                patient->addStudy(study);
             }
             else
             {
-                delete patient;
+                delete study;
             }
         }
-        else
+
+        // Si cap estudi ha complert la màscara de cerca no hem creat el pacient i ja no l'afegim
+        if (patient)
         {
-            delete patient;
+            outResultsStudyList.append(patient);
         }
-
-        // Accedim al següent pacient del dicomdir
-        patientRecord = root->nextSub(patientRecord);
     }
 
     return state.setStatus(m_dicomdir->error());
 }
 
-// Per trobar les sèries d'une estudi haurem de recorre tots els estudis dels pacients, que hi hagi en el dicomdir, fins que obtinguem l'estudi amb el UID
-// sol·licitat una vegada found, podrem accedir a la seva informacio de la sèrie
 Status DICOMDIRReader::readSeries(const QString &studyUID, const QString &seriesUID, QList<Series*> &outResultsSeriesList)
 {
     Status state;
@@ -198,49 +189,10 @@ Status DICOMDIRReader::readSeries(const QString &studyUID, const QString &series
         return state.setStatus("Error: Not open dicomfile", false, 1302);
     }
 
-    // Accedim a l'estructura d'abres del dicomdir
-    DcmDirectoryRecord *root = &(m_dicomdir->getRootRecord());
-    // Accedim al primer pacient
-    DcmDirectoryRecord *patientRecord = root->getSub(0);
-    DcmDirectoryRecord *studyRecord;
-    OFString text;
-    QString studyUIDRecord, seriesPath;
-    bool found = false;
+    DcmDirectoryRecord *studyRecord = m_studyRecordsByUID.value(studyUID, NULL);
 
-    // Accedim a nivell de pacient
-    while (patientRecord != NULL && !found)
-    {
-        // Indiquem que volem el primer estudi del pacient
-        studyRecord = patientRecord->getSub(0);
-
-        while (studyRecord != NULL && !found)
-        {
-            text.clear();
-            studyUIDRecord.clear();
-            // Obtenim el UID de l'estudi al qual estem posicionats
-            studyRecord->findAndGetOFStringArray(DCM_StudyInstanceUID, text);
-            studyUIDRecord = text.c_str();
-            // Busquem l'estudi que continguin el mateix UID
-            if (studyUIDRecord == studyUID)
-            {
-                found = true;
-            }
-            else
-            {
-                // Si no trobem accedim al seguent estudi del pacient
-                studyRecord = patientRecord->nextSub(studyRecord);
-            }
-        }
-
-        if (!found)
-        {
-            // Accedim al següent pacient
-            patientRecord = root->nextSub(patientRecord);
-        }
-    }
-
-    // Si hem found l'estudi amb el UID que cercàvem
-    if (found)
+    // Si hem trobat l'estudi amb el UID que cercàvem
+    if (studyRecord)
     {
         // Seleccionem la serie de l'estudi que conté el studyUID que cercàvem
         DcmDirectoryRecord *seriesRecord = studyRecord->getSub(0);
@@ -276,60 +228,11 @@ Status DICOMDIRReader::readImages(const QString &seriesUID, const QString &sopIn
         return state.setStatus("Error: Not open dicomfile", false, 1302);
     }
 
-    // Accedim a l'estructura d'abres del dicomdir
-    DcmDirectoryRecord *root = &(m_dicomdir->getRootRecord());
-    // Accedim al primer pacient
-    DcmDirectoryRecord *patientRecord = root->getSub(0);
-    DcmDirectoryRecord *studyRecord, *seriesRecord;
-    OFString text;
-    QString studyUIDRecord, seriesUIDRecord, imagePath;
-    bool found = false;
+    DcmDirectoryRecord *seriesRecord = m_seriesRecordsByUID.value(seriesUID, NULL);
 
-    // Accedim a nivell de pacient
-    while (patientRecord != NULL && !found)
+    // Si hem trobat la sèrie amb el UID que cercàvem
+    if (seriesRecord)
     {
-        // Indiquem que volem el primer estudi del pacient
-        studyRecord = patientRecord->getSub(0);
-
-        // Accedim a nivell estudi
-        while (studyRecord != NULL && !found)
-        {
-            // Seleccionem la serie de l'estudi que conté el studyUID que cercàvem
-            seriesRecord = studyRecord->getSub(0);
-            // Accedim a nivell
-            while (seriesRecord != NULL && !found)
-            {
-                // UID Serie
-                text.clear();
-                seriesUIDRecord.clear();
-                seriesRecord->findAndGetOFStringArray(DCM_SeriesInstanceUID, text);
-                seriesUIDRecord.insert(0, text.c_str());
-                // Busquem la sèrie amb les imatges
-                if (seriesUIDRecord == seriesUID)
-                {
-                    found = true;
-                }
-                else
-                {
-                    // Accedim a la següent sèrie de l'estudi
-                    seriesRecord = studyRecord->nextSub(seriesRecord);
-                }
-            }
-            // Si no trobem accedim al seguent estudi del pacient
-            studyRecord = patientRecord->nextSub(studyRecord);
-        }
-
-        if (!found)
-        {
-            // Accedim al següent pacient
-            patientRecord = root->nextSub(patientRecord);
-        }
-    }
-
-    // Si hem found la sèrie amb el UID que cercàvem
-    if (found)
-    {
-        // Seleccionem la serie de l'estudi que conté el studyUID que cercàvem
         DcmDirectoryRecord *imageRecord = seriesRecord->getSub(0);
 
         while (imageRecord != NULL)
@@ -360,11 +263,9 @@ QString DICOMDIRReader::getDicomdirFilePath()
     return m_dicomdirAbsolutePath + "/" + m_dicomdirFileName;
 }
 
-// TODO s'haurai de mirar si es pot fer servir les funcions de readimage, readseries i readstudy, perquè aquest mètode, són els tres anteriors mètodes en un
 QStringList DICOMDIRReader::getFiles(const QString &studyUID)
 {
     QStringList files;
-    Status state;
 
     if (m_dicomdir == NULL)
     {
@@ -372,56 +273,17 @@ QStringList DICOMDIRReader::getFiles(const QString &studyUID)
         return files;
     }
 
-    // Accedim a l'estructura d'abres del dicomdir
-    DcmDirectoryRecord *root = &(m_dicomdir->getRootRecord());
-    // Accedim al primer pacient
-    DcmDirectoryRecord *patientRecord = root->getSub(0);
-    DcmDirectoryRecord *studyRecord, *seriesRecord, *imageRecord;
-
-    QString studyUIDRecord, seriesUIDRecord, imagePath;
-    bool found = false;
-
-    // Trobem primer l'estudi que volem
-    while (patientRecord != NULL && !found)
-    {
-        // Indiquem que volem el primer estudi del pacient
-        studyRecord = patientRecord->getSub(0);
-        // Accedim a nivell estudi
-        while (studyRecord != NULL && !found)
-        {
-            OFString text;
-            studyUIDRecord.clear();
-            studyRecord->findAndGetOFStringArray(DCM_StudyInstanceUID, text);
-            studyUIDRecord = text.c_str();
-            // És l'estudi que volem?
-            if (studyUIDRecord == studyUID)
-            {
-                found = true;
-            }
-            else
-            {
-                // Si no trobem accedim al seguent estudi del pacient
-                studyRecord = patientRecord->nextSub(studyRecord);
-            }
-        }
-        if (!found)
-        {
-            // Accedim al següent pacient
-            patientRecord = root->nextSub(patientRecord);
-        }
-    }
+    DcmDirectoryRecord *studyRecord = m_studyRecordsByUID.value(studyUID, NULL);
 
     // Si hem trobat l'uid que es demanava podem continuar amb la cerca dels arxius
-    if (found)
+    if (studyRecord)
     {
-        found = false;
-        // Seleccionem la serie de l'estudi que conté el studyUID que cercàvem
-        seriesRecord = studyRecord->getSub(0);
-        // Llegim totes les seves sèries
-        while (seriesRecord != NULL && !found)
+        // Llegim totes les sèries de l'estudi
+        DcmDirectoryRecord *seriesRecord = studyRecord->getSub(0);
+        while (seriesRecord != NULL)
         {
             // Seleccionem cada imatge de la series
-            imageRecord = seriesRecord->getSub(0);
+            DcmDirectoryRecord *imageRecord = seriesRecord->getSub(0);
             while (imageRecord != NULL)
             {
                 OFString text;
@@ -445,6 +307,66 @@ QStringList DICOMDIRReader::getFiles(const QString &studyUID)
     return files;
 }
 
+void DICOMDIRReader::buildIndex()
+{
+    // Accedim a l'estructura d'arbres del dicomdir
+    DcmDirectoryRecord *root = &(m_dicomdir->getRootRecord());
+    DcmDirectoryRecord *patientRecord = root->getSub(0);
+
+    while (patientRecord != NULL)
+    {
+        PatientIndexEntry patientIndexEntry;
+        patientIndexEntry.patient = fillPatient(patientRecord);
+
+        DcmDirectoryRecord *studyRecord = patientRecord->getSub(0);
+        while (studyRecord != NULL)
+        {
+            OFString text;
+            studyRecord->findAndGetOFStringArray(DCM_StudyInstanceUID, text);
+            QString studyUID = text.c_str();
+            patientIndexEntry.studyRecords.append(studyRecord);
+
+            // Si un UID apareix més d'una vegada ens quedem amb el primer registre, com es feia recorrent l'arbre
+            if (!m_studyRecordsByUID.contains(studyUID))
+            {
+                m_studyRecordsByUID.insert(studyUID, studyRecord);
+            }
+
+            DcmDirectoryRecord *seriesRecord = studyRecord->getSub(0);
+            while (seriesRecord != NULL)
+            {
+                text.clear();
+                seriesRecord->findAndGetOFStringArray(DCM_SeriesInstanceUID, text);
+                QString seriesUID = text.c_str();
+
+                if (!m_seriesRecordsByUID.contains(seriesUID))
+                {
+                    m_seriesRecordsByUID.insert(seriesUID, seriesRecord);
+                }
+
+                seriesRecord = studyRecord->nextSub(seriesRecord);
+            }
+
+            studyRecord = patientRecord->nextSub(studyRecord);
+        }
+
+        m_patientIndex.append(patientIndexEntry);
+        patientRecord = root->nextSub(patientRecord);
+    }
+}
+
+void DICOMDIRReader::clearIndex()
+{
+    foreach (const PatientIndexEntry &patientIndexEntry, m_patientIndex)
+    {
+        delete patientIndexEntry.patient;
+    }
+
+    m_patientIndex.clear();
+    m_studyRecordsByUID.clear();
+    m_seriesRecordsByUID.clear();
+}
+
 Patient* DICOMDIRReader::retrieve(DicomMask maskToRetrieve)
 {
     QStringList files = this->getFiles(maskToRetrieve.getStudyInstanceUID());
@@ -15,6 +15,7 @@
 #ifndef UDGDICOMDIRREADER_H
 #define UDGDICOMDIRREADER_H
 
+#include <QHash>
 #include <QString>
 #include <QList>
 
@@ -34,6 +35,8 @@ class Status;
     Aquesta classe permet llegir un dicomdir i consultar-ne els seus elements.
     Accedint a través de l'estructura d'arbres que representen els dicomdir Pacient/Estudi/Series/Imatges, accedim a la informació el Dicomdir per a
     realitzar cerques.
+    En obrir el dicomdir es recorre l'arbre una sola vegada i es construeix un índex dels pacients i dels registres d'estudi i sèrie per UID, de manera
+    que les consultes posteriors no han de tornar a recórrer l'arbre des de l'arrel.
   */
 class DICOMDIRReader {
 public:
@@ -78,11 +81,34 @@ public:
     /// En la màscara només es té en compte el StudyInstanceUID.
     Patient* retrieve(DicomMask maskToRetrieve);
 
+private:
+    /// Entrada de l'índex per a un pacient del dicomdir
+    struct PatientIndexEntry
+    {
+        /// Pacient amb les dades del registre, utilitzat per comprovar la màscara sense haver de tornar a llegir el registre
+        Patient *patient;
+        /// Registres dels estudis del pacient en l'ordre en què apareixen al dicomdir
+        QList<DcmDirectoryRecord*> studyRecords;
+    };
+
+    /// Recorre l'arbre del dicomdir i construeix l'índex de pacients, estudis i sèries
+    void buildIndex();
+
+    /// Esborra l'índex i allibera els pacients que conté
+    void clearIndex();
+
 private:
     DcmDicomDir *m_dicomdir;
     QString m_dicomdirAbsolutePath, m_dicomdirFileName;
     bool m_dicomFilesInLowerCase;
 
+    /// Índex dels pacients del dicomdir en l'ordre en què apareixen
+    QList<PatientIndexEntry> m_patientIndex;
+    /// Registres d'estudi indexats pel seu Study Instance UID
+    QHash<QString, DcmDirectoryRecord*> m_studyRecordsByUID;
+    /// Registres de sèrie indexats pel seu Series Instance UID
+    QHash<QString, DcmDirectoryRecord*> m_seriesRecordsByUID;
+
     /// Comprova que un pacient compleixi amb la màscara (comprova que compleixi el  Patient Name i Patient ID)
     bool matchPatientToDicomMask(Patient *patient, DicomMask *mask);
 
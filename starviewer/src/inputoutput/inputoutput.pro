@@ -54,7 +54,7 @@ HEADERS += databaseconnection.h \
     localdatabasestudydal.h \
     localdatabasepatientdal.h \
     localdatabaseutildal.h \
-    qdeleteoldstudiesthread.h \
+    oldstudieshousekeeper.h \
     databaseinstallation.h \
     qlocaldatabaseconfigurationscreen.h \
     parsexmlrispierrequest.h \
@@ -73,6 +73,7 @@ HEADERS += databaseconnection.h \
     dicomdirburningapplication.h \
     risrequestmanager.h \
     relatedstudiesmanager.h \
+    relatedstudiesquerycache.h \
     risrequestwrapper.h \
     qwidgetselectpacstostoredicomimage.h \
     qrelatedstudieswidget.h \
@@ -131,7 +132,7 @@ SOURCES += databaseconnection.cpp \
     localdatabasestudydal.cpp \
     localdatabasepatientdal.cpp \
     localdatabaseutildal.cpp \
-    qdeleteoldstudiesthread.cpp \
+    oldstudieshousekeeper.cpp \
     databaseinstallation.cpp \
     qlocaldatabaseconfigurationscreen.cpp \
     parsexmlrispierrequest.cpp \
@@ -150,6 +151,7 @@ SOURCES += databaseconnection.cpp \
     dicomdirburningapplication.cpp \
     risrequestmanager.cpp \
     relatedstudiesmanager.cpp \
+    relatedstudiesquerycache.cpp \
     risrequestwrapper.cpp \
     qwidgetselectpacstostoredicomimage.cpp \
     qrelatedstudieswidget.cpp \
@@ -194,4 +196,5 @@ include(../threadweaver.pri)
 QT += xml \
     network \
     widgets \
-    sql
+    sql \
+    concurrent
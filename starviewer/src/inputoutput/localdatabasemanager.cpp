@@ -14,7 +14,9 @@
 
 #include "localdatabasemanager.h"
 
+#include "asynchronousthumbnailcreator.h"
 #include "databaseconnection.h"
+#include "dcmdatasetcache.h"
 #include "dicommask.h"
 #include "directoryutilities.h"
 #include "harddiskinformation.h"
@@ -29,6 +31,7 @@
 #include "localdatabaseutildal.h"
 #include "localdatabasevoilutdal.h"
 #include "patient.h"
+#include "singleton.h"
 #include "thumbnailcreator.h"
 
 #include <QDir>
@@ -426,12 +429,18 @@ QString getSeriesThumbnailPath(const QString &studyInstanceUID, const Series *se
 }
 
 // Creates and saves a thumbnail for the given series in the directory of the series' images.
+// Thumbnails made from an image are created in the background by AsynchronousThumbnailCreator, the ones made from an icon are created here.
 void createSeriesThumbnail(const Series *series)
 {
     QString thumbnailFilePath = getSeriesThumbnailPath(series->getParentStudy()->getInstanceUID(), series);
+    const Image *representativeImage = ThumbnailCreator::getRepresentativeImage(series);
 
+    if (representativeImage)
+    {
+        SingletonPointer<AsynchronousThumbnailCreator>::instance()->enqueue(representativeImage->getPath(), QStringList(thumbnailFilePath));
+    }
     // Create thumbnail only if it doesn't already exist
-    if (!QFileInfo(thumbnailFilePath).exists())
+    else if (!QFileInfo(thumbnailFilePath).exists())
     {
         ThumbnailCreator().getThumbnail(series).save(thumbnailFilePath, "PNG");
     }
@@ -710,11 +719,16 @@ void LocalDatabaseManager::deleteStudy(const QString &studyInstanceUID)
         return;
     }
 
+    DatabaseConnection databaseConnection;
+    deleteStudy(databaseConnection, studyInstanceUID);
+}
+
+void LocalDatabaseManager::deleteStudy(DatabaseConnection &databaseConnection, const QString &studyInstanceUID)
+{
     INFO_LOG(QString("Deleting study %1 from local database.").arg(studyInstanceUID));
 
     try
     {
-        DatabaseConnection databaseConnection;
         databaseConnection.beginTransaction();
         deleteStudyStructureFromDatabase(databaseConnection, studyInstanceUID);
         databaseConnection.commitTransaction();
@@ -766,39 +780,57 @@ void LocalDatabaseManager::deleteSeries(const QString &studyInstanceUID, const Q
     }
 }
 
-void LocalDatabaseManager::deleteOldStudies()
+int LocalDatabaseManager::deleteOldStudies(int maximumNumberOfStudies)
 {
     m_lastError = Ok;
 
     // If the setting is false don't do anything
     if (!Settings().getValue(InputOutputSettings::DeleteLeastRecentlyUsedStudiesInDaysCriteria).toBool())
     {
-        return;
+        return 0;
     }
 
     DatabaseConnection databaseConnection;
-    LocalDatabaseStudyDAL studyDAL(databaseConnection);
+    return deleteStudiesAccessedBefore(databaseConnection, LastAccessDateSelectedStudies, maximumNumberOfStudies);
+}
 
-    INFO_LOG(QString("Deleting studies that haven't been open since %1").arg(LastAccessDateSelectedStudies.addDays(-1).toString("dd/MM/yyyy")));
+int LocalDatabaseManager::deleteStudiesAccessedBefore(DatabaseConnection &databaseConnection, const QDate &accessedBefore, int maximumNumberOfStudies)
+{
+    m_lastError = Ok;
 
-    QList<Study*> studiesToDelete = studyDAL.query(DicomMask(), LastAccessDateSelectedStudies);
+    LocalDatabaseStudyDAL studyDAL(databaseConnection);
+
+    QList<Study*> studiesToDelete = studyDAL.queryLeastRecentlyAccessed(accessedBefore, maximumNumberOfStudies);
 
     if (studyDAL.getLastError().isValid())
     {
         setLastError(studyDAL.getLastError());
-        return;
+        qDeleteAll(studiesToDelete);
+        return 0;
     }
 
-    if (studiesToDelete.isEmpty())
+    if (!studiesToDelete.isEmpty())
     {
-        INFO_LOG("No studies to delete.");
+        INFO_LOG(QString("Deleting %1 studies that haven't been open since %2").arg(studiesToDelete.count())
+                 .arg(accessedBefore.addDays(-1).toString("dd/MM/yyyy")));
     }
 
+    int numberOfDeletedStudies = 0;
     foreach (Study *study, studiesToDelete)
     {
-        deleteStudy(study->getInstanceUID());
+        if (m_lastError == Ok)
+        {
+            emit studyWillBeDeleted(study->getInstanceUID());
+            deleteStudy(databaseConnection, study->getInstanceUID());
+            if (m_lastError == Ok)
+            {
+                numberOfDeletedStudies++;
+            }
+        }
         delete study;
     }
+
+    return numberOfDeletedStudies;
 }
 
 void LocalDatabaseManager::compact()
@@ -1010,6 +1042,8 @@ QList<Study*> LocalDatabaseManager::getAllStudiesOrderedByLastAccessDate()
 
 void LocalDatabaseManager::deleteStudyFromHardDisk(const QString &studyInstanceUID)
 {
+    SingletonPointer<DcmDatasetCache>::instance()->removeDirectory(getStudyPath(studyInstanceUID));
+
     if (DirectoryUtilities().deleteDirectory(getStudyPath(studyInstanceUID), true))
     {
         m_lastError = Ok;
@@ -1022,6 +1056,8 @@ void LocalDatabaseManager::deleteStudyFromHardDisk(const QString &studyInstanceU
 
 void LocalDatabaseManager::deleteSeriesFromHardDisk(const QString &studyInstanceUID, const QString &seriesInstanceUID)
 {
+    SingletonPointer<DcmDatasetCache>::instance()->removeDirectory(getStudyPath(studyInstanceUID) + QDir::separator() + seriesInstanceUID);
+
     if (DirectoryUtilities().deleteDirectory(getStudyPath(studyInstanceUID) + QDir::separator() + seriesInstanceUID, true))
     {
         m_lastError = Ok;
@@ -21,6 +21,7 @@ class QSqlError;
 
 namespace udg {
 
+class DatabaseConnection;
 class DicomMask;
 class EncapsulatedDocument;
 class Image;
@@ -78,9 +79,13 @@ public:
     /// Deletes the series with the given SeriesInstanceUID from the study with the given StudyInstanceUID. If the study becomes empty, it's also deleted.
     void deleteSeries(const QString &studyInstanceUID, const QString &seriesInstanceUID);
 
-    /// Deletes studies that have not been open in a number of days specified in settings,
-    /// as long as the setting to delete old studies is set to true, otherwise it does nothing.
-    void deleteOldStudies();
+    /// Deletes at most \a maximumNumberOfStudies of the studies that have not been open in a number of days specified in settings, starting with the least
+    /// recently open ones, as long as the setting to delete old studies is set to true, otherwise it does nothing.
+    /// Returns the number of deleted studies, so that old studies can be deleted in small batches until it returns less than the requested number.
+    int deleteOldStudies(int maximumNumberOfStudies);
+    /// Deletes from the given database and the disk at most \a maximumNumberOfStudies of the studies last accessed before \a accessedBefore, starting with
+    /// the least recently accessed ones, regardless of the settings. Returns the number of deleted studies. Used by deleteOldStudies().
+    int deleteStudiesAccessedBefore(DatabaseConnection &databaseConnection, const QDate &accessedBefore, int maximumNumberOfStudies);
 
     /// Compacts the database.
     void compact();
@@ -118,17 +123,20 @@ public slots:
     void save(Patient *patient);
 
 signals:
-    /// This signal is emitted before a study is deleted from the local database and the disk to free up space.
+    /// This signal is emitted before a study is deleted from the local database and the disk to free up space or because it is old.
     void studyWillBeDeleted(const QString &studyInstanceUID);
 
 private:
+    /// Deletes the study with the given UID from the given database and the disk.
+    void deleteStudy(DatabaseConnection &databaseConnection, const QString &studyInstanceUID);
+
     /// Deletes old studies until the given number of megabytes have been deleted.
     void freeUpSpaceDeletingStudies(quint64 megbytesToFreeUp);
 
     /// Returns all the studies sorted by last access date.
     QList<Study*> getAllStudiesOrderedByLastAccessDate();
 
-    /// Deletes the study with the given UID from the disk.
+    /// Deletes the study with the given UID from the disk, together with the decoded pixel data kept by RawPixelDataCache inside its directory.
     void deleteStudyFromHardDisk(const QString &studyInstanceUID);
     /// Deletes the series with the given UID from the study with the given UID from the disk.
     void deleteSeriesFromHardDisk(const QString &studyInstanceUID, const QString &seriesInstanceUID);
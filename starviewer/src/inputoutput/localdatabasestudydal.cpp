@@ -234,6 +234,11 @@ QList<Study*> LocalDatabaseStudyDAL::queryOrderByLastAccessDate(const DicomMask
     return query(mask, accessedBefore, accessedAfter, " ORDER BY LastAccessDate");
 }
 
+QList<Study*> LocalDatabaseStudyDAL::queryLeastRecentlyAccessed(const QDate &accessedBefore, int maximumNumberOfStudies)
+{
+    return query(DicomMask(), accessedBefore, QDate(), QString(" ORDER BY LastAccessDate LIMIT %1").arg(maximumNumberOfStudies));
+}
+
 QList<Patient*> LocalDatabaseStudyDAL::queryPatientStudy(const DicomMask &mask, const QDate &accessedBefore, const QDate &accessedAfter)
 {
     QSqlQuery query = getNewQuery();
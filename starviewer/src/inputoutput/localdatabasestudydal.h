@@ -50,6 +50,10 @@ public:
     /// (\a accessedBefore, \a accessedAfter], and returns them in a list sorted by last access date in ascending order.
     QList<Study*> queryOrderByLastAccessDate(const DicomMask &mask, const QDate &accessedBefore = QDate(), const QDate &accessedAfter = QDate());
 
+    /// Retrieves from the database at most \a maximumNumberOfStudies studies whose last access date is before \a accessedBefore, starting with the least
+    /// recently accessed ones, and returns them in a list sorted by last access date in ascending order.
+    QList<Study*> queryLeastRecentlyAccessed(const QDate &accessedBefore, int maximumNumberOfStudies);
+
     /// Retrieves from the database the patients that contain studies that match the given mask (patient id, patient name, study date, study instance UID and
     /// modalities are considered) and whose last access date is in the range (\a accessedBefore, \a accessedAfter], and returns the patients in a list.
     /// For each matching study a Patient object with one Study object will be returned, so there may be multiple Patient objects representing the same patient.
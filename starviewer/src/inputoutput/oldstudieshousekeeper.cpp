@@ -0,0 +1,128 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#include "oldstudieshousekeeper.h"
+
+#include "inputoutputsettings.h"
+#include "logging.h"
+#include "pacsmanager.h"
+
+#include <QTimer>
+#include <QtConcurrentRun>
+
+namespace udg {
+
+const int OldStudiesHousekeeper::StartDelay = 60000;
+const int OldStudiesHousekeeper::BatchInterval = 2000;
+const int OldStudiesHousekeeper::BusyRetryInterval = 30000;
+const int OldStudiesHousekeeper::BatchSize = 5;
+
+OldStudiesHousekeeper::OldStudiesHousekeeper(QObject *parent)
+ : QObject(parent), m_pacsManager(0), m_lastError(LocalDatabaseManager::Ok)
+{
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    connect(m_timer, SIGNAL(timeout()), SLOT(deleteNextBatch()));
+    connect(&m_batchWatcher, SIGNAL(finished()), SLOT(batchFinished()));
+}
+
+OldStudiesHousekeeper::~OldStudiesHousekeeper()
+{
+    m_timer->stop();
+    // No es pot deixar un lot a mitges perquè la base de dades i el disc quedarien inconsistents
+    m_batchWatcher.waitForFinished();
+}
+
+void OldStudiesHousekeeper::setPacsManager(PacsManager *pacsManager)
+{
+    m_pacsManager = pacsManager;
+}
+
+void OldStudiesHousekeeper::start()
+{
+    // Si no s'han d'esborrar els estudis vells ni tan sols es programa
+    if (!Settings().getValue(InputOutputSettings::DeleteLeastRecentlyUsedStudiesInDaysCriteria).toBool())
+    {
+        return;
+    }
+
+    m_lastError = LocalDatabaseManager::Ok;
+    if (!m_batchWatcher.isRunning())
+    {
+        m_timer->start(StartDelay);
+    }
+}
+
+LocalDatabaseManager::LastError OldStudiesHousekeeper::getLastError() const
+{
+    return m_lastError;
+}
+
+void OldStudiesHousekeeper::deleteNextBatch()
+{
+    if (m_pacsManager && m_pacsManager->isExecutingPACSJob(PACSJob::RetrieveDICOMFilesFromPACSJobType))
+    {
+        DEBUG_LOG("S'estan descarregant estudis, s'ajorna l'esborrat d'estudis vells");
+        m_timer->start(BusyRetryInterval);
+        return;
+    }
+
+    m_batchWatcher.setFuture(QtConcurrent::run(&OldStudiesHousekeeper::deleteBatch));
+}
+
+void OldStudiesHousekeeper::batchFinished()
+{
+    BatchResult result = m_batchWatcher.result();
+    m_lastError = result.lastError;
+
+    foreach (const QString &studyInstanceUID, result.deletedStudyInstanceUIDs)
+    {
+        emit studyDeleted(studyInstanceUID);
+    }
+
+    if (m_lastError == LocalDatabaseManager::Ok && result.numberOfDeletedStudies == BatchSize)
+    {
+        // Pot ser que quedin més estudis vells
+        m_timer->start(BatchInterval);
+    }
+    else
+    {
+        INFO_LOG("S'ha acabat l'esborrat d'estudis vells");
+        emit finished();
+    }
+}
+
+OldStudiesHousekeeper::BatchResult OldStudiesHousekeeper::deleteBatch()
+{
+    LocalDatabaseManager localDatabaseManager;
+
+    BatchResult result;
+    // El gestor viu en aquest thread, per tant el signal arriba directament
+    connect(&localDatabaseManager, &LocalDatabaseManager::studyWillBeDeleted, [&result](const QString &studyInstanceUID) {
+        result.deletedStudyInstanceUIDs.append(studyInstanceUID);
+    });
+    result.numberOfDeletedStudies = localDatabaseManager.deleteOldStudies(BatchSize);
+    result.lastError = localDatabaseManager.getLastError();
+
+    if (result.lastError != LocalDatabaseManager::Ok && !result.deletedStudyInstanceUIDs.isEmpty())
+    {
+        // L'esborrat s'atura al primer error, per tant l'últim estudi anunciat és el que no s'ha pogut esborrar
+        result.deletedStudyInstanceUIDs.removeLast();
+    }
+
+    return result;
+}
+
+}
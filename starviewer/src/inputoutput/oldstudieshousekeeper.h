@@ -0,0 +1,103 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+
+#ifndef UDGOLDSTUDIESHOUSEKEEPER_H
+#define UDGOLDSTUDIESHOUSEKEEPER_H
+
+#include <QObject>
+
+#include <QFutureWatcher>
+#include <QStringList>
+
+#include "localdatabasemanager.h"
+
+class QTimer;
+
+namespace udg {
+
+class PacsManager;
+
+/**
+    Esborra de la cache els estudis vells, els que no s'han obert en el nombre de dies indicat a la configuració, en segon pla i de mica en mica.
+
+    L'esborrat comença un temps després de cridar start() per no endarrerir l'arrencada de l'aplicació, i es fa en lots petits, cadascun en un thread
+    del QThreadPool, amb una pausa entre lots. Mentre s'estan descarregant estudis del PACS no s'esborra res per no competir per l'accés al disc.
+    La consulta dels estudis a esborrar fa servir l'índex de la data de darrer accés, per tant cada lot només llegeix els estudis que esborra.
+  */
+class OldStudiesHousekeeper : public QObject {
+Q_OBJECT
+public:
+    OldStudiesHousekeeper(QObject *parent = 0);
+    ~OldStudiesHousekeeper();
+
+    /// Assigna el PacsManager per saber si s'estan descarregant estudis
+    void setPacsManager(PacsManager *pacsManager);
+
+    /// Programa l'esborrat dels estudis vells, si està activat a la configuració. Retorna immediatament.
+    void start();
+
+    /// Retorna l'estat de l'operació d'esborrar estudis vells
+    LocalDatabaseManager::LastError getLastError() const;
+
+signals:
+    /// S'emet per cada estudi esborrat quan s'acaba el lot que l'ha esborrat
+    void studyDeleted(const QString &studyInstanceUID);
+
+    /// S'emet quan s'han acabat d'esborrar els estudis vells o quan s'ha produït un error
+    void finished();
+
+private slots:
+    /// Esborra el següent lot d'estudis vells, o l'ajorna si s'estan descarregant estudis
+    void deleteNextBatch();
+
+    /// Comprova el resultat del lot que s'acaba d'esborrar i programa el següent si queden estudis vells
+    void batchFinished();
+
+private:
+    /// Resultat de l'esborrat d'un lot
+    struct BatchResult
+    {
+        int numberOfDeletedStudies;
+        QStringList deletedStudyInstanceUIDs;
+        LocalDatabaseManager::LastError lastError;
+    };
+
+    /// Esborra un lot d'estudis vells. S'executa en un thread del QThreadPool.
+    static BatchResult deleteBatch();
+
+private:
+    /// Temps en ms que s'espera des de start() abans d'esborrar el primer lot
+    static const int StartDelay;
+    /// Temps en ms entre lots
+    static const int BatchInterval;
+    /// Temps en ms que s'espera per tornar-ho a provar si s'estan descarregant estudis
+    static const int BusyRetryInterval;
+    /// Nombre màxim d'estudis que s'esborren en cada lot
+    static const int BatchSize;
+
+    /// Timer que programa el següent lot
+    QTimer *m_timer;
+
+    /// Vigila el lot que s'està esborrant
+    QFutureWatcher<BatchResult> m_batchWatcher;
+
+    PacsManager *m_pacsManager;
+
+    LocalDatabaseManager::LastError m_lastError;
+};
+
+}
+
+#endif
@@ -52,6 +52,7 @@ QCreateDicomdir::QCreateDicomdir(QWidget *parent)
     setupUi(this);
     setWindowFlags(this->windowFlags() ^ Qt::WindowContextHelpButtonHint);
     QString sizeOfDicomdirText;
+    m_convertToDicomdir = NULL;
 
     resetDICOMDIRList();
 
@@ -64,6 +65,8 @@ QCreateDicomdir::QCreateDicomdir(QWidget *parent)
 
 QCreateDicomdir::~QCreateDicomdir()
 {
+    // Espera que acabin les còpies pendents abans d'esborrar el directori temporal
+    delete m_convertToDicomdir;
     clearTemporaryDICOMDIRPath();
 }
 
@@ -334,22 +337,16 @@ void QCreateDicomdir::createDicomdir()
                 break;
         case CreateDicomdir::DvdRom:
         case CreateDicomdir::CdRom:
-                // Cd, si s'ha creat bé, executem el programa per gravar el dicomdir a cd's
-                Status state = createDicomdirOnCdOrDvd();
-                // Error 4001 és el cas en que alguna imatge de l'estudi no compleix amb l'estàndard dicom tot i així el deixem gravar
-                if (state.good() || (!state.good() && state.code() == 4001))
-                {
-                    burnDicomdir();
-                }
+                // Cd, si s'ha creat bé s'executarà el programa per gravar el dicomdir a cd's quan s'acabi de crear
+                createDicomdirOnCdOrDvd();
                 break;
     }
 }
 
-Status QCreateDicomdir::createDicomdirOnCdOrDvd()
+void QCreateDicomdir::createDicomdirOnCdOrDvd()
 {
     QDir temporaryDirPath;
     QString dicomdirPath = getTemporaryDICOMDIRPath();
-    Status state;
 
     // Si el directori dicomdir ja existeix al temporal l'esborrem
     clearTemporaryDICOMDIRPath();
@@ -361,11 +358,10 @@ Status QCreateDicomdir::createDicomdirOnCdOrDvd()
     {
         QMessageBox::critical(this, ApplicationNameString, tr("Unable to create the temporary directory to create the DICOMDIR. Please check user permissions."));
         ERROR_LOG("Error al crear directori " + dicomdirPath);
-        return state.setStatus("Unable to create temporary DICOMDIR", false, 3002);
     }
     else
     {
-        return startCreateDicomdir(dicomdirPath);
+        startCreateDicomdir(dicomdirPath);
     }
 }
 
@@ -445,20 +441,16 @@ void QCreateDicomdir::createDicomdirOnHardDiskOrFlashMemories()
     m_lastDicomdirDirectory = dicomdirPath;
 }
 
-Status QCreateDicomdir::startCreateDicomdir(QString dicomdirPath)
+void QCreateDicomdir::startCreateDicomdir(QString dicomdirPath)
 {
-    ConvertToDicomdir convertToDicomdir;
-    Status state;
     Settings settings;
 
-    convertToDicomdir.setConvertDicomdirImagesToLittleEndian(settings.getValue(InputOutputSettings::ConvertDICOMDIRImagesToLittleEndianKey).toBool());
-
     // Comprovem si hi ha suficient espai lliure al disc dur
     if (!enoughFreeSpace(dicomdirPath))
     {
         QMessageBox::information(this, ApplicationNameString, tr("Not enough free space to create DICOMDIR. Please free space."));
-        ERROR_LOG("Error al crear el DICOMDIR, no hi ha suficient espai al disc ERROR : " + state.text());
-        return state.setStatus("Not enough space to create DICOMDIR", false, 3000);
+        ERROR_LOG("Error al crear el DICOMDIR, no hi ha suficient espai al disc");
+        return;
     }
 
     QList<QTreeWidgetItem*> dicomdirStudiesList(m_dicomdirStudiesList ->findItems("*", Qt::MatchWildcard, 0));
@@ -468,25 +460,40 @@ Status QCreateDicomdir::startCreateDicomdir(QString dicomdirPath)
     if (dicomdirStudiesList.count() == 0)
     {
         QMessageBox::information(this, ApplicationNameString, tr("You haven't selected any study to create the DICOMDIR. Please select at least one study."));
-        return state.setStatus("No study selected to create the DICOMDIR", false, 3001);
+        return;
     }
 
     QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
 
+    m_convertToDicomdir = new ConvertToDicomdir();
+    m_convertToDicomdir->setConvertDicomdirImagesToLittleEndian(settings.getValue(InputOutputSettings::ConvertDICOMDIRImagesToLittleEndianKey).toBool());
+    connect(m_convertToDicomdir, SIGNAL(finished(Status)), SLOT(dicomdirConverted(Status)));
+    m_dicomdirPathInConversion = dicomdirPath;
+
     for (int i = 0; i < dicomdirStudiesList.count(); i++)
     {
         item = dicomdirStudiesList.at(i);
         // Indiquem a la classe convertToDicomdir, quins estudis s'ha de convertir a dicomdir, passant el UID de l'estudi
-        convertToDicomdir.addStudy(item->text(7));
+        m_convertToDicomdir->addStudy(item->text(7));
         INFO_LOG("L'estudi " + item->text(7) + " s'afegirà al DICOMDIR ");
     }
 
     if (m_anonymizeDICOMDIRCheckBox->isChecked())
     {
-        convertToDicomdir.setAnonymizeDICOMDIR(true, m_patientNameAnonymizedLineEdit->text());
+        m_convertToDicomdir->setAnonymizeDICOMDIR(true, m_patientNameAnonymizedLineEdit->text());
     }
 
-    state = convertToDicomdir.convert(dicomdirPath, m_currentDevice, haveToCopyFolderContentToDICOMDIR());
+    m_convertToDicomdir->convert(dicomdirPath, m_currentDevice, haveToCopyFolderContentToDICOMDIR());
+}
+
+void QCreateDicomdir::dicomdirConverted(const Status &state)
+{
+    Settings settings;
+    QString dicomdirPath = m_dicomdirPathInConversion;
+
+    // Pot arribar des de dins de ConvertToDicomdir::convert(), per tant no es pot esborrar immediatament
+    m_convertToDicomdir->deleteLater();
+    m_convertToDicomdir = NULL;
 
     bool clearScreen = false;
     if (!state.good())
@@ -532,7 +539,7 @@ Status QCreateDicomdir::startCreateDicomdir(QString dicomdirPath)
                     "destination folders and %1 folder is empty.").arg(m_lineEditDicomdirPath->text()));
                 ERROR_LOG(QString("Error (%1) al crear el DICOMDIR: %2").arg(state.code()).arg(state.text()));
                 DEBUG_LOG(QString("Error (%1) al crear el DICOMDIR: %2").arg(state.code()).arg(state.text()));
-                return state;
+                return;
         }
     }
     else
@@ -548,7 +555,11 @@ Status QCreateDicomdir::startCreateDicomdir(QString dicomdirPath)
 
     QApplication::restoreOverrideCursor();
 
-    return state;
+    // Error 4001 és el cas en que alguna imatge de l'estudi no compleix amb l'estàndard dicom tot i així el deixem gravar
+    if ((m_currentDevice == CreateDicomdir::CdRom || m_currentDevice == CreateDicomdir::DvdRom) && (state.good() || state.code() == 4001))
+    {
+        burnDicomdir();
+    }
 }
 
 void QCreateDicomdir::clearQCreateDicomdirScreen()
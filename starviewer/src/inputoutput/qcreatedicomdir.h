@@ -29,6 +29,7 @@ class Study;
 class Status;
 class Image;
 class IsoImageFileCreator;
+class ConvertToDicomdir;
 
 class QCreateDicomdir : public QDialog, private Ui::QCreateDicomdirBase {
 Q_OBJECT
@@ -85,13 +86,13 @@ private:
     /// @param state  Estat del mètode
     void showDatabaseErrorMessage(const Status &state);
 
-    /// Crea el DICOMDIR amb els estudis seleccionats, en el directori on se li passa per paràmetre
+    /// Comença a crear el DICOMDIR amb els estudis seleccionats, en el directori on se li passa per paràmetre.
+    /// Quan s'acaba es crida dicomdirConverted()
     /// @param dicomdirPath directori on s'ha de crear el DICOMDIR
-    /// @return retorna l'estat del mètode
-    Status startCreateDicomdir(QString dicomdirPath);
+    void startCreateDicomdir(QString dicomdirPath);
 
-    /// Crea el DICOMDIR en un CD o DVD
-    Status createDicomdirOnCdOrDvd();
+    /// Crea el DICOMDIR en un CD o DVD, que es grava quan s'acaba de crear
+    void createDicomdirOnCdOrDvd();
 
     /// Crea el DICOMDIR al disc dur, dispositius externs usb o memòries flash
     void createDicomdirOnHardDiskOrFlashMemories();
@@ -128,6 +129,9 @@ private slots:
     /// Es passa per paràmetre l'identificador del dispositiu i es fan les pertinents accions
     void deviceChanged(int value);
 
+    /// Slot que s'activa quan s'ha acabat de crear el DICOMDIR. Informa dels errors i, si el DICOMDIR és per un CD o DVD, el grava
+    void dicomdirConverted(const Status &state);
+
     /// Slot que s'activa quan s'ha acabat de generar la imatge del DICOMDIR i per tant es pot executar el programa de gravació
     void openBurningApplication(bool createIsoResult);
 
@@ -185,6 +189,10 @@ private:
     /// Variable que ens diu quin és el dispositiu seleccionat en aquell moment
     CreateDicomdir::recordDeviceDicomDir m_currentDevice;
 
+    /// Conversió a DICOMDIR en curs i directori on es crea
+    ConvertToDicomdir *m_convertToDicomdir;
+    QString m_dicomdirPathInConversion;
+
     /// Variable que indica si a la mida del DICOMDIR s'hi ha sumat el tamany que ocupa la carpeta a copiar el DICOMDIR
     bool m_folderToCopyToDICOMDIRSizeAddedToDICOMDIRSize;
 
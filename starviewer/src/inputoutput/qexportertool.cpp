@@ -19,6 +19,7 @@
 #include "q2dviewer.h"
 #include "volume.h"
 #include "volumebuilderfromcaptures.h"
+#include "viewerbatchcapturer.h"
 #include "dicomimagefilegenerator.h"
 #include "image.h"
 #include "series.h"
@@ -137,83 +138,33 @@ void QExporterTool::generateAndStoreNewSeries()
     progress.setValue(0);
     qApp->processEvents();
 
+    // Les llesques i fases es renderitzen sense mostrar-les per pantalla
+    ViewerBatchCapturer capturer(m_viewer);
     if (m_currentImageRadioButton->isChecked())
     {
-        // Capturem la vista
-        builder->addCapture(this->captureCurrentView());
+        capturer.addCurrentView();
     }
     else if (m_allImagesRadioButton->isChecked())
     {
-        Q2DViewer *viewer2D = Q2DViewer::castFromQViewer(m_viewer);
-
-        // Guardem la llesca i la fase acutal
-        int currentSlice = viewer2D->getCurrentSlice();
-        int currentPhase = viewer2D->getCurrentPhase();
-
-        int maxSlice = viewer2D->getMaximumSlice() + 1;
-
-        // En cas que tinguem fases farem tantes passades com fases
-        int phases = viewer2D->getNumberOfPhases();
-
-        for (int i = 0; i < maxSlice; i++)
-        {
-            viewer2D->setSlice(i);
-            for (int j = 0; j < phases; j++)
-            {
-                viewer2D->setPhase(j);
-
-                // Capturem la vista
-                builder->addCapture(this->captureCurrentView());
-            }
-        }
-        // Restaurem
-        viewer2D->setSlice(currentSlice);
-        viewer2D->setPhase(currentPhase);
-
+        capturer.addAllSlicesAndPhases();
     }
     else if (m_imagesOfCurrentPhaseRadioButton->isChecked())
     {
-        Q2DViewer *viewer2D = Q2DViewer::castFromQViewer(m_viewer);
-
-        // Guardem la llesca acutal
-        int currentSlice = viewer2D->getCurrentSlice();
-        int maxSlice = viewer2D->getMaximumSlice() + 1;
-
-        for (int i = 0; i < maxSlice; i++)
-        {
-            viewer2D->setSlice(i);
-
-            // Capturem la vista
-            builder->addCapture(this->captureCurrentView());
-        }
-        // Restaurem
-        viewer2D->setSlice(currentSlice);
+        capturer.addAllSlicesOfCurrentPhase();
     }
     else if (m_phasesOfCurrentImageRadioButton->isChecked())
     {
-        Q2DViewer *viewer2D = Q2DViewer::castFromQViewer(m_viewer);
-
-        // Guardem la fase acutal
-        int currentPhase = viewer2D->getCurrentPhase();
-        int phases = viewer2D->getNumberOfPhases();
-
-        for (int i = 0; i < phases; i++)
-        {
-            viewer2D->setPhase(i);
-
-            // Capturem la vista
-            builder->addCapture(this->captureCurrentView());
-        }
-
-        // Restaurem
-        viewer2D->setPhase(currentPhase);
+        capturer.addAllPhasesOfCurrentSlice();
     }
     else
     {
         DEBUG_LOG(QString("Radio Button no identificat!"));
+        delete builder;
         return;
     }
 
+    capturer.captureToVolumeBuilder(builder);
+
     builder->setSeriesDescription(m_seriesDescription->text());
 
     Volume *generetedVolume = builder->build();
@@ -94,8 +94,9 @@ void QInputOutputLocalDatabaseWidget::createConnections()
     // Si passem de tenir un element seleccionat a no tenir-ne li diem al seriesListWidget que no mostri cap previsualització
     connect(m_studyTreeWidget, SIGNAL(notCurrentItemSelected()), m_seriesThumbnailPreviewWidget, SLOT(clear()));
 
-    // Connecta amb el signal que indica que ha finalitza el thread d'esborrar els estudis vells
-    connect(&m_qdeleteOldStudiesThread, SIGNAL(finished()), SLOT(deleteOldStudiesThreadFinished()));
+    // Els estudis vells esborrats es treuen de la llista a mesura que s'esborren, i quan s'acaba es mostra l'error si n'hi ha hagut
+    connect(&m_oldStudiesHousekeeper, SIGNAL(studyDeleted(QString)), SLOT(oldStudyDeleted(QString)));
+    connect(&m_oldStudiesHousekeeper, SIGNAL(finished()), SLOT(oldStudiesHousekeeperFinished()));
 
     /// Si movem el QSplitter capturem el signal per guardar la seva posició
     connect(m_StudyTreeSeriesListQSplitter, SIGNAL(splitterMoved (int, int)), SLOT(qSplitterPositionChanged()));
@@ -142,6 +143,7 @@ void QInputOutputLocalDatabaseWidget::clear()
 void QInputOutputLocalDatabaseWidget::setPacsManager(PacsManager *pacsManager)
 {
     m_pacsManager = pacsManager;
+    m_oldStudiesHousekeeper.setPacsManager(pacsManager);
     connect(pacsManager, SIGNAL(newPACSJobEnqueued(PACSJobPointer)), SLOT(newPACSJobEnqueued(PACSJobPointer)));
 }
 
@@ -483,13 +485,8 @@ void QInputOutputLocalDatabaseWidget::addSelectedStudiesToCreateDicomdirList()
 //       d'aquesta inferfície
 void QInputOutputLocalDatabaseWidget::deleteOldStudies()
 {
-    Settings settings;
-    // Mirem si està activada la opció de la configuració d'esborrar els estudis vells no visualitzats en un número de dies determinat
-    // fem la comprovació, per evitar engegar el thread si no s'han d'esborrar els estudis vells
-    if (settings.getValue(InputOutputSettings::DeleteLeastRecentlyUsedStudiesInDaysCriteria).toBool())
-    {
-        m_qdeleteOldStudiesThread.deleteOldStudies();
-    }
+    // Només es programa si està activada l'opció d'esborrar els estudis vells, i no comença fins al cap d'una estona per no endarrerir l'arrencada
+    m_oldStudiesHousekeeper.start();
 }
 
 QList<Image*> QInputOutputLocalDatabaseWidget::getAllImagesFromPatient(Patient *patient)
@@ -507,9 +504,18 @@ QList<Image*> QInputOutputLocalDatabaseWidget::getAllImagesFromPatient(Patient *
     return images;
 }
 
-void QInputOutputLocalDatabaseWidget::deleteOldStudiesThreadFinished()
+void QInputOutputLocalDatabaseWidget::oldStudiesHousekeeperFinished()
+{
+    showDatabaseManagerError(m_oldStudiesHousekeeper.getLastError(), tr("deleting old studies"));
+}
+
+void QInputOutputLocalDatabaseWidget::oldStudyDeleted(const QString &studyInstanceUID)
 {
-    showDatabaseManagerError(m_qdeleteOldStudiesThread.getLastError(), tr("deleting old studies"));
+    // Només es treu si és a la llista, perquè treure'n un estudi esborra la selecció de l'usuari
+    if (m_studyTreeWidget->getStudy(studyInstanceUID))
+    {
+        removeStudyFromQStudyTreeWidget(studyInstanceUID);
+    }
 }
 
 void QInputOutputLocalDatabaseWidget::qSplitterPositionChanged()
@@ -19,7 +19,7 @@
 #include "ui_qinputoutputlocaldatabasewidgetbase.h"
 
 #include "localdatabasemanager.h"
-#include "qdeleteoldstudiesthread.h"
+#include "oldstudieshousekeeper.h"
 #include "dicommask.h"
 #include "pacsdevice.h"
 #include "pacsjob.h"
@@ -101,7 +101,7 @@ private:
     /// Mostrar l'error que s'ha produït amb les operacions a la base de dades
     bool showDatabaseManagerError(LocalDatabaseManager::LastError error, const QString &doingWhat = "");
 
-    /// Esborra els estudis vells
+    /// Programa l'esborrat dels estudis vells en segon pla
     // TODO Aquesta responsabilitat d'esborrar els estudis vells al iniciar-se l'aplicació s'hauria de
     // traslladar a un altre lloc, no és responsabilitat d'aquesta inferfície
     void deleteOldStudies();
@@ -123,9 +123,12 @@ private slots:
     /// Esborra de la base de dades els estudis seleccionats en el QStudyTreeWidgetView
     void deleteSelectedItemsFromLocalDatabase();
 
-    /// Slot que es dispara quan ha finalitzat el thread que esborrar els estudis vells, aquest slot comprova que no s'hagi produït cap error esborrant
+    /// Slot que es dispara quan s'ha acabat l'esborrat dels estudis vells, aquest slot comprova que no s'hagi produït cap error esborrant
     /// els estudis vells
-    void deleteOldStudiesThreadFinished();
+    void oldStudiesHousekeeperFinished();
+
+    /// Treu de la llista l'estudi vell que s'acaba d'esborrar, si hi és
+    void oldStudyDeleted(const QString &studyInstanceUID);
 
     /// Afegeix els estudis seleccionats a la llista d'estudis a convertir a dicomdir
     void addSelectedStudiesToCreateDicomdirList();
@@ -154,7 +157,7 @@ private slots:
 
 private:
     QMenu m_contextMenuQStudyTreeWidget;
-    QDeleteOldStudiesThread m_qdeleteOldStudiesThread;
+    OldStudiesHousekeeper m_oldStudiesHousekeeper;
     QCreateDicomdir *m_qcreateDicomdir;
     StatsWatcher *m_statsWatcher;
     QWidgetSelectPacsToStoreDicomImage *m_qwidgetSelectPacsToStoreDicomImage;
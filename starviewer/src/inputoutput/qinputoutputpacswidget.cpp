@@ -139,6 +139,7 @@ void QInputOutputPacsWidget::enqueueQueryPACSJobToPACSManagerAndConnectSignals(P
 {
     connect(queryPACSJob.data(), SIGNAL(PACSJobFinished(PACSJobPointer)), SLOT(queryPACSJobFinished(PACSJobPointer)));
     connect(queryPACSJob.data(), SIGNAL(PACSJobCancelled(PACSJobPointer)), SLOT(queryPACSJobCancelled(PACSJobPointer)));
+    connect(queryPACSJob.data(), SIGNAL(queryResultsAvailable(PACSJobPointer)), SLOT(queryPACSJobResultsAvailable(PACSJobPointer)));
 
     m_pacsManager->enqueuePACSJob(queryPACSJob);
     m_queryPACSJobPendingExecuteOrExecuting.insert(queryPACSJob->getPACSJobID(), queryPACSJob);
@@ -199,41 +200,72 @@ void QInputOutputPacsWidget::queryPACSJobFinished(PACSJobPointer pacsJob)
     }
 }
 
+void QInputOutputPacsWidget::queryPACSJobResultsAvailable(PACSJobPointer pacsJob)
+{
+    // Els resultats de consultes que ja hem cancel·lat no s'han de mostrar
+    if (!m_queryPACSJobPendingExecuteOrExecuting.contains(pacsJob->getPACSJobID()))
+    {
+        return;
+    }
+
+    insertQueryPACSJobNewResults(pacsJob);
+}
+
 void QInputOutputPacsWidget::showQueryPACSJobResults(PACSJobPointer pacsJob)
 {
     QSharedPointer<QueryPacsJob> queryPACSJob = pacsJob.objectCast<QueryPacsJob>();
 
-    if (queryPACSJob->getQueryLevel() == QueryPacsJob::study)
+    // Afegim els resultats que han arribat després de l'última notificació
+    insertQueryPACSJobNewResults(pacsJob);
+
+    if (queryPACSJob->getNumberOfResults() == 0)
     {
-        m_studyTreeWidget->insertPatientList(queryPACSJob->getPatientStudyList());
+        if (queryPACSJob->getQueryLevel() == QueryPacsJob::series)
+        {
+            QString studyInstanceUID = queryPACSJob->getDicomMask().getStudyInstanceUID();
+            QMessageBox::information(this, ApplicationNameString, tr("No series match for this study %1.").arg(studyInstanceUID) + "\n");
+        }
+        else if (queryPACSJob->getQueryLevel() == QueryPacsJob::image)
+        {
+            QString seriesInstanceUID = queryPACSJob->getDicomMask().getSeriesInstanceUID();
+            QMessageBox::information(this, ApplicationNameString, tr("No images match series %1.").arg(seriesInstanceUID) + "\n");
+        }
     }
-    else if (queryPACSJob->getQueryLevel() == QueryPacsJob::series)
+}
+
+void QInputOutputPacsWidget::insertQueryPACSJobNewResults(PACSJobPointer pacsJob)
+{
+    QSharedPointer<QueryPacsJob> queryPACSJob = pacsJob.objectCast<QueryPacsJob>();
+
+    if (queryPACSJob.isNull())
     {
-        QList<Series*> seriesList = queryPACSJob->getSeriesList();
-        QString studyInstanceUID = queryPACSJob->getDicomMask().getStudyInstanceUID();
+        ERROR_LOG("El PACSJob del qual s'han de mostrar resultats no és un QueryPACSJob");
+        return;
+    }
 
-        if (seriesList.isEmpty())
+    if (queryPACSJob->getQueryLevel() == QueryPacsJob::study)
+    {
+        QList<Patient*> patientStudyList = queryPACSJob->getPatientStudyList();
+        if (!patientStudyList.isEmpty())
         {
-            QMessageBox::information(this, ApplicationNameString, tr("No series match for this study %1.").arg(studyInstanceUID) + "\n");
+            m_studyTreeWidget->insertPatientList(patientStudyList);
         }
-        else
+    }
+    else if (queryPACSJob->getQueryLevel() == QueryPacsJob::series)
+    {
+        QList<Series*> seriesList = queryPACSJob->getSeriesList();
+        if (!seriesList.isEmpty())
         {
-            m_studyTreeWidget->insertSeriesList(studyInstanceUID, seriesList);
+            m_studyTreeWidget->insertSeriesList(queryPACSJob->getDicomMask().getStudyInstanceUID(), seriesList);
         }
     }
     else if (queryPACSJob->getQueryLevel() == QueryPacsJob::image)
     {
         QList<Image*> imageList = queryPACSJob->getImageList();
-        QString studyInstanceUID = queryPACSJob->getDicomMask().getStudyInstanceUID();
-        QString seriesInstanceUID = queryPACSJob->getDicomMask().getSeriesInstanceUID();
-
-        if (imageList.isEmpty())
-        {
-            QMessageBox::information(this, ApplicationNameString, tr("No images match series %1.").arg(seriesInstanceUID) + "\n");
-        }
-        else
+        if (!imageList.isEmpty())
         {
-            m_studyTreeWidget->insertImageList(studyInstanceUID, seriesInstanceUID, imageList);
+            m_studyTreeWidget->insertImageList(queryPACSJob->getDicomMask().getStudyInstanceUID(), queryPACSJob->getDicomMask().getSeriesInstanceUID(),
+                                               imageList);
         }
     }
 }
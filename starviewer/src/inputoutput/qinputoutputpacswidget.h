@@ -107,6 +107,9 @@ private:
     /// Mostra per pantalla els resultats de la consulta al PACS d'un Job
     void showQueryPACSJobResults(PACSJobPointer queryPACSJob);
 
+    /// Afegeix al tree widget els resultats de la consulta al PACS d'un Job que encara no s'hi han afegit
+    void insertQueryPACSJobNewResults(PACSJobPointer queryPACSJob);
+
     /// Mostrar un QMessageBox indicant que s'ha produït un error consultant a un PACS
     void showErrorQueringPACS(PACSJobPointer queryPACSJob);
 
@@ -151,6 +154,9 @@ private slots:
     /// Slot que s'activa quan un job de consulta al PACS és cancel·lat
     void queryPACSJobCancelled(PACSJobPointer pacsJob);
 
+    /// Slot que s'activa quan un job de consulta al PACS que encara s'està executant té nous resultats
+    void queryPACSJobResultsAvailable(PACSJobPointer pacsJob);
+
 private:
     QMenu m_contextMenuQStudyTreeWidget;
     PacsManager *m_pacsManager;
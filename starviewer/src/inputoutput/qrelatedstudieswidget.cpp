@@ -255,6 +255,7 @@ void QRelatedStudiesWidget::initializeSearch()
 
 void QRelatedStudiesWidget::createConnections()
 {
+    connect(m_relatedStudiesManager, SIGNAL(studiesFound(QList<Study*>)), SLOT(studiesFound(QList<Study*>)));
     connect(m_relatedStudiesManager, SIGNAL(queryStudiesFinished(QList<Study*>)), SLOT(queryStudiesFinished(QList<Study*>)));
     connect(m_signalMapper, SIGNAL(mapped(const QString&)), SLOT(retrieveAndLoadStudy(const QString&)));
     connect(m_currentStudySignalMapper, SIGNAL(mapped(const QString&)), SLOT(currentStudyRadioButtonClicked(const QString&)));
@@ -456,6 +457,11 @@ void QRelatedStudiesWidget::insertStudiesToTree(const QList<Study*> &studiesList
     this->adjustSize();
 }
 
+void QRelatedStudiesWidget::studiesFound(const QList<Study*> &studiesList)
+{
+    insertStudiesToTree(studiesList);
+}
+
 void QRelatedStudiesWidget::queryStudiesFinished(const QList<Study *> &studiesList)
 {
     m_lookingForStudiesWidget->setVisible(false);
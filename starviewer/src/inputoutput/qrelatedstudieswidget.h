@@ -107,6 +107,9 @@ private:
     void insertStudiesToTree(const QList<Study*> &studiesList);
 
 private slots:
+    /// Slot executed when a PACS has answered the query with new studies
+    void studiesFound(const QList<Study*> &studiesList);
+
     /// Slot executed when the query is finished
     void queryStudiesFinished(const QList<Study*> &studiesList);
 
@@ -35,41 +35,33 @@ namespace udg {
 // Constant que contindrà quin Abanstract Syntax de Find utilitzem entre els diversos que hi ha utilitzem
 static const char *FindStudyAbstractSyntax = UID_FINDStudyRootQueryRetrieveInformationModel;
 
+const int QueryPacs::ResultsNotificationInterval = 100;
+
 QueryPacs::QueryPacs(PacsDevice pacsDevice)
- : DIMSECService()
+ : QObject(), DIMSECService()
 {
     m_pacsDevice = pacsDevice;
     m_pacsConnection = NULL;
     m_resultsDICOMSource.addRetrievePACS(pacsDevice);
-
-    m_patientStudyListGot = false;
-    m_seriesListGot = false;
-    m_imageListGot = false;
+    m_dicomTagReader = new DICOMTagReader();
+    m_numberOfImagesFound = 0;
 
     this->setUpAsCFind();
 }
 
 QueryPacs::~QueryPacs()
 {
-    //Esborrem els llistats de resultats de cerca que no ens hagin demanat a través dels mètodes get
-    if (!m_patientStudyListGot)
+    //Esborrem els resultats de cerca que no ens hagin demanat a través dels mètodes get
+    foreach(Patient *patient, m_patientStudyList)
     {
-        foreach(Patient *patient, m_patientStudyList)
-        {
-            qDeleteAll(patient->getStudies());
-            delete patient;
-        }
+        qDeleteAll(patient->getStudies());
+        delete patient;
     }
 
-    if (!m_seriesListGot)
-    {
-        qDeleteAll(m_seriesList);
-    }
+    qDeleteAll(m_seriesList);
+    qDeleteAll(m_imageList);
 
-    if (!m_imageListGot)
-    {
-        qDeleteAll(m_imageList);
-    }
+    delete m_dicomTagReader;
 }
 
 void QueryPacs::foundMatchCallback(void *callbackData, T_DIMSE_C_FindRQ *request, int responseCount, T_DIMSE_C_FindRSP *rsp,
@@ -95,7 +87,9 @@ void QueryPacs::foundMatchCallback(void *callbackData, T_DIMSE_C_FindRQ *request
     }
     else
     {
-        DICOMTagReader *dicomTagReader = new DICOMTagReader("", responseIdentifiers);
+        // Reaprofitem el mateix lector per totes les respostes. El dataset de resposta és de dcmtk, que l'esborra quan acaba el callback
+        DICOMTagReader *dicomTagReader = queryPacsCaller->m_dicomTagReader;
+        dicomTagReader->setDcmDataset("", responseIdentifiers);
         QString queryRetrieveLevel = dicomTagReader->getValueAttributeAsQString(DICOMQueryRetrieveLevel);
 
         if (queryRetrieveLevel == "STUDY")
@@ -116,6 +110,10 @@ void QueryPacs::foundMatchCallback(void *callbackData, T_DIMSE_C_FindRQ *request
             queryPacsCaller->addSeries(dicomTagReader);
             queryPacsCaller->addImage(dicomTagReader);
         }
+
+        dicomTagReader->takeDcmDataset();
+
+        queryPacsCaller->notifyNewResultsIfNeeded();
     }
 }
 
@@ -182,6 +180,13 @@ PACSRequestStatus::QueryRequestStatus QueryPacs::query(const DicomMask &mask)
 
     m_dicomMask = mask;
 
+    m_resultsMutex.lock();
+    m_studyInstanceUIDsFound.clear();
+    m_seriesInstanceUIDsFound.clear();
+    m_numberOfImagesFound = 0;
+    m_resultsMutex.unlock();
+    m_newResultsNotificationTimer.invalidate();
+
     return query();
 }
 
@@ -210,22 +215,39 @@ void QueryPacs::cancelQuery(T_DIMSE_C_FindRQ *request)
 
 void QueryPacs::addPatientStudy(DICOMTagReader *dicomTagReader)
 {
+    // A nivell de sèrie i d'imatge el PACS repeteix l'estudi a cada resposta, però només l'hem de crear la primera vegada
+    QString studyInstanceUID = dicomTagReader->getValueAttributeAsQString(DICOMStudyInstanceUID);
+    if (m_studyInstanceUIDsFound.contains(studyInstanceUID))
+    {
+        return;
+    }
+
     Patient *patient = CreateInformationModelObject::createPatient(dicomTagReader);
     Study *study = CreateInformationModelObject::createStudy(dicomTagReader);
     study->setInstitutionName(m_pacsDevice.getInstitution());
     study->setDICOMSource(m_resultsDICOMSource);
 
     patient->addStudy(study);
+
+    QMutexLocker locker(&m_resultsMutex);
+    m_studyInstanceUIDsFound.insert(studyInstanceUID);
     m_patientStudyList.append(patient);
 }
 
 void QueryPacs::addSeries(DICOMTagReader *dicomTagReader)
 {
+    // A nivell d'imatge el PACS repeteix la sèrie a cada resposta, però només l'hem de crear la primera vegada
+    QString seriesInstanceUID = dicomTagReader->getValueAttributeAsQString(DICOMSeriesInstanceUID);
+    if (m_seriesInstanceUIDsFound.contains(seriesInstanceUID))
+    {
+        return;
+    }
+
     Series *series = CreateInformationModelObject::createSeries(dicomTagReader);
     series->setDICOMSource(m_resultsDICOMSource);
 
-    // TODO: Si ens fan una cerca a nivell d'imatge inserirem la mateixa serie tantes vegades com images tenim, s'hauria de comprovar si ja conté
-    // la sèrie la llista abans d'afegir-la
+    QMutexLocker locker(&m_resultsMutex);
+    m_seriesInstanceUIDsFound.insert(seriesInstanceUID);
     m_seriesList.append(series);
 }
 
@@ -234,25 +256,63 @@ void QueryPacs::addImage(DICOMTagReader *dicomTagReader)
     Image *image = CreateInformationModelObject::createImage(dicomTagReader);
     image->setDICOMSource(m_resultsDICOMSource);
 
+    QMutexLocker locker(&m_resultsMutex);
     m_imageList.append(image);
+    m_numberOfImagesFound++;
+}
+
+void QueryPacs::notifyNewResultsIfNeeded()
+{
+    if (!m_newResultsNotificationTimer.isValid() || m_newResultsNotificationTimer.elapsed() >= ResultsNotificationInterval)
+    {
+        m_newResultsNotificationTimer.start();
+        emit newResultsAvailable();
+    }
 }
 
 QList<Patient*> QueryPacs::getQueryResultsAsPatientStudyList()
 {
-    m_patientStudyListGot = true;
-    return m_patientStudyList;
+    QMutexLocker locker(&m_resultsMutex);
+    QList<Patient*> patientStudyList;
+    patientStudyList.swap(m_patientStudyList);
+
+    return patientStudyList;
 }
 
 QList<Series*> QueryPacs::getQueryResultsAsSeriesList()
 {
-    m_seriesListGot = true;
-    return m_seriesList;
+    QMutexLocker locker(&m_resultsMutex);
+    QList<Series*> seriesList;
+    seriesList.swap(m_seriesList);
+
+    return seriesList;
 }
 
 QList<Image*> QueryPacs::getQueryResultsAsImageList()
 {
-    m_imageListGot = true;
-    return m_imageList;
+    QMutexLocker locker(&m_resultsMutex);
+    QList<Image*> imageList;
+    imageList.swap(m_imageList);
+
+    return imageList;
+}
+
+int QueryPacs::getNumberOfStudiesFound()
+{
+    QMutexLocker locker(&m_resultsMutex);
+    return m_studyInstanceUIDsFound.count();
+}
+
+int QueryPacs::getNumberOfSeriesFound()
+{
+    QMutexLocker locker(&m_resultsMutex);
+    return m_seriesInstanceUIDsFound.count();
+}
+
+int QueryPacs::getNumberOfImagesFound()
+{
+    QMutexLocker locker(&m_resultsMutex);
+    return m_numberOfImagesFound;
 }
 
 PACSRequestStatus::QueryRequestStatus QueryPacs::getDIMSEStatusCodeAsQueryRequestStatus(unsigned int dimseStatusCode)
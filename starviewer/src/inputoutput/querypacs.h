@@ -15,8 +15,12 @@
 #ifndef QUERYPACS
 #define QUERYPACS
 
+#include <QObject>
 #include <QList>
 #include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QElapsedTimer>
 #include <assoc.h>
 #include <dcdeftag.h>
 
@@ -42,7 +46,8 @@ class Image;
 class DICOMTagReader;
 class PACSConnection;
 
-class QueryPacs : public DIMSECService {
+class QueryPacs : public QObject, public DIMSECService {
+Q_OBJECT
 public:
     /// Constructor de la classe
     QueryPacs(PacsDevice pacsDevice);
@@ -57,13 +62,23 @@ public:
     /// cancel·la la query
     void cancelQuery();
 
-    ///Retornen els pacients amb els estudis trobats. La classe que demani els resultats de cerca d'estudis, és responsable d'eliminar els objects retornats aquest mètode
+    /// Retornen els resultats trobats que encara no s'han retornat, ja sigui mentre es fa la consulta o un cop acabada.
+    /// Cada resultat només es retorna una vegada i qui el demana passa a ser responsable d'eliminar-lo.
+    /// Els objectes pare es creen una sola vegada per UID, tot i que el PACS els repeteixi a cada resposta de nivell sèrie o imatge.
     QList<Patient*> getQueryResultsAsPatientStudyList();
-    ///Retornen les sèries trobades. La classe que demani els resultats de cerca de sèries, és responsable d'eliminar els objects retornats aquest mètode
     QList<Series*> getQueryResultsAsSeriesList();
-    ///Retornen les imatges trobades. La classe que demani els resultats de cerca d'imatge, és responsable d'eliminar els objects retornats aquest mètode
     QList<Image*> getQueryResultsAsImageList();
 
+    /// Retornen el nombre total d'estudis, sèries i imatges diferents trobats a la consulta actual, s'hagin retornat o no
+    int getNumberOfStudiesFound();
+    int getNumberOfSeriesFound();
+    int getNumberOfImagesFound();
+
+signals:
+    /// S'emet des del thread de la consulta quan hi ha nous resultats disponibles. Per no saturar qui els rep,
+    /// s'emet com a molt un cop cada ResultsNotificationInterval mil·lisegons, excepte pel primer resultat que es notifica de seguida.
+    void newResultsAvailable();
+
 private:
     /// Fa el query al pacs
     PACSRequestStatus::QueryRequestStatus query();
@@ -79,9 +94,12 @@ private:
     void addPatientStudy(DICOMTagReader *dicomTagReader);
     /// Afegeix l'objecte dicom a la llista de sèries si no hi existeix
     void addSeries(DICOMTagReader *dicomTagReader);
-    /// Afegeix l'objecte dicom a la llista d'imatges si no hi existeix
+    /// Afegeix l'objecte dicom a la llista d'imatges
     void addImage(DICOMTagReader *dicomTagReader);
 
+    /// Emet newResultsAvailable() si fa prou estona de l'última notificació
+    void notifyNewResultsIfNeeded();
+
     /// Converteix la respota rebuda per partl del PACS a QueryRequestStatus
     PACSRequestStatus::QueryRequestStatus getDIMSEStatusCodeAsQueryRequestStatus(unsigned int dimseStatusCode);
 
@@ -91,9 +109,25 @@ private:
     PacsDevice m_pacsDevice;
     PACSConnection *m_pacsConnection;
 
+    /// Resultats trobats que encara no s'han retornat. Es protegeixen amb m_resultsMutex perquè es poden demanar mentre es fa la consulta
     QList<Patient*> m_patientStudyList;
     QList<Series*> m_seriesList;
     QList<Image*> m_imageList;
+    QMutex m_resultsMutex;
+
+    /// UIDs dels estudis i sèries ja creats, per no tornar-los a crear per cada resposta de nivell inferior
+    QSet<QString> m_studyInstanceUIDsFound;
+    QSet<QString> m_seriesInstanceUIDsFound;
+    int m_numberOfImagesFound;
+
+    /// Lector que es reaprofita per totes les respostes de la consulta
+    DICOMTagReader *m_dicomTagReader;
+
+    /// Temps des de l'última vegada que s'ha emès newResultsAvailable()
+    QElapsedTimer m_newResultsNotificationTimer;
+
+    /// Interval mínim entre notificacions de nous resultats, en mil·lisegons
+    static const int ResultsNotificationInterval;
 
     // Flag que indica si s'ha de cancel·lar la query actual
     bool m_cancelQuery;
@@ -102,11 +136,6 @@ private:
 
     // Indicarà de quin PACS hem obtingut estudis, sèries, imatges
     DICOMSource m_resultsDICOMSource;
-
-    /// Indiquen si s'ha fet un get de la llista de resultats 
-    bool m_patientStudyListGot;
-    bool m_seriesListGot;
-    bool m_imageListGot;
 };
 };
 #endif
@@ -34,6 +34,9 @@ QueryPacsJob::QueryPacsJob(PacsDevice pacsDevice, DicomMask mask, QueryLevel que
     m_queryPacs = new QueryPacs(pacsDevice);
     m_mask = mask;
     m_queryLevel = queryLevel;
+
+    // La consulta s'executa en el thread del job, per tant la connexió ha de ser directa
+    connect(m_queryPacs, SIGNAL(newResultsAvailable()), SLOT(newQueryResultsAvailable()), Qt::DirectConnection);
 }
 
 QueryPacsJob::~QueryPacsJob()
@@ -75,22 +78,39 @@ QueryPacsJob::QueryLevel QueryPacsJob::getQueryLevel()
 
 QList<Patient*> QueryPacsJob::getPatientStudyList()
 {
-    Q_ASSERT (isFinished());
     return m_queryPacs->getQueryResultsAsPatientStudyList();
 }
 
 QList<Series*> QueryPacsJob::getSeriesList()
 {
-    Q_ASSERT (isFinished());
     return m_queryPacs->getQueryResultsAsSeriesList();
 }
 
 QList<Image*> QueryPacsJob::getImageList()
 {
-    Q_ASSERT (isFinished());
     return m_queryPacs->getQueryResultsAsImageList();
 }
 
+int QueryPacsJob::getNumberOfResults()
+{
+    switch (m_queryLevel)
+    {
+        case study:
+            return m_queryPacs->getNumberOfStudiesFound();
+        case series:
+            return m_queryPacs->getNumberOfSeriesFound();
+        case image:
+            return m_queryPacs->getNumberOfImagesFound();
+        default:
+            return 0;
+    }
+}
+
+void QueryPacsJob::newQueryResultsAvailable()
+{
+    emit queryResultsAvailable(m_selfPointer.toStrongRef());
+}
+
 void QueryPacsJob::requestCancelJob()
 {
     INFO_LOG(QString("S'ha demanat la cancel.lacio del Job de consulta al PACS %1").arg(getPacsDevice().getAETitle()));
@@ -59,24 +59,36 @@ public:
     /// Indica a quin nivell es fa la consulta study, series, image
     QueryLevel getQueryLevel();
 
-    /// Retorna la llista d'estudis trobats que compleixen el criteri de cerca. La classe que demani els resultats de cerca d'estudis, és responsable 
-    /// d'eliminar els objects retornats aquest mètode
+    /// Retorna la llista d'estudis trobats que compleixen el criteri de cerca i que encara no s'han retornat. Es pot cridar mentre s'executa la consulta,
+    /// per exemple en rebre queryResultsAvailable(), i un cop acabada per obtenir la resta. La classe que demani els resultats de cerca d'estudis, és
+    /// responsable d'eliminar els objects retornats aquest mètode
     QList<Patient*> getPatientStudyList();
 
-    /// Retorna la llista de series trobades que compleixen els criteris de cerca. La classe que demani els resultats de cerca de sèries és responsable 
-    /// d'eliminar els objects retornats aquest mètode
+    /// Retorna la llista de series trobades que compleixen els criteris de cerca i que encara no s'han retornat. La classe que demani els resultats de cerca
+    /// de sèries és responsable d'eliminar els objects retornats aquest mètode
     QList<Series*> getSeriesList();
 
-    /// Retorna la llista d'imatges trobades que compleixen els criteris de cerca. LLa classe que demani els resultats de cerca d'imatges, és responsable d'eliminar 
-    /// els objects retornats aquest mètode
+    /// Retorna la llista d'imatges trobades que compleixen els criteris de cerca i que encara no s'han retornat. La classe que demani els resultats de cerca
+    /// d'imatges, és responsable d'eliminar els objects retornats aquest mètode
     QList<Image*> getImageList();
 
+    /// Retorna el nombre total de resultats trobats del nivell de la consulta, s'hagin retornat o no
+    int getNumberOfResults();
+
     /// Retorna l'estat de la consulta
     PACSRequestStatus::QueryRequestStatus getStatus();
 
     /// Retorna una descripció de l'estat retornat per la consulta al PACS
     QString getStatusDescription();
 
+signals:
+    /// S'emet mentre s'executa la consulta quan hi ha nous resultats disponibles per obtenir amb getPatientStudyList(), getSeriesList() o getImageList()
+    void queryResultsAvailable(PACSJobPointer pacsJob);
+
+private slots:
+    /// Respon al signal newResultsAvailable de QueryPacs
+    void newQueryResultsAvailable();
+
 private:
     /// Demana que es cancel·li la consulta del job
     void requestCancelJob();
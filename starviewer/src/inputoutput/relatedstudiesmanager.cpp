@@ -24,14 +24,22 @@
 #include "logging.h"
 #include "querypacsjob.h"
 #include "inputoutputsettings.h"
+#include "relatedstudiesquerycache.h"
 
 namespace udg {
 
+const int RelatedStudiesManager::MaximumNumberOfSimultaneousQueries = 4;
+const int RelatedStudiesManager::QueryDeadline = 30000;
+
 RelatedStudiesManager::RelatedStudiesManager()
 {
     m_pacsManager = new PacsManager();
     m_studyInstanceUIDOfStudyToFindRelated = "invalid";
 
+    m_queryDeadlineTimer.setSingleShot(true);
+    m_queryDeadlineTimer.setInterval(QueryDeadline);
+    connect(&m_queryDeadlineTimer, SIGNAL(timeout()), SLOT(queryDeadlineReached()));
+
     Settings settings;
     m_searchRelatedStudiesByName = settings.getValue(InputOutputSettings::SearchRelatedStudiesByName).toBool();
 }
@@ -91,13 +99,41 @@ void RelatedStudiesManager::makeAsynchronousStudiesQuery(Patient *patient, QDate
             }
         }
 
+        RelatedStudiesQueryCache *queryResultsCache = SingletonPointer<RelatedStudiesQueryCache>::instance();
+        QList<Study*> studiesFoundInCache;
         foreach (const PacsDevice &pacsDevice, pacsDeviceListToQuery)
         {
             foreach (DicomMask queryDicomMask, queryDicomMasksList)
             {
-                enqueueQueryPACSJobToPACSManagerAndConnectSignals(PACSJobPointer(new QueryPacsJob(pacsDevice, queryDicomMask, QueryPacsJob::study)));
+                QString cacheKey = getQueryResultsCacheKey(pacsDevice, queryDicomMask);
+                if (queryResultsCache->contains(cacheKey))
+                {
+                    // Aquesta consulta s'ha fet fa poc, reaprofitem els resultats sense tornar a consultar el PACS
+                    studiesFoundInCache << mergeFoundStudies(queryResultsCache->getPatients(cacheKey));
+                }
+                else
+                {
+                    PACSJobPointer queryPACSJob(new QueryPacsJob(pacsDevice, queryDicomMask, QueryPacsJob::study));
+                    m_queryResultsCacheKeyByPACSJobID.insert(queryPACSJob->getPACSJobID(), cacheKey);
+                    m_queryPACSJobsWaitingToBeEnqueued << queryPACSJob;
+                }
             }
         }
+
+        if (!studiesFoundInCache.isEmpty())
+        {
+            emit studiesFound(studiesFoundInCache);
+        }
+
+        if (m_queryPACSJobsWaitingToBeEnqueued.isEmpty())
+        {
+            queryFinished();
+        }
+        else
+        {
+            m_queryDeadlineTimer.start();
+            enqueueWaitingQueryPACSJobs();
+        }
     }
 }
 
@@ -159,6 +195,14 @@ void RelatedStudiesManager::enqueueQueryPACSJobToPACSManagerAndConnectSignals(PA
     m_queryPACSJobPendingExecuteOrExecuting.insert(queryPACSJob->getPACSJobID(), queryPACSJob);
 }
 
+void RelatedStudiesManager::enqueueWaitingQueryPACSJobs()
+{
+    while (!m_queryPACSJobsWaitingToBeEnqueued.isEmpty() && m_queryPACSJobPendingExecuteOrExecuting.count() < MaximumNumberOfSimultaneousQueries)
+    {
+        enqueueQueryPACSJobToPACSManagerAndConnectSignals(m_queryPACSJobsWaitingToBeEnqueued.takeFirst());
+    }
+}
+
 void RelatedStudiesManager::cancelCurrentQuery()
 {
     foreach (PACSJobPointer queryPACSJob, m_queryPACSJobPendingExecuteOrExecuting)
@@ -167,12 +211,32 @@ void RelatedStudiesManager::cancelCurrentQuery()
         m_queryPACSJobPendingExecuteOrExecuting.remove(queryPACSJob->getPACSJobID());
     }
 
+    m_queryPACSJobsWaitingToBeEnqueued.clear();
+    m_queryResultsCacheKeyByPACSJobID.clear();
+    m_queryDeadlineTimer.stop();
+
     m_studyInstanceUIDOfStudyToFindRelated = "invalid";
 }
 
 bool RelatedStudiesManager::isExecutingQueries()
 {
-    return !m_queryPACSJobPendingExecuteOrExecuting.isEmpty();
+    return !m_queryPACSJobPendingExecuteOrExecuting.isEmpty() || !m_queryPACSJobsWaitingToBeEnqueued.isEmpty();
+}
+
+void RelatedStudiesManager::queryDeadlineReached()
+{
+    if (!isExecutingQueries())
+    {
+        return;
+    }
+
+    WARN_LOG(QString("Els PACS no han respost la consulta d'estudis relacionats en %1 ms, es cancel·len les consultes pendents").arg(QueryDeadline));
+
+    QString studyInstanceUIDOfStudyToFindRelated = m_studyInstanceUIDOfStudyToFindRelated;
+    cancelCurrentQuery();
+    m_studyInstanceUIDOfStudyToFindRelated = studyInstanceUIDOfStudyToFindRelated;
+
+    queryFinished();
 }
 
 void RelatedStudiesManager::queryPACSJobCancelled(PACSJobPointer pacsJob)
@@ -184,12 +248,15 @@ void RelatedStudiesManager::queryPACSJobCancelled(PACSJobPointer pacsJob)
     {
         ERROR_LOG("El PACSJob que s'ha cancel·lat no es un QueryPACSJob");
     }
-    else
+    else if (m_queryPACSJobPendingExecuteOrExecuting.contains(queryPACSJob->getPACSJobID()))
     {
         m_queryPACSJobPendingExecuteOrExecuting.remove(queryPACSJob->getPACSJobID());
+        m_queryResultsCacheKeyByPACSJobID.remove(queryPACSJob->getPACSJobID());
+        enqueueWaitingQueryPACSJobs();
 
-        if (m_queryPACSJobPendingExecuteOrExecuting.isEmpty())
+        if (!isExecutingQueries())
         {
+            m_queryDeadlineTimer.stop();
             queryFinished();
         }
     }
@@ -203,8 +270,9 @@ void RelatedStudiesManager::queryPACSJobFinished(PACSJobPointer pacsJob)
     {
         ERROR_LOG("El PACSJob que ha finalitzat no es un QueryPACSJob");
     }
-    else
+    else if (m_queryPACSJobPendingExecuteOrExecuting.contains(queryPACSJob->getPACSJobID()))
     {
+        // Els jobs que no són a la llista són de consultes ja cancel·lades i els seus resultats no s'han de tenir en compte
         if (queryPACSJob->getStatus() == PACSRequestStatus::QueryOk)
         {
             mergeFoundStudiesInQuery(pacsJob);
@@ -215,9 +283,12 @@ void RelatedStudiesManager::queryPACSJobFinished(PACSJobPointer pacsJob)
         }
 
         m_queryPACSJobPendingExecuteOrExecuting.remove(queryPACSJob->getPACSJobID());
+        m_queryResultsCacheKeyByPACSJobID.remove(queryPACSJob->getPACSJobID());
+        enqueueWaitingQueryPACSJobs();
 
-        if (m_queryPACSJobPendingExecuteOrExecuting.isEmpty())
+        if (!isExecutingQueries())
         {
+            m_queryDeadlineTimer.stop();
             queryFinished();
         }
     }
@@ -231,8 +302,24 @@ void RelatedStudiesManager::mergeFoundStudiesInQuery(PACSJobPointer queryPACSJob
         return;
     }
 
-    foreach (Patient *patient, queryPACSJob.objectCast<QueryPacsJob>()->getPatientStudyList())
+    QList<Patient*> patients = queryPACSJob.objectCast<QueryPacsJob>()->getPatientStudyList();
+    SingletonPointer<RelatedStudiesQueryCache>::instance()->insert(m_queryResultsCacheKeyByPACSJobID.value(queryPACSJob->getPACSJobID()), patients);
+
+    QList<Study*> newStudies = mergeFoundStudies(patients);
+    if (!newStudies.isEmpty())
     {
+        emit studiesFound(newStudies);
+    }
+}
+
+QList<Study*> RelatedStudiesManager::mergeFoundStudies(const QList<Patient*> &patients)
+{
+    QList<Study*> newStudies;
+
+    foreach (Patient *patient, patients)
+    {
+        m_queryResultPatients << patient;
+
         foreach (Study *study, patient->getStudies())
         {
             if (!isStudyInMergedStudyList(study) && !isMainStudy(study))
@@ -240,9 +327,18 @@ void RelatedStudiesManager::mergeFoundStudiesInQuery(PACSJobPointer queryPACSJob
                 // Si l'estudi no està a llista ja d'estudis afegits i no és el mateix estudi pel qua ens han demanat el
                 // previ l'afegim
                 m_mergedStudyList.append(study);
+                m_mergedStudyInstanceUIDs.insert(study->getInstanceUID());
+                newStudies.append(study);
             }
         }
     }
+
+    return newStudies;
+}
+
+QString RelatedStudiesManager::getQueryResultsCacheKey(const PacsDevice &pacsDevice, const DicomMask &dicomMask)
+{
+    return QString("%1\\%2\\%3").arg(pacsDevice.getID(), dicomMask.getPatientID(), dicomMask.getPatientName());
 }
 
 void RelatedStudiesManager::errorQueringPACS(PACSJobPointer queryPACSJob)
@@ -264,25 +360,14 @@ void RelatedStudiesManager::errorQueringPACS(PACSJobPointer queryPACSJob)
 
 void RelatedStudiesManager::queryFinished()
 {
-    // Quan totes les query han acabat és quant fem l'emit amb els estudis previs trobats. No podem emetre els resultats que anem rebent,
-    // perquè hem de fer un merge del resultats rebuts, per no tenir duplicats (Estudis del matiex pacient que estiguin a més d'un PACS)
+    // Quan totes les query han acabat fem l'emit amb tots els estudis previs trobats. Mentre es rebien, ja s'han anat emetent
+    // a studiesFound() els estudis nous després de fer-ne el merge, per no tenir duplicats (Estudis del matiex pacient que estiguin a més d'un PACS)
     emit queryStudiesFinished(m_mergedStudyList);
 }
 
-bool RelatedStudiesManager::isStudyInMergedStudyList(Study *study)
+bool RelatedStudiesManager::isStudyInMergedStudyList(Study *study) const
 {
-    bool studyFoundInMergedList = false;
-
-    foreach (Study *studyMerged, m_mergedStudyList)
-    {
-        if (study->getInstanceUID() == studyMerged->getInstanceUID())
-        {
-            studyFoundInMergedList = true;
-            break;
-        }
-    }
-
-    return studyFoundInMergedList;
+    return m_mergedStudyInstanceUIDs.contains(study->getInstanceUID());
 }
 
 bool RelatedStudiesManager::isMainStudy(Study *study)
@@ -366,17 +451,15 @@ void RelatedStudiesManager::retrieveAndApplyAction(Study *study, const PacsDevic
 
 void RelatedStudiesManager::deleteQueryResults()
 {
-    QList<Patient*> patientsStudy;
-
-    foreach (Study* study, m_mergedStudyList)
+    foreach (Patient *patient, m_queryResultPatients)
     {
-        patientsStudy.append(study->getParentPatient());
+        qDeleteAll(patient->getStudies());
+        delete patient;
     }
 
-    qDeleteAll(m_mergedStudyList);
-    qDeleteAll(patientsStudy);
-
     m_mergedStudyList.clear();
+    m_mergedStudyInstanceUIDs.clear();
+    m_queryResultPatients.clear();
 }
 
 QList<PacsDevice> RelatedStudiesManager::getPACSRetrievedStudiesOfPatient(Patient *patient)
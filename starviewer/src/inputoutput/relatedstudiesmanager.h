@@ -17,8 +17,10 @@
 
 #include <QObject>
 #include <QHash>
+#include <QSet>
 #include <QStringList>
 #include <QDate>
+#include <QTimer>
 
 #include "pacsdevice.h"
 #include "pacsjob.h"
@@ -35,6 +37,11 @@ class QueryPacsJob;
     Aquesta classe donat un Study demana els estudis relacionats o previs en els PACS configurats per defecte, degut a que
     ara actualment en el PACS podem tenir pacients que són el mateix però amb PatientID diferents, també a part de cercar estudis
     que coincideixin amb el PatientID també es farà una altre cerca per Patient Name.
+
+    Com a molt s'executen MaximumNumberOfSimultaneousQueries consultes alhora i, si passat QueryDeadline no han respost tots els PACS,
+    es cancel·la la resta i es dóna la consulta per acabada amb els estudis trobats fins llavors.
+    Els resultats de cada consulta correcta es guarden a RelatedStudiesQueryCache, compartida per totes les instàncies, de manera que
+    tornar a obrir el mateix pacient no torna a consultar els PACS. Cada instància treballa amb la seva pròpia còpia dels estudis.
   */
 /* TODO: En teoria amb la implantació del SAP els problemes de que un Pacient té diversos Patient ID o que té el nom
    escrit de maneres diferents haurien de desapareixer, per tant d'aquí un temps quan la majoria d'estudis del PACS
@@ -82,6 +89,10 @@ public:
     QList<Study*> getStudiesFromDatabase(Patient *patient);
 
 signals:
+    /// Signal que s'emet cada vegada que un PACS respon amb estudis que encara no s'havien trobat. La llista amb els resultats s'esborrarà
+    /// quan es demani una altra cerca.
+    void studiesFound(QList<Study*>);
+
     /// Signal que s'emet quan ha finalitzat la consulta d'estudis. La llista amb els resultats s'esborrarà quan es demani una altra cerca.
     void queryStudiesFinished(QList<Study*>);
 
@@ -103,7 +114,7 @@ private:
     /// Ens indica si aquell estudi està a la llista d'estudis ja rebuts, per evitar duplicats
     /// Hem de tenir en compte que com fem la cerca per ID i un altre per Patient Name per obtenir més resultats
     /// potser que en les dos consultes ens retornin el mateix estudi, per tant hem d'evitar duplicats.
-    bool isStudyInMergedStudyList(Study *study);
+    bool isStudyInMergedStudyList(Study *study) const;
 
     /// Ens indica si aquest estudi és el mateix pel qual ens han demanat els estudis relacionts, per evitar incloure'l a la llista
     bool isMainStudy(Study *study);
@@ -115,10 +126,20 @@ private:
     /// de hash on es guarden tots els QueryPACSJobs demanats per aquesta classe que estant pendents d'executar-se o s'estan executant
     void enqueueQueryPACSJobToPACSManagerAndConnectSignals(PACSJobPointer queryPACSJob);
 
+    /// Encua al PACSManager tants QueryPACSJobs en espera com permet MaximumNumberOfSimultaneousQueries
+    void enqueueWaitingQueryPACSJobs();
+
     /// Ens afegeix els estudis trobats en una llista, si algun dels estudis ja existeix a la llista perquè s'ha trobat en algun altre PACS no
-    /// se li afegeix
+    /// se li afegeix. Els resultats es guarden a la memòria cau i s'emet studiesFound() amb els estudis nous.
     void mergeFoundStudiesInQuery(PACSJobPointer queryPACSJob);
 
+    /// Afegeix a la llista d'estudis trobats els estudis dels pacients donats que no hi siguin i retorna els que s'han afegit.
+    /// Els pacients i els seus estudis passen a ser d'aquesta classe
+    QList<Study*> mergeFoundStudies(const QList<Patient*> &patients);
+
+    /// Retorna la clau de la memòria cau de resultats per una consulta al PACS amb la màscara donada
+    static QString getQueryResultsCacheKey(const PacsDevice &pacsDevice, const DicomMask &dicomMask);
+
     /// Emet signal indicant que la consulta a un PACS ha fallat
     void errorQueringPACS(PACSJobPointer queryPACSJob);
 
@@ -149,9 +170,21 @@ private slots:
     /// Slot que s'activa quan un job de consulta al PACS és cancel·lat
     void queryPACSJobCancelled(PACSJobPointer pacsJob);
 
+    /// Slot que s'activa quan s'exhaureix el temps màxim de la consulta
+    void queryDeadlineReached();
+
 private:
+    /// Nombre màxim de consultes als PACS que s'executen alhora
+    static const int MaximumNumberOfSimultaneousQueries;
+    /// Temps màxim, en mil·lisegons, que s'espera que responguin tots els PACS
+    static const int QueryDeadline;
+
     PacsManager *m_pacsManager;
     QList<Study*> m_mergedStudyList;
+    /// UIDs dels estudis de m_mergedStudyList
+    QSet<QString> m_mergedStudyInstanceUIDs;
+    /// Pacients de la consulta actual amb els seus estudis, inclosos els que no són a m_mergedStudyList. S'esborren a deleteQueryResults()
+    QList<Patient*> m_queryResultPatients;
 
     /// Study instance UID de l'estudi a partir del qual hem de trobar estudis relacionats
     QString m_studyInstanceUIDOfStudyToFindRelated;
@@ -162,6 +195,12 @@ private:
     QStringList m_pacsDeviceIDErrorEmited;
     /// Hash que ens guarda tots els QueryPACSJob pendent d'executar o que s'estan executant llançats des d'aquesta classe
     QHash<int, PACSJobPointer> m_queryPACSJobPendingExecuteOrExecuting;
+    /// QueryPACSJobs de la consulta actual que encara no s'han encuat al PACSManager
+    QList<PACSJobPointer> m_queryPACSJobsWaitingToBeEnqueued;
+    /// Clau de la memòria cau de resultats per cada QueryPACSJob de la consulta actual
+    QHash<int, QString> m_queryResultsCacheKeyByPACSJobID;
+    /// Temporitzador del temps màxim de la consulta
+    QTimer m_queryDeadlineTimer;
     /// Boolea per saber si s'ha de cercar estudis relacionats a partir del nom del pacient.
     bool m_searchRelatedStudiesByName;
 };
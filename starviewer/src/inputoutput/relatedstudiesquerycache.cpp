@@ -0,0 +1,174 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+#include "relatedstudiesquerycache.h"
+
+#include "patient.h"
+#include "study.h"
+
+namespace udg {
+
+const int RelatedStudiesQueryCache::DefaultLifetime = 5 * 60 * 1000;
+
+RelatedStudiesQueryCache::RelatedStudiesQueryCache(QObject *parent)
+ : QObject(parent), m_lifetime(DefaultLifetime)
+{
+}
+
+RelatedStudiesQueryCache::~RelatedStudiesQueryCache()
+{
+}
+
+void RelatedStudiesQueryCache::setLifetime(int lifetime)
+{
+    m_lifetime = lifetime;
+}
+
+int RelatedStudiesQueryCache::getLifetime() const
+{
+    return m_lifetime;
+}
+
+void RelatedStudiesQueryCache::insert(const QString &key, const QList<Patient*> &patients)
+{
+    QueryResults queryResults;
+    foreach (Patient *patient, patients)
+    {
+        queryResults.patients << getPatientData(patient);
+    }
+    queryResults.age.start();
+
+    m_queryResults.insert(key, queryResults);
+}
+
+bool RelatedStudiesQueryCache::contains(const QString &key)
+{
+    removeExpiredQueryResults();
+
+    return m_queryResults.contains(key);
+}
+
+QList<Patient*> RelatedStudiesQueryCache::getPatients(const QString &key)
+{
+    QList<Patient*> patients;
+
+    if (contains(key))
+    {
+        foreach (const PatientData &patientData, m_queryResults.value(key).patients)
+        {
+            patients << createPatient(patientData);
+        }
+    }
+
+    return patients;
+}
+
+int RelatedStudiesQueryCache::count() const
+{
+    return m_queryResults.count();
+}
+
+void RelatedStudiesQueryCache::clear()
+{
+    m_queryResults.clear();
+}
+
+void RelatedStudiesQueryCache::removeExpiredQueryResults()
+{
+    QHash<QString, QueryResults>::iterator iterator = m_queryResults.begin();
+    while (iterator != m_queryResults.end())
+    {
+        if (iterator->age.hasExpired(m_lifetime))
+        {
+            iterator = m_queryResults.erase(iterator);
+        }
+        else
+        {
+            ++iterator;
+        }
+    }
+}
+
+RelatedStudiesQueryCache::PatientData RelatedStudiesQueryCache::getPatientData(Patient *patient)
+{
+    PatientData patientData;
+    patientData.fullName = patient->getFullName();
+    patientData.id = patient->getID();
+    patientData.birthDate = patient->getBirthDate();
+    patientData.sex = patient->getSex();
+
+    foreach (Study *study, patient->getStudies())
+    {
+        StudyData studyData;
+        studyData.instanceUID = study->getInstanceUID();
+        studyData.id = study->getID();
+        studyData.accessionNumber = study->getAccessionNumber();
+        studyData.description = study->getDescription();
+        studyData.patientAge = study->getPatientAge();
+        studyData.weight = study->getWeight();
+        studyData.height = study->getHeight();
+        studyData.modalities = study->getModalities();
+        studyData.referringPhysiciansName = study->getReferringPhysiciansName();
+        studyData.date = study->getDate();
+        studyData.time = study->getTime();
+        studyData.institutionName = study->getInstitutionName();
+        studyData.dicomSource = study->getDICOMSource();
+
+        patientData.studies << studyData;
+    }
+
+    return patientData;
+}
+
+Patient* RelatedStudiesQueryCache::createPatient(const PatientData &patientData)
+{
+    Patient *patient = new Patient();
+    patient->setFullName(patientData.fullName);
+    patient->setID(patientData.id);
+    patient->setBirthDate(patientData.birthDate.toString("yyyyMMdd"));
+    patient->setSex(patientData.sex);
+
+    foreach (const StudyData &studyData, patientData.studies)
+    {
+        Study *study = new Study();
+        study->setInstanceUID(studyData.instanceUID);
+        study->setID(studyData.id);
+        study->setAccessionNumber(studyData.accessionNumber);
+        study->setDescription(studyData.description);
+        study->setPatientAge(studyData.patientAge);
+        study->setWeight(studyData.weight);
+        study->setHeight(studyData.height);
+        foreach (const QString &modality, studyData.modalities)
+        {
+            study->addModality(modality);
+        }
+        study->setReferringPhysiciansName(studyData.referringPhysiciansName);
+        if (studyData.date.isValid())
+        {
+            study->setDate(studyData.date);
+        }
+        if (studyData.time.isValid())
+        {
+            study->setTime(studyData.time);
+        }
+        study->setInstitutionName(studyData.institutionName);
+        study->setDICOMSource(studyData.dicomSource);
+
+        patient->addStudy(study);
+    }
+
+    return patient;
+}
+
+}
@@ -0,0 +1,120 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+#ifndef UDGRELATEDSTUDIESQUERYCACHE_H
+#define UDGRELATEDSTUDIESQUERYCACHE_H
+
+#include <QObject>
+#include <QDate>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
+#include <QTime>
+
+#include "dicomsource.h"
+
+namespace udg {
+
+class Patient;
+
+/**
+    Memòria cau dels resultats de les consultes d'estudis relacionats als PACS.
+
+    Es guarda només la informació dels pacients i estudis trobats, no els objectes Patient i Study, de manera que cada
+    RelatedStudiesManager treballa amb els seus propis objectes i en pot fer el que vulgui sense afectar els altres.
+    Un resultat deixa de ser vàlid quan ha passat més temps del temps de vida des que s'ha guardat.
+
+    S'ha d'utilitzar des del thread principal, a través de SingletonPointer<RelatedStudiesQueryCache>, per tal que es destrueixi
+    abans que la QApplication.
+  */
+class RelatedStudiesQueryCache : public QObject {
+Q_OBJECT
+public:
+    RelatedStudiesQueryCache(QObject *parent = 0);
+    ~RelatedStudiesQueryCache();
+
+    /// Assigna/Obté el temps de vida, en mil·lisegons, dels resultats guardats
+    void setLifetime(int lifetime);
+    int getLifetime() const;
+
+    /// Guarda la informació dels pacients i els seus estudis com a resultat de la consulta amb la clau donada.
+    /// Els objectes continuen essent de qui crida
+    void insert(const QString &key, const QList<Patient*> &patients);
+
+    /// Indica si hi ha un resultat vàlid per la consulta amb la clau donada
+    bool contains(const QString &key);
+
+    /// Retorna pacients nous, amb els seus estudis, creats a partir del resultat guardat per la clau donada.
+    /// Qui crida es fa responsable d'esborrar-los. Si no hi ha cap resultat vàlid retorna una llista buida
+    QList<Patient*> getPatients(const QString &key);
+
+    /// Retorna el nombre de resultats guardats, inclosos els que poden haver caducat
+    int count() const;
+
+    /// Esborra tots els resultats guardats
+    void clear();
+
+private:
+    /// Informació d'un estudi trobat
+    struct StudyData
+    {
+        QString instanceUID;
+        QString id;
+        QString accessionNumber;
+        QString description;
+        QString patientAge;
+        double weight;
+        double height;
+        QStringList modalities;
+        QString referringPhysiciansName;
+        QDate date;
+        QTime time;
+        QString institutionName;
+        DICOMSource dicomSource;
+    };
+
+    /// Informació d'un pacient trobat amb els seus estudis
+    struct PatientData
+    {
+        QString fullName;
+        QString id;
+        QDate birthDate;
+        QString sex;
+        QList<StudyData> studies;
+    };
+
+    /// Resultat d'una consulta
+    struct QueryResults
+    {
+        QList<PatientData> patients;
+        QElapsedTimer age;
+    };
+
+    /// Esborra els resultats que han superat el temps de vida
+    void removeExpiredQueryResults();
+
+    static PatientData getPatientData(Patient *patient);
+    static Patient* createPatient(const PatientData &patientData);
+
+private:
+    /// Temps de vida per defecte dels resultats, en mil·lisegons
+    static const int DefaultLifetime;
+
+    QHash<QString, QueryResults> m_queryResults;
+    int m_lifetime;
+};
+
+}
+
+#endif // UDGRELATEDSTUDIESQUERYCACHE_H
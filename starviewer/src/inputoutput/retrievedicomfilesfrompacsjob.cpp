@@ -34,6 +34,9 @@
 #include "portinuse.h"
 #include "dicomsource.h"
 #include "usermessage.h"
+#include "coresettings.h"
+#include "dcmdatasetcache.h"
+#include "singleton.h"
 
 namespace udg {
 
@@ -108,7 +111,21 @@ void RetrieveDICOMFilesFromPACSJob::run(ThreadWeaver::JobPointer self, ThreadWea
         connect(m_retrieveDICOMFilesFromPACS, SIGNAL(DICOMFileRetrieved(DICOMTagReader*, int)), this, SLOT(DICOMFileRetrieved(DICOMTagReader*, int)),
                 Qt::DirectConnection);
         // Connectem amb els signals del patientFiller per processar els fitxers descarregats
-        connect(this, &RetrieveDICOMFilesFromPACSJob::DICOMTagReaderReadyForProcess, &patientFiller, &PatientFiller::processDICOMFile);
+        bool keepRetrievedImagesInMemory = settings.getValue(CoreSettings::KeepRetrievedImagesInMemory).toBool();
+        if (keepRetrievedImagesInMemory)
+        {
+            SingletonPointer<DcmDatasetCache>::instance()->setMaximumSize(settings.getValue(CoreSettings::RetrievedImagesMemoryPoolSize).toLongLong() * 1024 * 1024);
+        }
+        connect(this, &RetrieveDICOMFilesFromPACSJob::DICOMTagReaderReadyForProcess, &patientFiller,
+                [&patientFiller, keepRetrievedImagesInMemory](DICOMTagReader *dicomTagReader) {
+            patientFiller.processDICOMFile(dicomTagReader);
+
+            if (keepRetrievedImagesInMemory)
+            {
+                // Un cop processat, els fillers ja no fan servir el dataset i el podem passar a la cache sense haver-ne de fer una còpia
+                SingletonPointer<DcmDatasetCache>::instance()->insert(dicomTagReader->getFileName(), dicomTagReader->takeDcmDataset());
+            }
+        });
         connect(this, SIGNAL(DICOMFilesRetrieveFinished()), &patientFiller, SLOT(finishDICOMFilesProcess()));
         // Connexió entre el processat dels fitxers DICOM i l'inserció al a BD, és important que aquest signal sigui un Qt:DirectConnection perquè així el
         // el processa els thread dels fillers, d'aquesta manera el thread de descarrega que està esperant a fillersThread.wait() quan surt
@@ -19,7 +19,6 @@
 // Qt
 #include <QFileDialog>
 #include <QFileInfo>
-#include <QMessageBox>
 // itk
 #include <itkObject.h> //Necessari per desactivar els warnings en release
 // Recursos
@@ -80,69 +79,8 @@ void AppImportFile::openDirectory(bool recursively)
         m_workingDicomDirectory = directoryName;
         writeSettings();
 
-        // Llista on guardarem tots els arxius compatibles que hi ha als directoris
-        QStringList filenames;
-        if (recursively)
-        {
-            // Explorem recursivament tots els directoris
-            QStringList dirList;
-            scanDirectories(directoryName, dirList);
-            // Per cada directori, obtenim els arxius que podem tractar
-            foreach (const QString &dirName, dirList)
-            {
-                filenames << generateFilenames(dirName);
-            }
-        }
-        else
-        {
-            // Tindrem en compte únicament els arxius que hi hagi en el directori arrel sense explorar recursivament
-            filenames << generateFilenames(directoryName);
-        }
-
-        if (!filenames.isEmpty())
-        {
-            emit selectedFiles(filenames);
-        }
-        else
-        {
-            QMessageBox::warning(0, ApplicationNameString, tr("No supported input files found"));
-        }
-    }
-}
-
-QStringList AppImportFile::generateFilenames(const QString &dirPath)
-{
-    QStringList list;
-    // Comprovem que el directori tingui arxius
-    QDir dir(dirPath);
-    QFileInfoList fileInfoList = dir.entryInfoList(QDir::Files);
-
-    // Afegim a la llista cadascun dels paths absoluts dels arxius que contingui el directori
-    foreach (const QFileInfo &fileInfo, fileInfoList)
-    {
-        list << fileInfo.absoluteFilePath();
-    }
-
-    return list;
-}
-
-void AppImportFile::scanDirectories(const QString &rootPath, QStringList &dirsList)
-{
-    QDir rootDir(rootPath);
-    if (rootDir.exists())
-    {
-        // Afegim el directori actual a la llista
-        dirsList << rootPath;
-        // Busquem si tenim més directoris
-        QStringList subdirs = rootDir.entryList(QDir::AllDirs | QDir::NoDotAndDotDot);
-        if (!subdirs.isEmpty())
-        {
-            // Per cada subdirectori escanejem recursivament
-            foreach (const QString &subDir, subdirs)
-            {
-                scanDirectories(rootPath + "/" + subDir, dirsList);
-            }
-        }
+        // L'exploració del directori es fa mentre es llegeixen els fitxers, fora del thread de la GUI
+        emit selectedDirectory(directoryName, recursively);
     }
 }
 
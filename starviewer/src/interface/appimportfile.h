@@ -40,16 +40,11 @@ signals:
     /// Senyal que s'emet quan s'han escollit un o més arxius que seran processats externament
     void selectedFiles(QStringList);
 
-private:
-    /// Ens retorna la llista d'arxius DICOM agrupables en series d'un directori
-    /// @param directory Nom del directori on es troben els arxius
-    /// @return La llista de noms de fitxers ordenada
-    QStringList generateFilenames(const QString &dirPath);
-
-    /// Donat un path arrel, escaneja tots els subdirectoris recursivament i ens els retorna en una llista incloent el path arrel
-    /// Tots els paths retornats, són absoluts
-    void scanDirectories(const QString &rootPath, QStringList &dirsList);
+    /// Senyal que s'emet quan s'ha escollit un directori els arxius del qual seran processats externament
+    /// @param recursively Indica si també s'han de processar els arxius dels subdirectoris
+    void selectedDirectory(const QString &directory, bool recursively);
 
+private:
     /// Llegeix escriu configuracions
     void readSettings();
     void writeSettings();
@@ -37,7 +37,7 @@
 
 // PACS --------------------------------------------
 #include "queryscreen.h"
-#include "patientfiller.h"
+#include "patientloaderthread.h"
 
 namespace udg {
 
@@ -207,6 +207,7 @@ ExtensionContext &ExtensionHandler::getContext()
 void ExtensionHandler::createConnections()
 {
     connect(&m_importFileApp, SIGNAL(selectedFiles(QStringList)), SLOT(processInput(QStringList)));
+    connect(&m_importFileApp, SIGNAL(selectedDirectory(QString, bool)), SLOT(processInputDirectory(QString, bool)));
 }
 
 void ExtensionHandler::processInput(const QStringList &inputFiles)
@@ -216,21 +217,57 @@ void ExtensionHandler::processInput(const QStringList &inputFiles)
         return;
     }
 
-    QProgressDialog progressDialog(m_mainApp);
-    progressDialog.setModal(true);
-    progressDialog.setRange(0, 0);
-    progressDialog.setMinimumDuration(0);
-    progressDialog.setWindowTitle(tr("Patient Loading"));
-    progressDialog.setLabelText(tr("Loading, please wait..."));
-    progressDialog.setCancelButton(0);
+    createPatientLoader()->loadFiles(inputFiles);
+}
+
+void ExtensionHandler::processInputDirectory(const QString &directory, bool recursively)
+{
+    createPatientLoader()->loadDirectory(directory, recursively);
+}
+
+PatientLoaderThread* ExtensionHandler::createPatientLoader()
+{
+    PatientLoaderThread *patientLoader = new PatientLoaderThread(this);
+
+    // El diàleg no és modal: la lectura es fa en un altre thread i la interfície continua responent mentrestant
+    QProgressDialog *progressDialog = new QProgressDialog(m_mainApp);
+    progressDialog->setRange(0, 0);
+    progressDialog->setMinimumDuration(0);
+    progressDialog->setWindowTitle(tr("Patient Loading"));
+    progressDialog->setLabelText(tr("Loading, please wait..."));
+
+    connect(patientLoader, SIGNAL(progress(int)), progressDialog, SLOT(setValue(int)));
+    connect(progressDialog, SIGNAL(canceled()), patientLoader, SLOT(cancel()));
+    connect(patientLoader, SIGNAL(finished()), progressDialog, SLOT(deleteLater()));
+    connect(patientLoader, SIGNAL(finished()), SLOT(patientLoaderFinished()));
+
+    progressDialog->show();
+
+    return patientLoader;
+}
 
-    qApp->processEvents();
-    PatientFiller patientFiller;
-    connect(&patientFiller, SIGNAL(progress(int)), &progressDialog, SLOT(setValue(int)));
+void ExtensionHandler::patientLoaderFinished()
+{
+    PatientLoaderThread *patientLoader = qobject_cast<PatientLoaderThread*>(sender());
+    if (!patientLoader)
+    {
+        return;
+    }
+    // Els pacients que no s'agafin s'esborraran amb el loader
+    patientLoader->deleteLater();
 
-    QList<Patient*> patientsList = patientFiller.processFiles(inputFiles);
+    if (patientLoader->isInterruptionRequested())
+    {
+        return;
+    }
+
+    if (patientLoader->getNumberOfFilesFound() == 0)
+    {
+        QMessageBox::warning(0, ApplicationNameString, tr("No supported input files found"));
+        return;
+    }
 
-    progressDialog.close();
+    QList<Patient*> patientsList = patientLoader->takePatients();
 
     int numberOfPatients = patientsList.size();
 
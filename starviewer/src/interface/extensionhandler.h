@@ -27,6 +27,7 @@ namespace udg {
 
 // Fordward Declarations
 class QApplicationMainWindow;
+class PatientLoaderThread;
 
 /**
     Gestor de mini-aplicacions i serveis de l'aplicació principal
@@ -60,6 +61,12 @@ private slots:
     /// @param inputFiles Els arxius a processar, que poden ser del tipus suportat per l'aplicació o no
     void processInput(const QStringList &inputFiles);
 
+    /// Igual que processInput(const QStringList&) però amb els arxius del directori donat, explorant els subdirectoris si recursively és cert
+    void processInputDirectory(const QString &directory, bool recursively);
+
+    /// Es crida quan un PatientLoaderThread ha acabat de llegir els pacients. Continua amb el processat dels pacients llegits.
+    void patientLoaderFinished();
+
     /// Donada una llista de pacients d'entrada, s'encarrega de posar a punt
     /// aquests i assignar-lis la finestra adequada, decidint si obrir noves finestres
     /// i/o fusionar o matxacar el pacient actual d'aquesta finestra.
@@ -75,6 +82,9 @@ private:
     /// Crea les connexions de signals i slots
     void createConnections();
 
+    /// Crea un PatientLoaderThread amb el seu diàleg de progrés i les connexions per processar els pacients quan acabi
+    PatientLoaderThread* createPatientLoader();
+
     /// Afegeix un pacient a una mainwindow tenint en compte si cal fusionar o no i si es pot reemplaçar el pacient actual ja carregat
     /// Afegim un segon paràmetre que ens indica si els pacients a processar només cal carregar-los o fer-ne un "view"
     /// Retorna la mainwindow a on s'ha afegit el pacient.
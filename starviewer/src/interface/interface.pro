@@ -12,6 +12,7 @@ FORMS += qconfigurationdialogbase.ui \
 HEADERS += qapplicationmainwindow.h \
            interfacesettings.h \
            appimportfile.h \
+           patientloaderthread.h \
            extensionhandler.h \
            extensionworkspace.h \
            qconfigurationdialog.h \
@@ -22,6 +23,7 @@ HEADERS += qapplicationmainwindow.h \
 SOURCES += qapplicationmainwindow.cpp \
            interfacesettings.cpp \
            appimportfile.cpp \
+           patientloaderthread.cpp \
            extensionhandler.cpp \
            extensionworkspace.cpp \
            qconfigurationdialog.cpp \
@@ -0,0 +1,195 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+#include "patientloaderthread.h"
+
+#include "dicomtagreader.h"
+#include "image.h"
+#include "logging.h"
+#include "patient.h"
+#include "patientfiller.h"
+
+#include <QCoreApplication>
+#include <QDirIterator>
+#include <QMap>
+
+namespace udg {
+
+PatientLoaderThread::PatientLoaderThread(QObject *parent)
+ : QThread(parent), m_recursively(false), m_numberOfFilesFound(0)
+{
+}
+
+PatientLoaderThread::~PatientLoaderThread()
+{
+    cancel();
+    wait();
+
+    // Els pacients que no s'hagin arribat a demanar són nostres
+    qDeleteAll(m_patients);
+}
+
+void PatientLoaderThread::loadFiles(const QStringList &files)
+{
+    m_files = files;
+    m_directory.clear();
+    start();
+}
+
+void PatientLoaderThread::loadDirectory(const QString &directory, bool recursively)
+{
+    m_files.clear();
+    m_directory = directory;
+    m_recursively = recursively;
+    start();
+}
+
+int PatientLoaderThread::getNumberOfFilesFound() const
+{
+    return m_numberOfFilesFound;
+}
+
+QList<Patient*> PatientLoaderThread::takePatients()
+{
+    QList<Patient*> patients = m_patients;
+    m_patients.clear();
+    return patients;
+}
+
+void PatientLoaderThread::cancel()
+{
+    requestInterruption();
+}
+
+void PatientLoaderThread::run()
+{
+    m_numberOfFilesFound = 0;
+
+    loadPatients();
+
+    if (isInterruptionRequested())
+    {
+        INFO_LOG("S'ha cancel·lat la càrrega de pacients");
+        qDeleteAll(m_patients);
+        m_patients.clear();
+        return;
+    }
+
+    prepareThumbnails();
+
+    // Els pacients s'han creat en aquest thread. Els passem al thread principal perquè s'hi puguin fusionar amb altres pacients,
+    // ja que en fusionar-los es canvia el parent dels estudis. Els estudis, sèries i imatges en són fills i es mouen amb el pacient.
+    foreach (Patient *patient, m_patients)
+    {
+        patient->moveToThread(QCoreApplication::instance()->thread());
+    }
+}
+
+void PatientLoaderThread::loadPatients()
+{
+    PatientFiller patientFiller;
+    QStringList mhdFiles;
+
+    if (m_directory.isEmpty())
+    {
+        foreach (const QString &file, m_files)
+        {
+            if (isInterruptionRequested())
+            {
+                break;
+            }
+            processFile(patientFiller, file, mhdFiles);
+        }
+    }
+    else
+    {
+        // Els fitxers es van processant a mesura que es troben, sense esperar a tenir enumerat tot el directori
+        QDirIterator::IteratorFlags flags = m_recursively ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags;
+        QDirIterator iterator(m_directory, QDir::Files, flags);
+
+        while (iterator.hasNext())
+        {
+            if (isInterruptionRequested())
+            {
+                break;
+            }
+            processFile(patientFiller, iterator.next(), mhdFiles);
+        }
+    }
+
+    if (isInterruptionRequested())
+    {
+        // PatientFiller no esborra els pacients que ha omplert fins ara, ho farà run() en veure que s'ha cancel·lat
+        m_patients = patientFiller.getPatients();
+        return;
+    }
+
+    patientFiller.finishDICOMFilesProcess();
+    m_patients = patientFiller.getPatients();
+
+    if (!mhdFiles.isEmpty())
+    {
+        PatientFiller mhdPatientFiller;
+        m_patients << mhdPatientFiller.processFiles(mhdFiles);
+    }
+}
+
+void PatientLoaderThread::processFile(PatientFiller &patientFiller, const QString &file, QStringList &mhdFiles)
+{
+    m_numberOfFilesFound++;
+
+    // Els fitxers MHD es processen tots junts al final
+    if (file.endsWith(".mhd", Qt::CaseInsensitive))
+    {
+        mhdFiles << file;
+    }
+    else
+    {
+        // El PatientFillerInput s'encarrega d'esborrar el DICOMTagReader
+        patientFiller.processDICOMFile(new DICOMTagReader(file));
+    }
+
+    emit progress(m_numberOfFilesFound);
+}
+
+void PatientLoaderThread::prepareThumbnails()
+{
+    // Es creen els mateixos thumbnails que ExtensionHandler::generatePatientVolumes() assignarà a cada volum,
+    // és a dir, el de la imatge del mig de cada volum de les sèries visualitzables
+    foreach (Patient *patient, m_patients)
+    {
+        foreach (Study *study, patient->getStudies())
+        {
+            foreach (Series *series, study->getViewableSeries())
+            {
+                QMap<int, QList<Image*> > volumesImages;
+                foreach (Image *image, series->getImages())
+                {
+                    volumesImages[image->getVolumeNumberInSeries()] << image;
+                }
+
+                foreach (const QList<Image*> &imageList, volumesImages)
+                {
+                    if (isInterruptionRequested())
+                    {
+                        return;
+                    }
+                    imageList.at(imageList.count() / 2)->getThumbnailImage(true);
+                }
+            }
+        }
+    }
+}
+
+}
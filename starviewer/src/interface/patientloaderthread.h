@@ -0,0 +1,87 @@
+/*************************************************************************************
+  Copyright (C) 2014 Laboratori de Gràfics i Imatge, Universitat de Girona &
+  Institut de Diagnòstic per la Imatge.
+  Girona 2014. All rights reserved.
+  http://starviewer.udg.edu
+
+  This file is part of the Starviewer (Medical Imaging Software) open source project.
+  It is subject to the license terms in the LICENSE file found in the top-level
+  directory of this distribution and at http://starviewer.udg.edu/license. No part of
+  the Starviewer (Medical Imaging Software) open source project, including this file,
+  may be copied, modified, propagated, or distributed except according to the
+  terms contained in the LICENSE file.
+ *************************************************************************************/
+
+#ifndef UDGPATIENTLOADERTHREAD_H
+#define UDGPATIENTLOADERTHREAD_H
+
+#include <QThread>
+
+#include <QStringList>
+
+namespace udg {
+
+class Patient;
+class PatientFiller;
+
+/**
+    Classe encarregada de llegir en un thread els pacients d'un conjunt de fitxers o d'un directori.
+    Els directoris s'exploren a mesura que es van llegint els fitxers, de manera que no cal esperar a tenir-los tots enumerats
+    per començar a processar-los. També es preparen els thumbnails dels volums perquè no s'hagin de crear al thread de la GUI.
+    Quan acaba s'emet finished() i els pacients es poden obtenir amb takePatients().
+  */
+class PatientLoaderThread : public QThread {
+Q_OBJECT
+public:
+    PatientLoaderThread(QObject *parent = 0);
+    ~PatientLoaderThread();
+
+    /// Comença a llegir els pacients dels fitxers donats
+    void loadFiles(const QStringList &files);
+
+    /// Comença a llegir els pacients dels fitxers del directori donat, explorant els subdirectoris si recursively és cert
+    void loadDirectory(const QString &directory, bool recursively);
+
+    /// Retorna el nombre de fitxers que s'han trobat. Només s'ha de cridar un cop ha acabat el thread.
+    int getNumberOfFilesFound() const;
+
+    /// Retorna els pacients llegits i en cedeix la propietat. Només s'ha de cridar un cop ha acabat el thread.
+    QList<Patient*> takePatients();
+
+public slots:
+    /// Demana cancel·lar la càrrega. Els pacients llegits fins al moment es descarten.
+    void cancel();
+
+signals:
+    /// S'emet cada cop que s'ha processat un fitxer
+    void progress(int numberOfProcessedFiles);
+
+private:
+    /// Mètode executat pel thread
+    void run();
+
+    /// Llegeix els fitxers de m_files o de m_directory segons el que s'hagi demanat
+    void loadPatients();
+
+    /// Processa el fitxer donat amb el patient filler donat si és DICOM, o l'afegeix a mhdFiles si és MHD
+    void processFile(PatientFiller &patientFiller, const QString &file, QStringList &mhdFiles);
+
+    /// Crea els thumbnails que s'assignaran a cada volum dels pacients llegits
+    void prepareThumbnails();
+
+private:
+    /// Fitxers o directori a llegir
+    QStringList m_files;
+    QString m_directory;
+    bool m_recursively;
+
+    /// Nombre de fitxers trobats
+    int m_numberOfFilesFound;
+
+    /// Pacients llegits
+    QList<Patient*> m_patients;
+};
+
+}
+
+#endif
@@ -45,8 +45,6 @@
 
 // Amb starviewer lite no hi haurà hanging protocols, per tant no els carregarem
 #ifndef STARVIEWER_LITE
-#include "hangingprotocolsloader.h"
-#include "customwindowlevelsloader.h"
 #include "studylayoutconfigsloader.h"
 #endif
 
@@ -122,15 +120,10 @@ QApplicationMainWindow::QApplicationMainWindow(QWidget *parent)
 #ifndef STARVIEWER_LITE
     // Càrrega dels repositoris que necessitem tenir carregats durant tota l'aplicació
     // Només carregarem un cop per sessió/instància d'starviewer
+    // Els hanging protocols i els custom window levels es carreguen el primer cop que es necessiten
     static bool repositoriesLoaded = false;
     if (!repositoriesLoaded)
     {
-        HangingProtocolsLoader hangingProtocolsLoader;
-        hangingProtocolsLoader.loadDefaults();
-
-        CustomWindowLevelsLoader customWindowLevelsLoader;
-        customWindowLevelsLoader.loadDefaults();
-
         StudyLayoutConfigsLoader layoutConfigsLoader;
         layoutConfigsLoader.load();
 
@@ -12,7 +12,7 @@ CREATE TABLE DatabaseRevision
 -- IMPORTANT!!! Cal canviar el número de revisió per un de superior cada vegada que es faci un canvi a aquest fitxer i calgui
 -- que la BD s'actualitzi
 
-INSERT INTO DatabaseRevision (Revision) VALUES ('9593');
+INSERT INTO DatabaseRevision (Revision) VALUES ('9594');
 
 CREATE TABLE PACSRetrievedImages
 (
@@ -54,6 +54,8 @@ CREATE TABLE Study
   State                         INTEGER
 );
 
+CREATE INDEX  IndexStudy_LastAccessDate ON Study (LastAccessDate);
+
 CREATE TABLE Series
 (
   InstanceUID                   TEXT PRIMARY KEY,
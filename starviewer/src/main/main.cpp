@@ -32,6 +32,7 @@ INITIALIZE_EASYLOGGINGPP
 #include "coresettings.h"
 #include "inputoutputsettings.h"
 #include "interfacesettings.h"
+#include "settingscache.h"
 #include "shortcuts.h"
 #include "starviewerapplicationcommandline.h"
 #include "applicationcommandlineoptions.h"
@@ -50,6 +51,7 @@ INITIALIZE_EASYLOGGINGPP
 #include <QDir>
 #include <QMessageBox>
 #include <QLibraryInfo>
+#include <QElapsedTimer>
 #include <qtsingleapplication.h>
 
 #include <vtkNew.h>
@@ -104,6 +106,12 @@ void initQtPluginsDirectory()
 #endif
 }
 
+/// Escriu al log el temps que ha trigat la fase d'arrencada indicada i reinicia el comptador per mesurar la fase següent.
+void logStartupPhase(const QString &phaseName, QElapsedTimer &phaseTimer)
+{
+    INFO_LOG(QString("Arrencada: %1 ha trigat %2 ms").arg(phaseName).arg(phaseTimer.restart()));
+}
+
 void sendToFirstStarviewerInstanceCommandLineOptions(QtSingleApplication &app)
 {
     QString errorInvalidCommanLineArguments;
@@ -122,6 +130,12 @@ void sendToFirstStarviewerInstanceCommandLineOptions(QtSingleApplication &app)
 
 int main(int argc, char *argv[])
 {
+    // Mesurem el temps de cada fase de l'arrencada i el temps fins que es mostra la finestra principal
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+    QElapsedTimer startupPhaseTimer;
+    startupPhaseTimer.start();
+
     // Applying scale factor
     {
         QVariant cfgValue = udg::Settings().getValue(udg::CoreSettings::ScaleFactor);
@@ -149,7 +163,7 @@ int main(int argc, char *argv[])
     udg::LoggingOutputWindow *loggingOutputWindow = udg::LoggingOutputWindow::New();
     vtkOutputWindow::SetInstance(loggingOutputWindow);
     loggingOutputWindow->Delete();
-
+    logStartupPhase("inicialitzacio de l'aplicacio i del log", startupPhaseTimer);
 
     QPixmap splashPixmap;
     #ifdef STARVIEWER_LITE
@@ -191,9 +205,13 @@ int main(int argc, char *argv[])
     inputoutputSettings.init();
     interfaceSettings.init();
     shortcuts.init();
+    // Si algú altre modifica els fitxers de settings cal descartar els valors que tenim a la cache
+    udg::SettingsCache::instance()->startWatchingSettingsFiles();
+    logStartupPhase("inicialitzacio dels settings", startupPhaseTimer);
 
     initQtPluginsDirectory();
     initializeTranslations(app);
+    logStartupPhase("carrega de traduccions i extensions", startupPhaseTimer);
 
     // Registering the available sync actions
     udg::SyncActionsRegister::registerSyncActions();
@@ -204,6 +222,7 @@ int main(int argc, char *argv[])
     // registrem els codecs decompressors JPEG i RLE
     DJDecoderRegistration::registerCodecs();
     DcmRLEDecoderRegistration::registerCodecs();
+    logStartupPhase("registre de sync actions i codecs", startupPhaseTimer);
 
     // Seguint les recomanacions de la documentació de Qt, guardem la llista d'arguments en una variable, ja que aquesta operació és costosa
     // http://doc.trolltech.com/4.7/qcoreapplication.html#arguments
@@ -255,8 +274,11 @@ int main(int argc, char *argv[])
             QObject::connect(&app, SIGNAL(messageReceived(QString)), StarviewerSingleApplicationCommandLineSingleton::instance(), SLOT(parseAndRun(QString)));
 
             INFO_LOG("Creada finestra principal");
+            logStartupPhase("creacio de la finestra principal", startupPhaseTimer);
 
             mainWin->show();
+            logStartupPhase("visualitzacio de la finestra principal", startupPhaseTimer);
+            INFO_LOG(QString("Arrencada: temps fins a mostrar la finestra principal %1 ms").arg(startupTimer.elapsed()));
             mainWin->checkNewVersionAndShowReleaseNotes();
 
             QObject::connect(&app, SIGNAL(lastWindowClosed()),
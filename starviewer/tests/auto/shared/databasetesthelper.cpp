@@ -2,6 +2,10 @@
 
 #include "databaseconnection.h"
 #include "databaseinstallation.h"
+#include "localdatabasepatientdal.h"
+#include "localdatabasestudydal.h"
+#include "patient.h"
+#include "study.h"
 
 using namespace udg;
 
@@ -21,4 +25,16 @@ DatabaseConnection* DatabaseTestHelper::getCreatedDatabase()
     return databaseConnection;
 }
 
+void DatabaseTestHelper::insertStudy(DatabaseConnection *databaseConnection, const QString &studyInstanceUID, const QDate &lastAccessDate)
+{
+    Patient patient;
+    patient.setFullName("Test patient");
+    LocalDatabasePatientDAL(*databaseConnection).insert(&patient);
+
+    Study *study = new Study();
+    study->setInstanceUID(studyInstanceUID);
+    patient.addStudy(study);
+    LocalDatabaseStudyDAL(*databaseConnection).insert(study, lastAccessDate);
+}
+
 }
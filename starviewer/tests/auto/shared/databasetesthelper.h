@@ -1,6 +1,9 @@
 #ifndef DATABASETESTHELPER_H
 #define DATABASETESTHELPER_H
 
+#include <QDate>
+#include <QString>
+
 namespace udg {
 class DatabaseConnection;
 }
@@ -17,6 +20,8 @@ public:
     static udg::DatabaseConnection* getEmptyDatabase();
     /// Returns an in-memory database with the tables created but empty.
     static udg::DatabaseConnection* getCreatedDatabase();
+    /// Inserts in the given database a patient with a study with the given UID and last access date.
+    static void insertStudy(udg::DatabaseConnection *databaseConnection, const QString &studyInstanceUID, const QDate &lastAccessDate);
 };
 
 }
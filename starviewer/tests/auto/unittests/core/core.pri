@@ -31,6 +31,8 @@ SOURCES += $$PWD/test_image.cpp \
            $$PWD/test_applicationversiontest.cpp \
            $$PWD/test_imageoverlayregionfinder.cpp \
            $$PWD/test_hangingprotocolmanager.cpp \
+           $$PWD/test_hangingprotocolcandidateindex.cpp \
+           $$PWD/test_floodfill.cpp \
            $$PWD/test_drawerpolygon.cpp \
            $$PWD/test_drawerline.cpp \
            $$PWD/test_diagnosistestresultwriter.cpp \
@@ -89,7 +91,17 @@ SOURCES += $$PWD/test_image.cpp \
            $$PWD/test_externalapplication.cpp \
            $$PWD/test_sliceorientedvolumepixeldata.cpp \
            $$PWD/test_applicationversionchecker.cpp \
-           $$PWD/test_systemrequirementstest.cpp
+           $$PWD/test_systemrequirementstest.cpp \
+           $$PWD/test_stringinterner.cpp \
+           $$PWD/test_apngwriter.cpp \
+           $$PWD/test_sliceprojectionindex.cpp \
+           $$PWD/test_drawerprimitiveindex.cpp \
+           $$PWD/test_settingscache.cpp \
+           $$PWD/test_memorymappeddataarray.cpp \
+           $$PWD/test_boundedfuturequeue.cpp \
+           $$PWD/test_dcmdatasetcache.cpp \
+           $$PWD/test_asynchronousthumbnailcreator.cpp \
+           $$PWD/test_rawpixeldatacache.cpp
 
 win32 {
     SOURCES += $$PWD/test_windowsfirewallaccess.cpp \
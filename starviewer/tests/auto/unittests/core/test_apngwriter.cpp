@@ -0,0 +1,144 @@
+#include "autotest.h"
+#include "apngwriter.h"
+
+#include <QBuffer>
+#include <QImage>
+#include <QtEndian>
+
+using namespace udg;
+
+class test_ApngWriter : public QObject {
+Q_OBJECT
+
+private slots:
+    void write_ShouldBeReproducible();
+
+    void write_ShouldStartWithAValidPngOfTheFirstFrame();
+
+    void close_ShouldWriteNumberOfFramesAndPlays_data();
+    void close_ShouldWriteNumberOfFramesAndPlays();
+
+    void addFrame_ShouldFailWithFramesOfDifferentSize();
+
+    void addFrame_ShouldFailIfNotOpened();
+
+    void close_ShouldFailWithoutFrames();
+
+private:
+    /// Retorna un frame de prova diferent per cada índex
+    static QImage createFrame(int index);
+
+    /// Escriu una animació amb el nombre de frames donat i en retorna el contingut
+    static QByteArray writeAnimation(int numberOfFrames, int framesPerSecond, bool loop);
+};
+
+void test_ApngWriter::write_ShouldBeReproducible()
+{
+    QCOMPARE(writeAnimation(5, 10, true), writeAnimation(5, 10, true));
+}
+
+void test_ApngWriter::write_ShouldStartWithAValidPngOfTheFirstFrame()
+{
+    QByteArray animation = writeAnimation(3, 10, true);
+
+    QImage firstFrame;
+    QVERIFY(firstFrame.loadFromData(animation, "PNG"));
+    QCOMPARE(firstFrame.convertToFormat(QImage::Format_RGB32), createFrame(0).convertToFormat(QImage::Format_RGB32));
+}
+
+void test_ApngWriter::close_ShouldWriteNumberOfFramesAndPlays_data()
+{
+    QTest::addColumn<int>("numberOfFrames");
+    QTest::addColumn<bool>("loop");
+    QTest::addColumn<int>("expectedNumberOfPlays");
+
+    QTest::newRow("one frame, loop") << 1 << true << 0;
+    QTest::newRow("several frames, loop") << 7 << true << 0;
+    QTest::newRow("several frames, no loop") << 7 << false << 1;
+}
+
+void test_ApngWriter::close_ShouldWriteNumberOfFramesAndPlays()
+{
+    QFETCH(int, numberOfFrames);
+    QFETCH(bool, loop);
+    QFETCH(int, expectedNumberOfPlays);
+
+    QByteArray animation = writeAnimation(numberOfFrames, 10, loop);
+
+    // acTL va just després de la signatura (8 bytes) i l'IHDR (25 bytes)
+    int animationControlPosition = 8 + 25;
+    QCOMPARE(animation.mid(animationControlPosition + 4, 4), QByteArray("acTL"));
+    const uchar *animationControlData = reinterpret_cast<const uchar*>(animation.constData() + animationControlPosition + 8);
+    QCOMPARE(qFromBigEndian<quint32>(animationControlData), static_cast<quint32>(numberOfFrames));
+    QCOMPARE(qFromBigEndian<quint32>(animationControlData + 4), static_cast<quint32>(expectedNumberOfPlays));
+    QCOMPARE(animation.count("fcTL"), numberOfFrames);
+}
+
+void test_ApngWriter::addFrame_ShouldFailWithFramesOfDifferentSize()
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    ApngWriter writer;
+    QVERIFY(writer.open(&buffer, 10));
+    QVERIFY(writer.addFrame(createFrame(0)));
+    QVERIFY(!writer.addFrame(createFrame(1).scaled(8, 8)));
+    QCOMPARE(writer.getNumberOfFrames(), 1);
+    QVERIFY(writer.close());
+}
+
+void test_ApngWriter::addFrame_ShouldFailIfNotOpened()
+{
+    ApngWriter writer;
+    QVERIFY(!writer.addFrame(createFrame(0)));
+    QCOMPARE(writer.getNumberOfFrames(), 0);
+}
+
+void test_ApngWriter::close_ShouldFailWithoutFrames()
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    ApngWriter writer;
+    QVERIFY(writer.open(&buffer, 10));
+    QVERIFY(!writer.close());
+}
+
+QImage test_ApngWriter::createFrame(int index)
+{
+    QImage frame(16, 12, QImage::Format_RGB888);
+    for (int y = 0; y < frame.height(); y++)
+    {
+        for (int x = 0; x < frame.width(); x++)
+        {
+            frame.setPixel(x, y, qRgb((x * 16 + index * 32) % 256, (y * 20) % 256, index * 40 % 256));
+        }
+    }
+
+    return frame;
+}
+
+QByteArray test_ApngWriter::writeAnimation(int numberOfFrames, int framesPerSecond, bool loop)
+{
+    QByteArray animation;
+    QBuffer buffer(&animation);
+    buffer.open(QIODevice::WriteOnly);
+
+    ApngWriter writer;
+    if (!writer.open(&buffer, framesPerSecond, loop))
+    {
+        return QByteArray();
+    }
+
+    for (int i = 0; i < numberOfFrames; i++)
+    {
+        writer.addFrame(createFrame(i));
+    }
+    writer.close();
+
+    return animation;
+}
+
+DECLARE_TEST(test_ApngWriter)
+
+#include "test_apngwriter.moc"
@@ -0,0 +1,118 @@
+#include "autotest.h"
+
+#include "asynchronousthumbnailcreator.h"
+#include "image.h"
+#include "singleton.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QtConcurrentRun>
+
+using namespace udg;
+
+namespace {
+
+AsynchronousThumbnailCreator* getAsynchronousThumbnailCreator()
+{
+    return SingletonPointer<AsynchronousThumbnailCreator>::instance();
+}
+
+}
+
+class test_AsynchronousThumbnailCreator : public QObject {
+Q_OBJECT
+
+private slots:
+    void init();
+
+    void instance_ShouldLiveInMainThreadWhenCreatedFromAnotherThread();
+    void enqueue_ShouldWriteThumbnailThroughTemporaryFileAndImageShouldReturnIt();
+    void enqueue_ShouldNotCreateThumbnailWhenTemporaryFileCannotBeWritten();
+    void enqueue_ShouldIgnoreExistingThumbnails();
+
+private:
+    /// Crea un fitxer que fa el paper d'imatge. No és DICOM, així que se'n crearà el thumbnail de previsualització no disponible.
+    QString createImageFile();
+
+    QScopedPointer<QTemporaryDir> m_directory;
+};
+
+void test_AsynchronousThumbnailCreator::init()
+{
+    m_directory.reset(new QTemporaryDir());
+    QVERIFY(m_directory->isValid());
+}
+
+void test_AsynchronousThumbnailCreator::instance_ShouldLiveInMainThreadWhenCreatedFromAnotherThread()
+{
+    AsynchronousThumbnailCreator *creator = QtConcurrent::run(getAsynchronousThumbnailCreator).result();
+
+    QCOMPARE(creator->thread(), QCoreApplication::instance()->thread());
+}
+
+void test_AsynchronousThumbnailCreator::enqueue_ShouldWriteThumbnailThroughTemporaryFileAndImageShouldReturnIt()
+{
+    AsynchronousThumbnailCreator *creator = SingletonPointer<AsynchronousThumbnailCreator>::instance();
+    QString imageFilePath = createImageFile();
+    QString thumbnailFilePath = m_directory->path() + "/thumbnail0.png";
+
+    creator->enqueue(imageFilePath, QStringList() << thumbnailFilePath);
+
+    QVERIFY(creator->isPending(thumbnailFilePath) || QFileInfo(thumbnailFilePath).exists());
+    QTRY_VERIFY_WITH_TIMEOUT(!creator->isPending(thumbnailFilePath), 10000);
+    QVERIFY(QFileInfo(thumbnailFilePath).exists());
+    QVERIFY(!QFileInfo(thumbnailFilePath + ".tmp").exists());
+
+    QImage savedThumbnail(thumbnailFilePath);
+    QVERIFY(!savedThumbnail.isNull());
+
+    Image image;
+    image.setPath(imageFilePath);
+    image.setVolumeNumberInSeries(0);
+    QCOMPARE(image.getThumbnailImage(true), savedThumbnail);
+}
+
+void test_AsynchronousThumbnailCreator::enqueue_ShouldNotCreateThumbnailWhenTemporaryFileCannotBeWritten()
+{
+    AsynchronousThumbnailCreator creator;
+    QString thumbnailFilePath = m_directory->path() + "/thumbnail0.png";
+    // Un directori amb el nom del fitxer temporal impedeix escriure-hi
+    QVERIFY(QDir(m_directory->path()).mkdir("thumbnail0.png.tmp"));
+
+    creator.enqueue(createImageFile(), QStringList() << thumbnailFilePath);
+
+    QTRY_VERIFY_WITH_TIMEOUT(!creator.isPending(thumbnailFilePath), 10000);
+    QVERIFY(!QFileInfo(thumbnailFilePath).exists());
+}
+
+void test_AsynchronousThumbnailCreator::enqueue_ShouldIgnoreExistingThumbnails()
+{
+    AsynchronousThumbnailCreator creator;
+    QString thumbnailFilePath = m_directory->path() + "/thumbnail0.png";
+    QFile thumbnailFile(thumbnailFilePath);
+    QVERIFY(thumbnailFile.open(QIODevice::WriteOnly));
+    thumbnailFile.close();
+
+    creator.enqueue(createImageFile(), QStringList() << thumbnailFilePath);
+
+    QVERIFY(!creator.isPending(thumbnailFilePath));
+    QCOMPARE(QFileInfo(thumbnailFilePath).size(), Q_INT64_C(0));
+}
+
+QString test_AsynchronousThumbnailCreator::createImageFile()
+{
+    QString imageFilePath = m_directory->path() + "/image.dcm";
+    QFile imageFile(imageFilePath);
+    imageFile.open(QIODevice::WriteOnly);
+    imageFile.write("not a DICOM file");
+    imageFile.close();
+
+    return imageFilePath;
+}
+
+DECLARE_TEST(test_AsynchronousThumbnailCreator)
+
+#include "test_asynchronousthumbnailcreator.moc"
@@ -0,0 +1,89 @@
+#include "autotest.h"
+#include "boundedfuturequeue.h"
+
+#include <QAtomicInt>
+#include <QThread>
+#include <QtConcurrentRun>
+
+using namespace udg;
+
+namespace {
+
+// Nombre de tasques que s'estan executant o que han acabat però la cua encara no ha esperat
+QAtomicInt unfinishedTasks;
+
+bool sleepAndReturn(bool result)
+{
+    QThread::msleep(20);
+    unfinishedTasks.deref();
+    return result;
+}
+
+}
+
+class test_BoundedFutureQueue : public QObject {
+Q_OBJECT
+
+private slots:
+    void enqueue_ShouldNeverKeepMoreThanTheMaximumPendingFutures();
+
+    void waitForAll_ShouldReturnTrueIfAllFuturesSucceeded();
+
+    void waitForAll_ShouldReturnFalseIfAnyFutureFailed();
+};
+
+void test_BoundedFutureQueue::enqueue_ShouldNeverKeepMoreThanTheMaximumPendingFutures()
+{
+    const int MaximumNumberOfPendingFutures = 2;
+    BoundedFutureQueue queue(MaximumNumberOfPendingFutures);
+    unfinishedTasks = 0;
+
+    for (int i = 0; i < 10; i++)
+    {
+        // Quan la cua és plena, enqueue() espera que acabi la tasca més antiga abans d'afegir-ne una altra
+        unfinishedTasks.ref();
+        queue.enqueue(QtConcurrent::run(sleepAndReturn, true));
+
+        QVERIFY(queue.getNumberOfPendingFutures() <= MaximumNumberOfPendingFutures);
+        QVERIFY(unfinishedTasks.load() <= MaximumNumberOfPendingFutures);
+    }
+
+    QVERIFY(queue.waitForAll());
+    QCOMPARE(queue.getNumberOfPendingFutures(), 0);
+    QCOMPARE(unfinishedTasks.load(), 0);
+}
+
+void test_BoundedFutureQueue::waitForAll_ShouldReturnTrueIfAllFuturesSucceeded()
+{
+    BoundedFutureQueue queue(3);
+    unfinishedTasks = 0;
+
+    for (int i = 0; i < 5; i++)
+    {
+        unfinishedTasks.ref();
+        queue.enqueue(QtConcurrent::run(sleepAndReturn, true));
+    }
+
+    QVERIFY(queue.waitForAll());
+}
+
+void test_BoundedFutureQueue::waitForAll_ShouldReturnFalseIfAnyFutureFailed()
+{
+    BoundedFutureQueue queue(1);
+    unfinishedTasks = 0;
+
+    // La tasca que falla ja s'ha esperat dins d'enqueue() quan s'afegeixen les següents
+    unfinishedTasks.ref();
+    queue.enqueue(QtConcurrent::run(sleepAndReturn, false));
+    for (int i = 0; i < 3; i++)
+    {
+        unfinishedTasks.ref();
+        queue.enqueue(QtConcurrent::run(sleepAndReturn, true));
+    }
+
+    QVERIFY(!queue.waitForAll());
+}
+
+DECLARE_TEST(test_BoundedFutureQueue)
+
+#include "test_boundedfuturequeue.moc"
@@ -0,0 +1,152 @@
+#include "autotest.h"
+
+#include "dcmdatasetcache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <dcdatset.h>
+#include <dcdeftag.h>
+
+using namespace udg;
+
+class test_DcmDatasetCache : public QObject {
+Q_OBJECT
+
+private slots:
+    void init();
+
+    void take_ShouldReturnInsertedDatasetOnlyOnce();
+    void take_ShouldReturnNullForUnknownFiles();
+    void insert_ShouldEvictOldestDatasetsWhenMaximumSizeIsExceeded();
+    void insert_ShouldNotKeepDatasetsBiggerThanMaximumSize();
+    void take_ShouldDiscardDatasetsOfFilesModifiedAfterInsertion();
+    void removeDirectory_ShouldRemoveOnlyDatasetsOfFilesInsideTheDirectory();
+
+private:
+    /// Crea un fitxer buit amb el nom donat dins del directori temporal i en retorna el path
+    QString createFile(const QString &relativePath);
+    static DcmDataset* createDataset(int numberOfPixelBytes);
+
+    QScopedPointer<QTemporaryDir> m_directory;
+};
+
+void test_DcmDatasetCache::init()
+{
+    m_directory.reset(new QTemporaryDir());
+    QVERIFY(m_directory->isValid());
+}
+
+void test_DcmDatasetCache::take_ShouldReturnInsertedDatasetOnlyOnce()
+{
+    DcmDatasetCache cache;
+    cache.setMaximumSize(1024 * 1024);
+    QString filePath = createFile("image.dcm");
+    DcmDataset *dataset = createDataset(100);
+
+    cache.insert(filePath, dataset);
+
+    QVERIFY(cache.contains(filePath));
+    QVERIFY(cache.getCurrentSize() > 0);
+    QCOMPARE(cache.take(filePath).data(), dataset);
+    QVERIFY(!cache.contains(filePath));
+    QCOMPARE(cache.getCurrentSize(), Q_INT64_C(0));
+    QVERIFY(cache.take(filePath).isNull());
+}
+
+void test_DcmDatasetCache::take_ShouldReturnNullForUnknownFiles()
+{
+    DcmDatasetCache cache;
+    cache.setMaximumSize(1024 * 1024);
+
+    QVERIFY(cache.take(createFile("image.dcm")).isNull());
+}
+
+void test_DcmDatasetCache::insert_ShouldEvictOldestDatasetsWhenMaximumSizeIsExceeded()
+{
+    DcmDatasetCache cache;
+    cache.setMaximumSize(1024 * 1024);
+    QString firstFilePath = createFile("first.dcm");
+    QString secondFilePath = createFile("second.dcm");
+    QString thirdFilePath = createFile("third.dcm");
+
+    cache.insert(firstFilePath, createDataset(1000));
+    qint64 datasetSize = cache.getCurrentSize();
+    cache.setMaximumSize(2 * datasetSize);
+    cache.insert(secondFilePath, createDataset(1000));
+    cache.insert(thirdFilePath, createDataset(1000));
+
+    QVERIFY(!cache.contains(firstFilePath));
+    QVERIFY(cache.contains(secondFilePath));
+    QVERIFY(cache.contains(thirdFilePath));
+    QCOMPARE(cache.getCurrentSize(), 2 * datasetSize);
+}
+
+void test_DcmDatasetCache::insert_ShouldNotKeepDatasetsBiggerThanMaximumSize()
+{
+    DcmDatasetCache cache;
+    cache.setMaximumSize(100);
+    QString filePath = createFile("image.dcm");
+
+    cache.insert(filePath, createDataset(1000));
+
+    QVERIFY(!cache.contains(filePath));
+    QCOMPARE(cache.getCurrentSize(), Q_INT64_C(0));
+}
+
+void test_DcmDatasetCache::take_ShouldDiscardDatasetsOfFilesModifiedAfterInsertion()
+{
+    DcmDatasetCache cache;
+    cache.setMaximumSize(1024 * 1024);
+    QString filePath = createFile("image.dcm");
+    cache.insert(filePath, createDataset(100));
+
+    QVERIFY(QFile::remove(filePath));
+
+    QVERIFY(cache.take(filePath).isNull());
+    QVERIFY(!cache.contains(filePath));
+    QCOMPARE(cache.getCurrentSize(), Q_INT64_C(0));
+}
+
+void test_DcmDatasetCache::removeDirectory_ShouldRemoveOnlyDatasetsOfFilesInsideTheDirectory()
+{
+    DcmDatasetCache cache;
+    cache.setMaximumSize(1024 * 1024);
+    QVERIFY(QDir(m_directory->path()).mkpath("study/series"));
+    QVERIFY(QDir(m_directory->path()).mkpath("study2"));
+    QString seriesFilePath = createFile("study/series/image.dcm");
+    QString otherStudyFilePath = createFile("study2/image.dcm");
+    cache.insert(seriesFilePath, createDataset(100));
+    cache.insert(otherStudyFilePath, createDataset(100));
+
+    cache.removeDirectory(m_directory->path() + "/study");
+
+    QVERIFY(!cache.contains(seriesFilePath));
+    QVERIFY(cache.contains(otherStudyFilePath));
+}
+
+QString test_DcmDatasetCache::createFile(const QString &relativePath)
+{
+    QString filePath = m_directory->path() + "/" + relativePath;
+    QFile file(filePath);
+    file.open(QIODevice::WriteOnly);
+    file.write("DICM");
+    file.close();
+
+    return filePath;
+}
+
+DcmDataset* test_DcmDatasetCache::createDataset(int numberOfPixelBytes)
+{
+    DcmDataset *dataset = new DcmDataset();
+    dataset->putAndInsertString(DCM_PatientName, "SURNAME^NAME");
+    QByteArray pixelData(numberOfPixelBytes, 0);
+    dataset->putAndInsertUint8Array(DCM_PixelData, reinterpret_cast<const Uint8*>(pixelData.constData()), pixelData.size());
+
+    return dataset;
+}
+
+DECLARE_TEST(test_DcmDatasetCache)
+
+#include "test_dcmdatasetcache.moc"
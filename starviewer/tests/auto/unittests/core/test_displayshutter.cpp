@@ -42,6 +42,10 @@ private slots:
 
     void getAsVtkImageData_ReturnsExpectedValues_data();
     void getAsVtkImageData_ReturnsExpectedValues();
+
+    void getAsSharedVtkImageData_ReturnsSameValuesAsGetAsVtkImageData();
+
+    void getAsSharedVtkImageData_SharesScalarsOnlyBetweenEqualShuttersAndDimensions();
 };
 
 Q_DECLARE_METATYPE(DisplayShutter::ShapeType)
@@ -484,6 +488,50 @@ void test_DisplayShutter::getAsVtkImageData_ReturnsExpectedValues()
     }
 }
 
+void test_DisplayShutter::getAsSharedVtkImageData_ReturnsSameValuesAsGetAsVtkImageData()
+{
+    DisplayShutter circularShutter;
+    circularShutter.setPoints(QPoint(8, 8), 5);
+
+    vtkSmartPointer<vtkImageData> expectedVtkImageData = circularShutter.getAsVtkImageData(16, 20);
+    vtkSmartPointer<vtkImageData> shutterVtkImageData = circularShutter.getAsSharedVtkImageData(16, 20);
+
+    QCOMPARE(shutterVtkImageData->GetNumberOfScalarComponents(), expectedVtkImageData->GetNumberOfScalarComponents());
+    QCOMPARE(shutterVtkImageData->GetNumberOfPoints(), expectedVtkImageData->GetNumberOfPoints());
+
+    int dimensions[3];
+    shutterVtkImageData->GetDimensions(dimensions);
+    QCOMPARE(dimensions[0], 16);
+    QCOMPARE(dimensions[1], 20);
+    QCOMPARE(dimensions[2], 1);
+
+    int size = expectedVtkImageData->GetNumberOfPoints() * expectedVtkImageData->GetNumberOfScalarComponents();
+    QCOMPARE(memcmp(shutterVtkImageData->GetScalarPointer(), expectedVtkImageData->GetScalarPointer(), size), 0);
+}
+
+void test_DisplayShutter::getAsSharedVtkImageData_SharesScalarsOnlyBetweenEqualShuttersAndDimensions()
+{
+    DisplayShutter rectangularShutter1;
+    rectangularShutter1.setPoints(QPoint(2, 2), QPoint(10, 10));
+    rectangularShutter1.setShutterValue(100);
+    DisplayShutter rectangularShutter2;
+    rectangularShutter2.setPoints(QPoint(2, 2), QPoint(10, 10));
+    rectangularShutter2.setShutterValue(200);
+    DisplayShutter differentShutter;
+    differentShutter.setPoints(QPoint(3, 3), QPoint(10, 10));
+
+    vtkSmartPointer<vtkImageData> imageData1 = rectangularShutter1.getAsSharedVtkImageData(16, 16);
+    vtkSmartPointer<vtkImageData> imageData2 = rectangularShutter2.getAsSharedVtkImageData(16, 16);
+    vtkSmartPointer<vtkImageData> differentSizeImageData = rectangularShutter1.getAsSharedVtkImageData(32, 16);
+    vtkSmartPointer<vtkImageData> differentShutterImageData = differentShutter.getAsSharedVtkImageData(16, 16);
+
+    // Each image gets its own object so that it can have its own origin, but the mask is the same
+    QVERIFY(imageData1 != imageData2);
+    QCOMPARE(imageData1->GetScalarPointer(), imageData2->GetScalarPointer());
+    QVERIFY(imageData1->GetScalarPointer() != differentSizeImageData->GetScalarPointer());
+    QVERIFY(imageData1->GetScalarPointer() != differentShutterImageData->GetScalarPointer());
+}
+
 DECLARE_TEST(test_DisplayShutter)
 
 #include "test_displayshutter.moc"
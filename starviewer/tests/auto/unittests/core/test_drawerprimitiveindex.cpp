@@ -0,0 +1,112 @@
+#include "autotest.h"
+#include "drawerprimitiveindex.h"
+
+#include "drawerline.h"
+
+using namespace udg;
+
+class test_DrawerPrimitiveIndex : public QObject {
+Q_OBJECT
+
+private slots:
+    void getPrimitives_ShouldReturnPrimitivesOfTheGivenSlice();
+
+    void remove_ShouldRemoveOnlyTheGivenPrimitive();
+
+    void remove_ShouldReturnFalseIfPrimitiveIsNotInTheIndex();
+
+    void insert_ShouldNotChangePrimitiveAlreadyInTheIndex();
+
+    void move_ShouldMovePrimitiveToTheGivenSlice();
+
+    void move_ShouldReturnFalseIfPrimitiveIsNotInTheIndex();
+};
+
+void test_DrawerPrimitiveIndex::getPrimitives_ShouldReturnPrimitivesOfTheGivenSlice()
+{
+    DrawerLine line1(this), line2(this), line3(this);
+
+    DrawerPrimitiveIndex index;
+    index.insert(&line1, 3);
+    index.insert(&line2, 5);
+    index.insert(&line3, 3);
+
+    QList<DrawerPrimitive*> slice3Primitives = index.getPrimitives(3);
+    QCOMPARE(slice3Primitives.size(), 2);
+    QVERIFY(slice3Primitives.contains(&line1));
+    QVERIFY(slice3Primitives.contains(&line3));
+    QCOMPARE(index.getPrimitives(5), QList<DrawerPrimitive*>() << &line2);
+    QVERIFY(index.getPrimitives(4).isEmpty());
+    QCOMPARE(index.getNumberOfPrimitives(), 3);
+}
+
+void test_DrawerPrimitiveIndex::remove_ShouldRemoveOnlyTheGivenPrimitive()
+{
+    DrawerLine line1(this), line2(this);
+
+    DrawerPrimitiveIndex index;
+    index.insert(&line1, 3);
+    index.insert(&line2, 3);
+
+    QVERIFY(index.remove(&line1));
+    QVERIFY(!index.contains(&line1));
+    QVERIFY(index.contains(&line2));
+    QCOMPARE(index.getPrimitives(3), QList<DrawerPrimitive*>() << &line2);
+    QCOMPARE(index.getNumberOfPrimitives(), 1);
+}
+
+void test_DrawerPrimitiveIndex::remove_ShouldReturnFalseIfPrimitiveIsNotInTheIndex()
+{
+    DrawerLine line1(this), line2(this);
+
+    DrawerPrimitiveIndex index;
+    index.insert(&line1, 0);
+
+    QVERIFY(!index.remove(&line2));
+    QCOMPARE(index.getNumberOfPrimitives(), 1);
+}
+
+void test_DrawerPrimitiveIndex::insert_ShouldNotChangePrimitiveAlreadyInTheIndex()
+{
+    DrawerLine line(this);
+
+    DrawerPrimitiveIndex index;
+    QVERIFY(index.insert(&line, 1));
+    QVERIFY(!index.insert(&line, 7));
+
+    QCOMPARE(index.getSlice(&line), 1);
+    QCOMPARE(index.getPrimitives(1), QList<DrawerPrimitive*>() << &line);
+    QVERIFY(index.getPrimitives(7).isEmpty());
+    QCOMPARE(index.getNumberOfPrimitives(), 1);
+}
+
+void test_DrawerPrimitiveIndex::move_ShouldMovePrimitiveToTheGivenSlice()
+{
+    DrawerLine line1(this), line2(this);
+
+    DrawerPrimitiveIndex index;
+    index.insert(&line1, 1);
+    index.insert(&line2, 1);
+
+    QVERIFY(index.move(&line1, 7));
+
+    QCOMPARE(index.getSlice(&line1), 7);
+    QCOMPARE(index.getPrimitives(1), QList<DrawerPrimitive*>() << &line2);
+    QCOMPARE(index.getPrimitives(7), QList<DrawerPrimitive*>() << &line1);
+    QCOMPARE(index.getNumberOfPrimitives(), 2);
+}
+
+void test_DrawerPrimitiveIndex::move_ShouldReturnFalseIfPrimitiveIsNotInTheIndex()
+{
+    DrawerLine line(this);
+
+    DrawerPrimitiveIndex index;
+
+    QVERIFY(!index.move(&line, 7));
+    QVERIFY(!index.contains(&line));
+    QCOMPARE(index.getNumberOfPrimitives(), 0);
+}
+
+DECLARE_TEST(test_DrawerPrimitiveIndex)
+
+#include "test_drawerprimitiveindex.moc"
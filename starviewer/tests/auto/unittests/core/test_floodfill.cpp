@@ -0,0 +1,153 @@
+#include "autotest.h"
+#include "floodfill.h"
+
+#include <QVector>
+
+using namespace udg;
+
+class test_FloodFill : public QObject {
+Q_OBJECT
+
+private slots:
+    void replaceValue_ShouldFillExpectedVoxels_data();
+    void replaceValue_ShouldFillExpectedVoxels();
+
+    void replaceValue_ShouldNotOverflowWithLargeRegions();
+
+    void replaceValue_Benchmark_data();
+    void replaceValue_Benchmark();
+};
+
+Q_DECLARE_METATYPE(QVector<unsigned char>)
+Q_DECLARE_METATYPE(FloodFill::Connectivity)
+
+void test_FloodFill::replaceValue_ShouldFillExpectedVoxels_data()
+{
+    QTest::addColumn<QVector<unsigned char> >("buffer");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<FloodFill::Connectivity>("connectivity");
+    QTest::addColumn<int>("expectedNumberOfFilledVoxels");
+
+    // Cubs 3x3x3 amb diferents disposicions de vòxels omplibles al voltant del centre
+    QVector<unsigned char> diagonal(27, 0);
+    diagonal[0] = 1;            // (0, 0, 0)
+    diagonal[13] = 1;           // (1, 1, 1)
+    diagonal[26] = 1;           // (2, 2, 2)
+
+    QVector<unsigned char> edge(27, 0);
+    edge[13] = 1;               // (1, 1, 1)
+    edge[13 + 1 + 3] = 1;       // (2, 2, 1)
+    edge[13 + 9] = 1;           // (1, 1, 2)
+
+    QVector<unsigned char> full(27, 1);
+
+    QVector<unsigned char> hollow(27, 1);
+    hollow[4] = 0;              // (1, 1, 0)
+    hollow[10] = 0;             // (1, 0, 1)
+    hollow[12] = 0;             // (0, 1, 1)
+    hollow[14] = 0;             // (2, 1, 1)
+    hollow[16] = 0;             // (1, 2, 1)
+    hollow[22] = 0;             // (1, 1, 2)
+
+    QTest::newRow("vertex neighbours, 6-connectivity") << diagonal << 3 << FloodFill::SixConnectivity << 1;
+    QTest::newRow("vertex neighbours, 18-connectivity") << diagonal << 3 << FloodFill::EighteenConnectivity << 1;
+    QTest::newRow("vertex neighbours, 26-connectivity") << diagonal << 3 << FloodFill::TwentySixConnectivity << 3;
+    QTest::newRow("edge and face neighbours, 6-connectivity") << edge << 3 << FloodFill::SixConnectivity << 2;
+    QTest::newRow("edge and face neighbours, 18-connectivity") << edge << 3 << FloodFill::EighteenConnectivity << 3;
+    QTest::newRow("full cube") << full << 3 << FloodFill::SixConnectivity << 27;
+    QTest::newRow("centre without face neighbours, 6-connectivity") << hollow << 3 << FloodFill::SixConnectivity << 1;
+    QTest::newRow("centre without face neighbours, 18-connectivity") << hollow << 3 << FloodFill::EighteenConnectivity << 21;
+}
+
+void test_FloodFill::replaceValue_ShouldFillExpectedVoxels()
+{
+    QFETCH(QVector<unsigned char>, buffer);
+    QFETCH(int, size);
+    QFETCH(FloodFill::Connectivity, connectivity);
+    QFETCH(int, expectedNumberOfFilledVoxels);
+
+    int extent[6] = { 0, size - 1, 0, size - 1, 0, size - 1 };
+    int centre = size / 2;
+
+    int numberOfFilledVoxels = FloodFill::replaceValue<unsigned char>(buffer.data(), extent, centre, centre, centre, 1, 2, connectivity);
+
+    QCOMPARE(numberOfFilledVoxels, expectedNumberOfFilledVoxels);
+    QCOMPARE(buffer.count(2), expectedNumberOfFilledVoxels);
+}
+
+void test_FloodFill::replaceValue_ShouldNotOverflowWithLargeRegions()
+{
+    // Serp d'una llesca: obliga a visitar totes les files una per una, cosa que amb recursivitat per vòxel desbordaria la pila
+    const int size = 256;
+    QVector<short> buffer(size * size, 0);
+    int expectedNumberOfFilledVoxels = 0;
+    for (int y = 0; y < size; y += 2)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            buffer[y * size + x] = 1;
+            expectedNumberOfFilledVoxels++;
+        }
+        if (y + 1 < size)
+        {
+            int x = (y / 2) % 2 == 0 ? size - 1 : 0;
+            buffer[(y + 1) * size + x] = 1;
+            expectedNumberOfFilledVoxels++;
+        }
+    }
+
+    int extent[6] = { 0, size - 1, 0, size - 1, 3, 3 };
+    int numberOfFilledVoxels = FloodFill::replaceValue<short>(buffer.data(), extent, 0, 0, 3, 1, 5);
+
+    QCOMPARE(numberOfFilledVoxels, expectedNumberOfFilledVoxels);
+    QCOMPARE(buffer.count(1), 0);
+}
+
+void test_FloodFill::replaceValue_Benchmark_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<FloodFill::Connectivity>("connectivity");
+
+    // Mides petites perquè el benchmark formi part de la bateria de tests unitaris sense reservar massa memòria
+    QTest::newRow("128^3, 6-connectivity") << 128 << FloodFill::SixConnectivity;
+    QTest::newRow("128^3, 26-connectivity") << 128 << FloodFill::TwentySixConnectivity;
+}
+
+void test_FloodFill::replaceValue_Benchmark()
+{
+    QFETCH(int, size);
+    QFETCH(FloodFill::Connectivity, connectivity);
+
+    // Màscara amb una esfera que ocupa la major part del volum
+    QVector<unsigned char> mask(size * size * size, 0);
+    const int centre = size / 2;
+    const qint64 squaredRadius = static_cast<qint64>(centre - 1) * (centre - 1);
+    for (int z = 0; z < size; z++)
+    {
+        for (int y = 0; y < size; y++)
+        {
+            for (int x = 0; x < size; x++)
+            {
+                qint64 squaredDistance = static_cast<qint64>(x - centre) * (x - centre) + (y - centre) * (y - centre) + (z - centre) * (z - centre);
+                if (squaredDistance <= squaredRadius)
+                {
+                    mask[(z * size + y) * size + x] = 1;
+                }
+            }
+        }
+    }
+
+    int extent[6] = { 0, size - 1, 0, size - 1, 0, size - 1 };
+    unsigned char targetValue = 1;
+    unsigned char newValue = 2;
+
+    QBENCHMARK
+    {
+        FloodFill::replaceValue(mask.data(), extent, centre, centre, centre, targetValue, newValue, connectivity);
+        qSwap(targetValue, newValue);
+    }
+}
+
+DECLARE_TEST(test_FloodFill)
+
+#include "test_floodfill.moc"
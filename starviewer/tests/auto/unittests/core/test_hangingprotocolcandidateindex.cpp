@@ -0,0 +1,114 @@
+#include "autotest.h"
+
+#include <QRegExp>
+
+#include "patient.h"
+#include "study.h"
+#include "series.h"
+#include "patienttesthelper.h"
+#include "hangingprotocoltesthelper.h"
+#include "hangingprotocolcandidateindex.h"
+#include "hangingprotocol.h"
+#include "hangingprotocolmask.h"
+
+using namespace udg;
+using namespace testing;
+
+class test_HangingProtocolCandidateIndex : public QObject {
+Q_OBJECT
+
+private slots:
+    void getCandidates_ShouldReturnExpectedHangingProtocols_data();
+    void getCandidates_ShouldReturnExpectedHangingProtocols();
+
+private:
+    HangingProtocol* createHangingProtocol(int identifier, const QStringList &modalities, const QString &institution, int numberOfPriors);
+
+    Patient* createMGPatient();
+};
+
+Q_DECLARE_METATYPE(Patient*)
+Q_DECLARE_METATYPE(QList<int>)
+
+void test_HangingProtocolCandidateIndex::getCandidates_ShouldReturnExpectedHangingProtocols_data()
+{
+    QTest::addColumn<Patient*>("patient");
+    QTest::addColumn<int>("numberOfPriors");
+    QTest::addColumn<QList<int> >("expectedIdentifiers");
+
+    Patient *CTPatient = PatientTestHelper::create(1, 1, 1);
+    CTPatient->getStudies().at(0)->addModality("CT");
+    CTPatient->getStudies().at(0)->getSeries().at(0)->setModality("CT");
+    CTPatient->getStudies().at(0)->getSeries().at(0)->setInstitutionName("Barcelona");
+
+    Patient *CTMRPatient = PatientTestHelper::create(1, 2, 1);
+    CTMRPatient->getStudies().at(0)->addModality("CT");
+    CTMRPatient->getStudies().at(0)->addModality("MR");
+    CTMRPatient->getStudies().at(0)->getSeries().at(0)->setModality("CT");
+    CTMRPatient->getStudies().at(0)->getSeries().at(1)->setModality("MR");
+
+    Patient *USPatient = PatientTestHelper::create(1, 1, 1);
+    USPatient->getStudies().at(0)->addModality("US");
+    USPatient->getStudies().at(0)->getSeries().at(0)->setModality("US");
+
+    QTest::newRow("MG without priors") << createMGPatient() << 0 << (QList<int>() << 1);
+    QTest::newRow("MG with priors") << createMGPatient() << 1 << (QList<int>() << 1 << 2);
+    QTest::newRow("CT from a non-matching institution") << CTPatient << 0 << (QList<int>() << 4);
+    QTest::newRow("CT+MR keeps the original order without repetitions") << CTMRPatient << 0 << (QList<int>() << 4 << 5);
+    QTest::newRow("modality without hanging protocols") << USPatient << 1 << QList<int>();
+}
+
+void test_HangingProtocolCandidateIndex::getCandidates_ShouldReturnExpectedHangingProtocols()
+{
+    QFETCH(Patient*, patient);
+    QFETCH(int, numberOfPriors);
+    QFETCH(QList<int>, expectedIdentifiers);
+
+    QList<HangingProtocol*> hangingProtocols;
+    hangingProtocols << createHangingProtocol(1, QStringList() << "MG", "Girona", 0);
+    hangingProtocols << createHangingProtocol(2, QStringList() << "MG", "", 1);
+    hangingProtocols << createHangingProtocol(3, QStringList() << "CT", "Girona", 0);
+    hangingProtocols << createHangingProtocol(4, QStringList() << "CT" << "MR", "", 0);
+    hangingProtocols << createHangingProtocol(5, QStringList() << "MR" << "MR", "", 0);
+
+    HangingProtocolCandidateIndex index;
+    index.build(hangingProtocols);
+
+    QList<int> identifiers;
+    foreach (HangingProtocol *hangingProtocol, index.getCandidates(patient->getStudies().first(), numberOfPriors))
+    {
+        identifiers << hangingProtocol->getIdentifier();
+    }
+
+    QCOMPARE(identifiers, expectedIdentifiers);
+
+    qDeleteAll(hangingProtocols);
+    delete patient;
+}
+
+HangingProtocol* test_HangingProtocolCandidateIndex::createHangingProtocol(int identifier, const QStringList &modalities, const QString &institution,
+                                                                           int numberOfPriors)
+{
+    HangingProtocol *hangingProtocol = HangingProtocolTestHelper::createHangingProtocolWithAttributes(QString("HP%1").arg(identifier), 1, false, false,
+                                                                                                      numberOfPriors, identifier, 1, 1);
+    hangingProtocol->getHangingProtocolMask()->setProtocolsList(modalities);
+    hangingProtocol->setInstitutionsRegularExpression(QRegExp(institution));
+
+    return hangingProtocol;
+}
+
+Patient* test_HangingProtocolCandidateIndex::createMGPatient()
+{
+    Patient *patient = PatientTestHelper::create(1, 2, 1);
+    patient->getStudies().at(0)->addModality("MG");
+    patient->getStudies().at(0)->getSeries().at(0)->setModality("MG");
+    patient->getStudies().at(0)->getSeries().at(0)->setInstitutionName("Girona");
+    patient->getStudies().at(0)->getSeries().at(1)->setModality("MG");
+    patient->getStudies().at(0)->getSeries().at(1)->setInstitutionName("Girona");
+
+    return patient;
+}
+
+DECLARE_TEST(test_HangingProtocolCandidateIndex)
+
+#include "test_hangingprotocolcandidateindex.moc"
@@ -34,6 +34,9 @@ private slots:
     void searchHangingProtocols_ShouldReturnExpectedHangingProtocols_data();
     void searchHangingProtocols_ShouldReturnExpectedHangingProtocols();
 
+    void searchHangingProtocols_Benchmark_data();
+    void searchHangingProtocols_Benchmark();
+
 private:
     QList<HangingProtocol*> getHangingProtocolsRepository();
     HangingProtocolImageSetRestriction createRestriction(QString selectorAttribute, QString valueRepresentation);
@@ -128,6 +131,61 @@ void test_HangingProtocolManager::searchHangingProtocols_ShouldReturnExpectedHan
     }
 }
 
+void test_HangingProtocolManager::searchHangingProtocols_Benchmark_data()
+{
+    QTest::addColumn<int>("numberOfHangingProtocols");
+    QTest::addColumn<int>("numberOfSeries");
+
+    // Each repository copy adds 4 hanging protocols; the MG one has image level restrictions and is applicable to the synthetic study
+    QTest::newRow("12 hanging protocols, 4 series") << 12 << 4;
+    QTest::newRow("120 hanging protocols, 4 series") << 120 << 4;
+    QTest::newRow("12 hanging protocols, 40 series") << 12 << 40;
+    QTest::newRow("120 hanging protocols, 40 series") << 120 << 40;
+}
+
+void test_HangingProtocolManager::searchHangingProtocols_Benchmark()
+{
+    QFETCH(int, numberOfHangingProtocols);
+    QFETCH(int, numberOfSeries);
+
+    Patient *patient = PatientTestHelper::create(1, numberOfSeries, 1);
+    Study *study = patient->getStudies().first();
+    study->addModality("MG");
+
+    for (int i = 0; i < numberOfSeries; i++)
+    {
+        Series *series = study->getSeries().at(i);
+        series->setModality("MG");
+        series->setInstitutionName("Girona");
+        series->getImages().first()->setImageLaterality(QString(i % 2 == 0 ? "R" : "L").at(0));
+        series->getImages().first()->setViewCodeMeaning(i % 4 < 2 ? "cranio-caudal" : "lateral");
+    }
+
+    TestHangingProtocolManager testHangingProtocolManager;
+
+    while (numberOfHangingProtocols > 0)
+    {
+        foreach (HangingProtocol *hangingProtocol, getHangingProtocolsRepository())
+        {
+            testHangingProtocolManager.addHangingProtocolToRepository(hangingProtocol);
+            numberOfHangingProtocols--;
+        }
+    }
+
+    QList<HangingProtocol*> hangingProtocolsCandidates;
+
+    QBENCHMARK
+    {
+        qDeleteAll(hangingProtocolsCandidates);
+        hangingProtocolsCandidates = testHangingProtocolManager.searchHangingProtocols(study);
+    }
+
+    QVERIFY(!hangingProtocolsCandidates.isEmpty());
+
+    qDeleteAll(hangingProtocolsCandidates);
+    delete patient;
+}
+
 QList<HangingProtocol*> test_HangingProtocolManager::getHangingProtocolsRepository()
 {
     // MG estricte i totes les imatges diferents, amb institució
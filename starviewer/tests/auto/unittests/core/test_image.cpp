@@ -4,6 +4,7 @@
 #include "imageorientation.h"
 #include "fuzzycomparetesthelper.h"
 #include "series.h"
+#include "stringinterner.h"
 #include "mathtools.h"
 
 #include <vtkImageData.h>
@@ -43,6 +44,11 @@ private slots:
 
     void distance_ReturnsExpectedValues_data();
     void distance_ReturnsExpectedValues();
+
+    void getPath_ShouldReturnPathSet_data();
+    void getPath_ShouldReturnPathSet();
+
+    void setters_ShouldShareRepeatedValuesBetweenImages();
 };
 
 Q_DECLARE_METATYPE(QList<DisplayShutter>)
@@ -435,6 +441,67 @@ void test_Image::distance_ReturnsExpectedValues()
     QVERIFY(FuzzyCompareTestHelper::fuzzyCompare(Image::distance(image), expectedDistance, 0.0001));
 }
 
+void test_Image::getPath_ShouldReturnPathSet_data()
+{
+    QTest::addColumn<QString>("path");
+
+    QTest::newRow("null") << QString();
+    QTest::newRow("empty") << QString("");
+    QTest::newRow("file name only") << QString("image.dcm");
+    QTest::newRow("unix path") << QString("/home/user/.starviewer/dicom/1.2.3/1.2.3.4/image.dcm");
+    QTest::newRow("windows path") << QString("C:\\Users\\user\\dicom\\image.dcm");
+    QTest::newRow("mixed separators") << QString("C:/Users/user\\dicom/image.dcm");
+    QTest::newRow("directory") << QString("/home/user/dicom/");
+}
+
+void test_Image::getPath_ShouldReturnPathSet()
+{
+    QFETCH(QString, path);
+
+    Image image;
+    image.setPath(path);
+
+    QCOMPARE(image.getPath(), path);
+}
+
+void test_Image::setters_ShouldShareRepeatedValuesBetweenImages()
+{
+    const int NumberOfImages = 1000;
+
+    StringInterner::clear();
+
+    Series series;
+    for (int i = 0; i < NumberOfImages; i++)
+    {
+        // Cada valor es construeix de nou per cada imatge, com passa quan es llegeixen els fitxers
+        Image *image = new Image();
+        image->setSOPInstanceUID(QString("1.2.826.0.1.3680043.2.1125.1.%1").arg(i));
+        image->setTransferSyntaxUID(QString("1.2.840.10008.1.2.1"));
+        image->setImageType(QString("ORIGINAL\\PRIMARY\\AXIAL"));
+        image->setViewPosition(QString("AP"));
+        image->setAcquisitionNumber(QString("1"));
+        image->setFrameNumber(0);
+        series.addImage(image);
+    }
+
+    QCOMPARE(series.getImages().size(), NumberOfImages);
+
+    // Tots els valors repetits apunten a les mateixes dades
+    Image *firstImage = series.getImages().first();
+    foreach (Image *image, series.getImages())
+    {
+        QCOMPARE(image->getTransferSyntaxUID().constData(), firstImage->getTransferSyntaxUID().constData());
+        QCOMPARE(image->getImageType().constData(), firstImage->getImageType().constData());
+        QCOMPARE(image->getViewPosition().constData(), firstImage->getViewPosition().constData());
+        QCOMPARE(image->getAcquisitionNumber().constData(), firstImage->getAcquisitionNumber().constData());
+    }
+
+    // Només s'hi han afegit els quatre valors diferents, no un per imatge
+    QCOMPARE(StringInterner::getSize(), 4);
+
+    StringInterner::clear();
+}
+
 DECLARE_TEST(test_Image)
 
 #include "test_image.moc"
@@ -0,0 +1,84 @@
+#include "autotest.h"
+#include "memorymappeddataarray.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+
+using namespace udg;
+
+class test_MemoryMappedDataArray : public QObject {
+Q_OBJECT
+
+private slots:
+    void createTemporary_ShouldStoreVolumeWrittenThroughTheMappedArray();
+
+    void createTemporary_ShouldRemoveFileWhenArrayIsReleased();
+
+    void createTemporary_ShouldReturnNullIfDirectoryDoesNotExist();
+};
+
+void test_MemoryMappedDataArray::createTemporary_ShouldStoreVolumeWrittenThroughTheMappedArray()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    vtkSmartPointer<vtkDataArray> scalars = vtkSmartPointer<vtkDataArray>::Take(
+        MemoryMappedDataArray::createTemporary(directory.path(), VTK_SHORT, 1, 16 * 16 * 4));
+    QVERIFY(scalars != 0);
+
+    vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+    imageData->SetExtent(0, 15, 0, 15, 0, 3);
+    imageData->GetPointData()->SetScalars(scalars);
+
+    short *scalarPointer = static_cast<short*>(imageData->GetScalarPointer());
+    for (int i = 0; i < 16 * 16 * 4; i++)
+    {
+        scalarPointer[i] = static_cast<short>(i - 512);
+    }
+
+    for (int z = 0; z < 4; z++)
+    {
+        for (int y = 0; y < 16; y++)
+        {
+            for (int x = 0; x < 16; x++)
+            {
+                QCOMPARE(static_cast<int>(imageData->GetScalarComponentAsDouble(x, y, z, 0)), z * 256 + y * 16 + x - 512);
+            }
+        }
+    }
+}
+
+void test_MemoryMappedDataArray::createTemporary_ShouldRemoveFileWhenArrayIsReleased()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    vtkDataArray *scalars = MemoryMappedDataArray::createTemporary(directory.path(), VTK_UNSIGNED_CHAR, 3, 1024);
+    QVERIFY(scalars != 0);
+
+    QStringList files = QDir(directory.path()).entryList(QDir::Files);
+    QCOMPARE(files.size(), 1);
+    QCOMPARE(QFileInfo(QDir(directory.path()).filePath(files.first())).size(), static_cast<qint64>(3 * 1024));
+
+    scalars->Delete();
+
+    QVERIFY(QDir(directory.path()).entryList(QDir::Files).isEmpty());
+}
+
+void test_MemoryMappedDataArray::createTemporary_ShouldReturnNullIfDirectoryDoesNotExist()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    QVERIFY(MemoryMappedDataArray::createTemporary(QDir(directory.path()).filePath("nonexistent"), VTK_SHORT, 1, 1024) == 0);
+}
+
+DECLARE_TEST(test_MemoryMappedDataArray)
+
+#include "test_memorymappeddataarray.moc"
@@ -8,15 +8,31 @@
 
 #include <QProcessEnvironment>
 
+#include <vtkCallbackCommand.h>
+#include <vtkRenderWindow.h>
+#include <vtkSmartPointer.h>
+
 using namespace udg;
 using namespace testing;
 
+namespace {
+
+// Counts the renders of the render window the callback is observing
+void countRender(vtkObject*, unsigned long, void *clientData, void*)
+{
+    (*static_cast<int*>(clientData))++;
+}
+
+}
+
 class test_Q2DViewer : public QObject {
 Q_OBJECT
 
 private slots:
     void canShowDisplayShutter_ShouldReturnExpectedValue_data();
     void canShowDisplayShutter_ShouldReturnExpectedValue();
+
+    void requestRender_ShouldCoalesceRequestsIntoASingleRender();
 };
 
 Q_DECLARE_METATYPE(Q2DViewer*)
@@ -132,6 +148,52 @@ void test_Q2DViewer::canShowDisplayShutter_ShouldReturnExpectedValue()
     VolumeTestHelper::cleanUp(volumeToCleanup);
 }
 
+void test_Q2DViewer::requestRender_ShouldCoalesceRequestsIntoASingleRender()
+{
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+
+    if (environment.contains("APPVEYOR") || environment.value("TRAVIS_OS_NAME") == "linux")
+    {
+        QSKIP("Test crashes in AppVeyor and Travis CI Linux");
+    }
+
+    double origin[3] = { 0.0, 0.0, 0.0 };
+    double spacing[3] = { 1.0, 1.0, 1.0 };
+    int extent[6] = { 0, 7, 0, 7, 0, 1 };
+    Volume *volume = VolumeTestHelper::createVolumeWithParameters(2, 1, 1, origin, spacing, extent, true);
+
+    Q2DViewer *viewer = new Q2DViewer();
+    // So that a slow first render does not reduce the quality and render again later
+    viewer->setInteractiveFrameTimeBudget(10000);
+    viewer->setInput(volume);
+    QCOMPARE(viewer->getViewerStatus(), QViewer::VisualizingVolume);
+    // Let any render requested while setting the input happen before counting
+    QTest::qWait(50);
+
+    int numberOfRenders = 0;
+    vtkSmartPointer<vtkCallbackCommand> renderCounter = vtkSmartPointer<vtkCallbackCommand>::New();
+    renderCounter->SetCallback(countRender);
+    renderCounter->SetClientData(&numberOfRenders);
+    viewer->getRenderWindow()->AddObserver(vtkCommand::StartEvent, renderCounter);
+
+    viewer->requestRender();
+    viewer->requestRender();
+    viewer->requestRender();
+    QCOMPARE(numberOfRenders, 0);
+
+    QTest::qWait(50);
+    QCOMPARE(numberOfRenders, 1);
+
+    // A direct render fulfils the pending request
+    viewer->requestRender();
+    viewer->render();
+    QTest::qWait(50);
+    QCOMPARE(numberOfRenders, 2);
+
+    delete viewer;
+    VolumeTestHelper::cleanUp(volume);
+}
+
 DECLARE_TEST(test_Q2DViewer)
 
 #include "test_q2dviewer.moc"
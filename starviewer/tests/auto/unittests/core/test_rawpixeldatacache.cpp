@@ -0,0 +1,153 @@
+#include "autotest.h"
+#include "rawpixeldatacache.h"
+
+#include "volumepixeldata.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+using namespace udg;
+
+class test_RawPixelDataCache : public QObject {
+Q_OBJECT
+
+private slots:
+    void init();
+
+    void load_ShouldReturnSavedPixelData();
+    void load_ShouldReturnNullIfNothingHasBeenSaved();
+    void load_ShouldReturnNullIfSourceFilesHaveChanged();
+    void load_ShouldReturnNullForOtherFrameNumbers();
+    void save_ShouldNotSavePixelDataBiggerThanMaximumDataSize();
+
+private:
+    /// Crea els fitxers d'origen al directori temporal i en retorna els paths
+    QStringList createSourceFiles();
+    static VolumePixelData* createPixelData();
+
+    QScopedPointer<QTemporaryDir> m_directory;
+};
+
+void test_RawPixelDataCache::init()
+{
+    m_directory.reset(new QTemporaryDir());
+    QVERIFY(m_directory->isValid());
+}
+
+void test_RawPixelDataCache::load_ShouldReturnSavedPixelData()
+{
+    QStringList files = createSourceFiles();
+    RawPixelDataCache cache(files, QList<int>() << 0 << 0, "TestReader");
+    QScopedPointer<VolumePixelData> pixelData(createPixelData());
+
+    QVERIFY(cache.save(pixelData.data()));
+    QScopedPointer<VolumePixelData> loadedPixelData(RawPixelDataCache(files, QList<int>() << 0 << 0, "TestReader").load());
+
+    QVERIFY(!loadedPixelData.isNull());
+    vtkImageData *expected = pixelData->getVtkData();
+    vtkImageData *loaded = loadedPixelData->getVtkData();
+    int expectedExtent[6], loadedExtent[6];
+    expected->GetExtent(expectedExtent);
+    loaded->GetExtent(loadedExtent);
+    for (int i = 0; i < 6; i++)
+    {
+        QCOMPARE(loadedExtent[i], expectedExtent[i]);
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        QCOMPARE(loaded->GetSpacing()[i], expected->GetSpacing()[i]);
+        QCOMPARE(loaded->GetOrigin()[i], expected->GetOrigin()[i]);
+    }
+    QCOMPARE(loaded->GetScalarType(), expected->GetScalarType());
+    QCOMPARE(loaded->GetNumberOfPoints(), expected->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); i++)
+    {
+        QCOMPARE(static_cast<short*>(loaded->GetScalarPointer())[i], static_cast<short*>(expected->GetScalarPointer())[i]);
+    }
+}
+
+void test_RawPixelDataCache::load_ShouldReturnNullIfNothingHasBeenSaved()
+{
+    RawPixelDataCache cache(createSourceFiles(), QList<int>() << 0 << 0, "TestReader");
+
+    QVERIFY(cache.load() == 0);
+}
+
+void test_RawPixelDataCache::load_ShouldReturnNullIfSourceFilesHaveChanged()
+{
+    QStringList files = createSourceFiles();
+    RawPixelDataCache cache(files, QList<int>() << 0 << 0, "TestReader");
+    QScopedPointer<VolumePixelData> pixelData(createPixelData());
+    QVERIFY(cache.save(pixelData.data()));
+
+    QFile file(files.last());
+    QVERIFY(file.open(QIODevice::Append));
+    file.write("modified");
+    file.close();
+
+    QVERIFY(cache.load() == 0);
+}
+
+void test_RawPixelDataCache::load_ShouldReturnNullForOtherFrameNumbers()
+{
+    QStringList files = createSourceFiles();
+    QScopedPointer<VolumePixelData> pixelData(createPixelData());
+    QVERIFY(RawPixelDataCache(files, QList<int>() << 0 << 0, "TestReader").save(pixelData.data()));
+
+    QVERIFY(RawPixelDataCache(files, QList<int>() << 1 << 1, "TestReader").load() == 0);
+}
+
+void test_RawPixelDataCache::save_ShouldNotSavePixelDataBiggerThanMaximumDataSize()
+{
+    RawPixelDataCache cache(createSourceFiles(), QList<int>() << 0 << 0, "TestReader");
+    QScopedPointer<VolumePixelData> pixelData(createPixelData());
+    cache.setMaximumDataSize(100);
+
+    QVERIFY(!cache.save(pixelData.data()));
+    QVERIFY(cache.load() == 0);
+}
+
+QStringList test_RawPixelDataCache::createSourceFiles()
+{
+    QStringList files;
+
+    for (int i = 0; i < 2; i++)
+    {
+        QString filePath = QDir(m_directory->path()).filePath(QString("image%1.dcm").arg(i));
+        QFile file(filePath);
+        file.open(QIODevice::WriteOnly);
+        file.write("DICM");
+        file.close();
+        files << filePath;
+    }
+
+    return files;
+}
+
+VolumePixelData* test_RawPixelDataCache::createPixelData()
+{
+    vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+    imageData->SetExtent(0, 15, 0, 15, 0, 1);
+    imageData->SetSpacing(0.5, 0.5, 2.0);
+    imageData->SetOrigin(-10.0, 20.0, 30.0);
+    imageData->AllocateScalars(VTK_SHORT, 1);
+
+    short *scalarPointer = static_cast<short*>(imageData->GetScalarPointer());
+    for (int i = 0; i < 16 * 16 * 2; i++)
+    {
+        scalarPointer[i] = static_cast<short>(i - 256);
+    }
+
+    VolumePixelData *pixelData = new VolumePixelData();
+    pixelData->setData(imageData);
+
+    return pixelData;
+}
+
+DECLARE_TEST(test_RawPixelDataCache)
+
+#include "test_rawpixeldatacache.moc"
@@ -0,0 +1,102 @@
+#include "autotest.h"
+#include "settingscache.h"
+
+#include <QSignalSpy>
+
+using namespace udg;
+
+class test_SettingsCache : public QObject {
+Q_OBJECT
+
+private slots:
+    void init();
+    void cleanupTestCase();
+
+    void getValue_ShouldReturnInsertedValue();
+
+    void insert_ShouldIgnoreValueReadBeforeAnInvalidation();
+
+    void invalidate_ShouldRemoveKeyAndSubKeysOnly();
+
+    void invalidate_ShouldEmitChangedWithTheGivenKey();
+
+    void clear_ShouldRemoveAllValues();
+};
+
+void test_SettingsCache::init()
+{
+    SettingsCache::instance()->clear();
+}
+
+void test_SettingsCache::cleanupTestCase()
+{
+    SettingsCache::instance()->clear();
+}
+
+void test_SettingsCache::getValue_ShouldReturnInsertedValue()
+{
+    SettingsCache *cache = SettingsCache::instance();
+    QVariant value;
+
+    QVERIFY(!cache->getValue("test/key", value));
+
+    cache->insert("test/key", 42, cache->getGeneration());
+
+    QVERIFY(cache->getValue("test/key", value));
+    QCOMPARE(value.toInt(), 42);
+}
+
+void test_SettingsCache::insert_ShouldIgnoreValueReadBeforeAnInvalidation()
+{
+    SettingsCache *cache = SettingsCache::instance();
+    quint64 generation = cache->getGeneration();
+
+    cache->invalidate("test/key");
+    cache->insert("test/key", 42, generation);
+
+    QVariant value;
+    QVERIFY(!cache->getValue("test/key", value));
+}
+
+void test_SettingsCache::invalidate_ShouldRemoveKeyAndSubKeysOnly()
+{
+    SettingsCache *cache = SettingsCache::instance();
+    cache->insert("test/list", 1, cache->getGeneration());
+    cache->insert("test/list/1/item", 2, cache->getGeneration());
+    cache->insert("test/listOther", 3, cache->getGeneration());
+
+    cache->invalidate("test/list");
+
+    QVariant value;
+    QVERIFY(!cache->getValue("test/list", value));
+    QVERIFY(!cache->getValue("test/list/1/item", value));
+    QVERIFY(cache->getValue("test/listOther", value));
+    QCOMPARE(value.toInt(), 3);
+}
+
+void test_SettingsCache::invalidate_ShouldEmitChangedWithTheGivenKey()
+{
+    QSignalSpy changedSpy(SettingsCache::instance(), SIGNAL(changed(QString)));
+
+    SettingsCache::instance()->invalidate("test/key");
+
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.first().first().toString(), QString("test/key"));
+}
+
+void test_SettingsCache::clear_ShouldRemoveAllValues()
+{
+    SettingsCache *cache = SettingsCache::instance();
+    cache->insert("test/key1", 1, cache->getGeneration());
+    cache->insert("test/key2", 2, cache->getGeneration());
+
+    cache->clear();
+
+    QVariant value;
+    QVERIFY(!cache->getValue("test/key1", value));
+    QVERIFY(!cache->getValue("test/key2", value));
+}
+
+DECLARE_TEST(test_SettingsCache)
+
+#include "test_settingscache.moc"
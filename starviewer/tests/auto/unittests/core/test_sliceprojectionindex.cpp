@@ -0,0 +1,159 @@
+#include "autotest.h"
+#include "sliceprojectionindex.h"
+
+#include "image.h"
+#include "imageorientation.h"
+#include "mathtools.h"
+#include "volume.h"
+#include "volumetesthelper.h"
+
+using namespace testing;
+using namespace udg;
+
+class test_SliceProjectionIndex : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    void getNearestSlice_ShouldReturnNearestSliceAndDistance_data();
+    void getNearestSlice_ShouldReturnNearestSliceAndDistance();
+
+    void getNearestSlice_ShouldReturnMinusOneWithNonParallelSlices();
+
+    void getNearestSlice_ShouldReturnSameSliceAsCheckingAllSlices();
+
+    void getSliceProjectionIndex_ShouldRebuildIndexWhenPixelDataGeometryChanges();
+
+private:
+    /// Creates an axial volume with one slice at each of the given z positions, in the given order
+    static Volume* createAxialVolume(const QList<double> &zPositions);
+
+};
+
+Q_DECLARE_METATYPE(Vector3)
+
+void test_SliceProjectionIndex::getNearestSlice_ShouldReturnNearestSliceAndDistance_data()
+{
+    QTest::addColumn<Vector3>("point");
+    QTest::addColumn<int>("expectedSlice");
+    QTest::addColumn<double>("expectedDistance");
+
+    // The volume has the slices at z = 4, 0, 8, 2, 6
+    QTest::newRow("on a slice") << Vector3(10.0, -5.0, 0.0) << 1 << 0.0;
+    QTest::newRow("between slices, nearer the previous") << Vector3(0.0, 0.0, 4.5) << 0 << 0.5;
+    QTest::newRow("between slices, nearer the next") << Vector3(0.0, 0.0, 5.5) << 4 << 0.5;
+    QTest::newRow("halfway between slices") << Vector3(0.0, 0.0, 5.0) << 0 << 1.0;
+    QTest::newRow("before the first slice") << Vector3(0.0, 0.0, -3.0) << 1 << 3.0;
+    QTest::newRow("after the last slice") << Vector3(0.0, 0.0, 100.0) << 2 << 92.0;
+}
+
+void test_SliceProjectionIndex::getNearestSlice_ShouldReturnNearestSliceAndDistance()
+{
+    QFETCH(Vector3, point);
+    QFETCH(int, expectedSlice);
+    QFETCH(double, expectedDistance);
+
+    Volume *volume = createAxialVolume(QList<double>() << 4.0 << 0.0 << 8.0 << 2.0 << 6.0);
+
+    SliceProjectionIndex index(volume, OrthogonalPlane::XYPlane);
+    double distance;
+
+    QVERIFY(index.isValid());
+    QCOMPARE(index.getNearestSlice(point, distance), expectedSlice);
+    QCOMPARE(distance, expectedDistance);
+
+    VolumeTestHelper::cleanUp(volume);
+}
+
+void test_SliceProjectionIndex::getNearestSlice_ShouldReturnMinusOneWithNonParallelSlices()
+{
+    Volume *volume = createAxialVolume(QList<double>() << 0.0 << 1.0);
+    volume->getImage(1)->setImageOrientationPatient(ImageOrientation(QVector3D(1.0, 0.0, 0.0), QVector3D(0.0, 0.0, 1.0)));
+
+    SliceProjectionIndex index(volume, OrthogonalPlane::XYPlane);
+    double distance;
+
+    QVERIFY(!index.isValid());
+    QCOMPARE(index.getNearestSlice(Vector3(0.0, 0.0, 0.0), distance), -1);
+
+    VolumeTestHelper::cleanUp(volume);
+}
+
+void test_SliceProjectionIndex::getNearestSlice_ShouldReturnSameSliceAsCheckingAllSlices()
+{
+    QList<double> zPositions;
+    for (int i = 0; i < 50; i++)
+    {
+        zPositions << (i * 37 % 50) * 1.25;
+    }
+    Volume *volume = createAxialVolume(zPositions);
+
+    SliceProjectionIndex index(volume, OrthogonalPlane::XYPlane);
+
+    for (double z = -5.0; z < 70.0; z += 0.3)
+    {
+        int expectedSlice = -1;
+        double expectedDistance = MathTools::DoubleMaximumValue;
+        for (int i = 0; i < zPositions.size(); i++)
+        {
+            double sliceDistance = qAbs(z - zPositions.at(i));
+            if (sliceDistance < expectedDistance)
+            {
+                expectedDistance = sliceDistance;
+                expectedSlice = i;
+            }
+        }
+
+        double distance;
+        QCOMPARE(index.getNearestSlice(Vector3(0.0, 0.0, z), distance), expectedSlice);
+        QVERIFY(qAbs(distance - expectedDistance) < 1e-9);
+    }
+
+    VolumeTestHelper::cleanUp(volume);
+}
+
+void test_SliceProjectionIndex::getSliceProjectionIndex_ShouldRebuildIndexWhenPixelDataGeometryChanges()
+{
+    double origin[3] = { 0.0, 0.0, 0.0 };
+    double spacing[3] = { 1.0, 1.0, 1.0 };
+    int extent[6] = { 0, 9, 0, 9, 0, 0 };
+    Volume *volume = VolumeTestHelper::createVolumeWithParameters(1, 1, 1, origin, spacing, extent);
+    volume->getImage(0)->setImageOrientationPatient(ImageOrientation(QVector3D(1.0, 0.0, 0.0), QVector3D(0.0, 1.0, 0.0)));
+
+    double distance;
+    QSharedPointer<SliceProjectionIndex> index = volume->getSliceProjectionIndex(OrthogonalPlane::YZPlane);
+    QVERIFY(index->isValid());
+    QCOMPARE(index->getNearestSlice(Vector3(6.0, 0.0, 0.0), distance), 6);
+
+    // The geometry is changed through the pixel data, without the volume noticing
+    volume->getPixelData()->setSpacing(2.0, 1.0, 1.0);
+    QCOMPARE(volume->getSliceProjectionIndex(OrthogonalPlane::YZPlane)->getNearestSlice(Vector3(6.0, 0.0, 0.0), distance), 3);
+
+    volume->getPixelData()->setOrigin(4.0, 0.0, 0.0);
+    QCOMPARE(volume->getSliceProjectionIndex(OrthogonalPlane::YZPlane)->getNearestSlice(Vector3(6.0, 0.0, 0.0), distance), 1);
+
+    // The index got before the changes is still usable
+    QCOMPARE(index->getNearestSlice(Vector3(6.0, 0.0, 0.0), distance), 6);
+
+    VolumeTestHelper::cleanUp(volume);
+}
+
+Volume* test_SliceProjectionIndex::createAxialVolume(const QList<double> &zPositions)
+{
+    Volume *volume = VolumeTestHelper::createVolume(zPositions.size(), 1, zPositions.size());
+    ImageOrientation orientation(QVector3D(1.0, 0.0, 0.0), QVector3D(0.0, 1.0, 0.0));
+
+    for (int i = 0; i < zPositions.size(); i++)
+    {
+        double position[3] = { 0.0, 0.0, zPositions.at(i) };
+        volume->getImage(i)->setImagePositionPatient(position);
+        volume->getImage(i)->setImageOrientationPatient(orientation);
+    }
+
+    return volume;
+}
+
+DECLARE_TEST(test_SliceProjectionIndex)
+
+#include "test_sliceprojectionindex.moc"
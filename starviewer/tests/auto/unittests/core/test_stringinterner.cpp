@@ -0,0 +1,82 @@
+#include "autotest.h"
+#include "stringinterner.h"
+
+using namespace udg;
+
+class test_StringInterner : public QObject {
+Q_OBJECT
+
+private slots:
+    void cleanup();
+
+    void intern_ShouldReturnEqualString_data();
+    void intern_ShouldReturnEqualString();
+
+    void intern_ShouldShareDataBetweenEqualStrings();
+
+    void intern_ShouldNotAddEmptyStrings();
+
+    void clear_ShouldKeepInternedStringsValid();
+};
+
+void test_StringInterner::cleanup()
+{
+    StringInterner::clear();
+}
+
+void test_StringInterner::intern_ShouldReturnEqualString_data()
+{
+    QTest::addColumn<QString>("string");
+
+    QTest::newRow("null") << QString();
+    QTest::newRow("empty") << QString("");
+    QTest::newRow("transfer syntax") << QString("1.2.840.10008.1.2.1");
+    QTest::newRow("image type") << QString("ORIGINAL\\PRIMARY\\AXIAL");
+}
+
+void test_StringInterner::intern_ShouldReturnEqualString()
+{
+    QFETCH(QString, string);
+
+    QString internedString = StringInterner::intern(string);
+
+    QCOMPARE(internedString, string);
+    QCOMPARE(internedString.isNull(), string.isNull());
+}
+
+void test_StringInterner::intern_ShouldShareDataBetweenEqualStrings()
+{
+    // Es construeixen cadenes independents, com passa quan es llegeix el mateix valor de fitxers diferents
+    QString string1 = QString("ORIGINAL\\PRIMARY") + QString("\\AXIAL");
+    QString string2 = QString("ORIGINAL\\PRIMARY") + QString("\\AXIAL");
+    QVERIFY(string1.constData() != string2.constData());
+
+    QString internedString1 = StringInterner::intern(string1);
+    QString internedString2 = StringInterner::intern(string2);
+
+    QCOMPARE(internedString1, internedString2);
+    QCOMPARE(internedString1.constData(), internedString2.constData());
+    QCOMPARE(StringInterner::getSize(), 1);
+}
+
+void test_StringInterner::intern_ShouldNotAddEmptyStrings()
+{
+    StringInterner::intern(QString());
+    StringInterner::intern(QString(""));
+
+    QCOMPARE(StringInterner::getSize(), 0);
+}
+
+void test_StringInterner::clear_ShouldKeepInternedStringsValid()
+{
+    QString internedString = StringInterner::intern(QString("MONOCHROME2"));
+
+    StringInterner::clear();
+
+    QCOMPARE(StringInterner::getSize(), 0);
+    QCOMPARE(internedString, QString("MONOCHROME2"));
+}
+
+DECLARE_TEST(test_StringInterner)
+
+#include "test_stringinterner.moc"
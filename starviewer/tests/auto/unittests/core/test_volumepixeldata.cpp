@@ -8,6 +8,9 @@
 #include "fuzzycomparetesthelper.h"
 
 #include "vtkImageData.h"
+#include <vtkPointData.h>
+#include <vtkDataArray.h>
+#include <vtkVariant.h>
 
 using namespace udg;
 using namespace testing;
@@ -37,6 +40,15 @@ private slots:
 
     void getVoxelValue_IndexVariant_ShouldReturnExpectedSingleComponentValue_data();
     void getVoxelValue_IndexVariant_ShouldReturnExpectedSingleComponentValue();
+
+    void getItkData_ShouldConvertOtherScalarTypesToItkPixelType();
+
+    void compress_ShouldRestoreSameDataOnAccess_data();
+    void compress_ShouldRestoreSameDataOnAccess();
+
+    void compress_ShouldNotCompressDataInUse();
+
+    void compress_ShouldNotCompressScalarsSharedByAShallowCopy();
 };
 
 Q_DECLARE_METATYPE(unsigned char*)
@@ -405,6 +417,121 @@ void test_VolumePixelData::getVoxelValue_IndexVariant_ShouldReturnExpectedSingle
     }
 }
 
+void test_VolumePixelData::getItkData_ShouldConvertOtherScalarTypesToItkPixelType()
+{
+    vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+    imageData->SetExtent(0, 3, 0, 3, 0, 1);
+    imageData->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    unsigned char *scalarPointer = static_cast<unsigned char*>(imageData->GetScalarPointer());
+    for (int i = 0; i < 32; i++)
+    {
+        scalarPointer[i] = 200 + i;
+    }
+
+    VolumePixelData volumePixelData;
+    volumePixelData.setData(imageData);
+
+    VolumePixelData::ItkImageTypePointer itkData = volumePixelData.getItkData();
+
+    // Les dades originals mantenen el seu tipus
+    QCOMPARE(volumePixelData.getScalarType(), VTK_UNSIGNED_CHAR);
+    QCOMPARE(static_cast<int>(itkData->GetBufferedRegion().GetNumberOfPixels()), 32);
+    for (int i = 0; i < 32; i++)
+    {
+        QCOMPARE(static_cast<int>(itkData->GetBufferPointer()[i]), 200 + i);
+    }
+}
+
+void test_VolumePixelData::compress_ShouldRestoreSameDataOnAccess_data()
+{
+    QTest::addColumn<int>("scalarType");
+    QTest::addColumn<int>("numberOfComponents");
+
+    QTest::newRow("unsigned char") << VTK_UNSIGNED_CHAR << 1;
+    QTest::newRow("short") << VTK_SHORT << 1;
+    QTest::newRow("float") << VTK_FLOAT << 1;
+    QTest::newRow("rgb") << VTK_UNSIGNED_CHAR << 3;
+}
+
+void test_VolumePixelData::compress_ShouldRestoreSameDataOnAccess()
+{
+    QFETCH(int, scalarType);
+    QFETCH(int, numberOfComponents);
+
+    VolumePixelData volumePixelData;
+    {
+        vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+        imageData->SetExtent(0, 63, 0, 63, 0, 7);
+        imageData->SetSpacing(0.5, 0.5, 2.0);
+        imageData->SetOrigin(1.0, 2.0, 3.0);
+        imageData->AllocateScalars(scalarType, numberOfComponents);
+        vtkDataArray *scalars = imageData->GetPointData()->GetScalars();
+        // Dades fàcilment comprimibles: regions constants
+        for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); i++)
+        {
+            scalars->SetVariantValue(i, vtkVariant((i / 512) % 100));
+        }
+        volumePixelData.setData(imageData);
+    }
+
+    QVERIFY(volumePixelData.compress());
+    QVERIFY(volumePixelData.isCompressed());
+    QCOMPARE(volumePixelData.getScalarType(), scalarType);
+    QCOMPARE(volumePixelData.getNumberOfScalarComponents(), numberOfComponents);
+
+    double spacing[3];
+    volumePixelData.getSpacing(spacing);
+    QCOMPARE(spacing[2], 2.0);
+
+    vtkDataArray *scalars = volumePixelData.getVtkData()->GetPointData()->GetScalars();
+    QVERIFY(!volumePixelData.isCompressed());
+    QVERIFY(scalars != 0);
+    QCOMPARE(scalars->GetDataType(), scalarType);
+    QCOMPARE(scalars->GetNumberOfComponents(), numberOfComponents);
+    for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); i++)
+    {
+        QCOMPARE(scalars->GetVariantValue(i).ToInt(), static_cast<int>((i / 512) % 100));
+    }
+}
+
+void test_VolumePixelData::compress_ShouldNotCompressDataInUse()
+{
+    vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+    imageData->SetExtent(0, 63, 0, 63, 0, 7);
+    imageData->AllocateScalars(VTK_SHORT, 1);
+    memset(imageData->GetScalarPointer(), 0, 64 * 64 * 8 * sizeof(short));
+
+    VolumePixelData volumePixelData;
+    volumePixelData.setData(imageData);
+
+    // Mentre algú més tingui una referència a les dades no es poden comprimir
+    QVERIFY(!volumePixelData.compress());
+
+    imageData = NULL;
+    QVERIFY(volumePixelData.compress());
+}
+
+void test_VolumePixelData::compress_ShouldNotCompressScalarsSharedByAShallowCopy()
+{
+    VolumePixelData volumePixelData;
+    {
+        vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+        imageData->SetExtent(0, 63, 0, 63, 0, 7);
+        imageData->AllocateScalars(VTK_SHORT, 1);
+        memset(imageData->GetScalarPointer(), 0, 64 * 64 * 8 * sizeof(short));
+        volumePixelData.setData(imageData);
+    }
+
+    // La còpia superficial comparteix l'array d'escalars però no referencia la imatge
+    vtkSmartPointer<vtkImageData> shallowCopy = vtkSmartPointer<vtkImageData>::New();
+    shallowCopy->ShallowCopy(volumePixelData.getVtkData());
+
+    QVERIFY(!volumePixelData.compress());
+
+    shallowCopy = NULL;
+    QVERIFY(volumePixelData.compress());
+}
+
 DECLARE_TEST(test_VolumePixelData)
 
 #include "test_volumepixeldata.moc"
@@ -11,4 +11,8 @@ SOURCES += $$PWD/test_dicommask.cpp \
            $$PWD/test_cachetest.cpp \
            $$PWD/test_senddicomfilestopacs.cpp \
            $$PWD/test_databaseconnection.cpp \
-           $$PWD/test_localdatabasebasedal.cpp
+           $$PWD/test_localdatabasebasedal.cpp \
+           $$PWD/test_relatedstudiesquerycache.cpp \
+           $$PWD/test_converttodicomdir.cpp \
+           $$PWD/test_localdatabasestudydal.cpp \
+           $$PWD/test_localdatabasemanager.cpp
@@ -0,0 +1,33 @@
+#include "autotest.h"
+#include "converttodicomdir.h"
+
+#include <QTemporaryDir>
+
+using namespace udg;
+
+class test_ConvertToDicomdir : public QObject {
+Q_OBJECT
+
+private slots:
+    void convert_ShouldFinishFromTheEventLoop();
+};
+
+void test_ConvertToDicomdir::convert_ShouldFinishFromTheEventLoop()
+{
+    QTemporaryDir directory;
+    ConvertToDicomdir convertToDicomdir;
+    int numberOfFinishedSignals = 0;
+    connect(&convertToDicomdir, &ConvertToDicomdir::finished, [&numberOfFinishedSignals](const Status&) {
+        numberOfFinishedSignals++;
+    });
+
+    convertToDicomdir.convert(directory.path(), CreateDicomdir::HardDisk, false);
+
+    // The copy does not block: convert() returns before it has finished and the conversion is completed from the event loop
+    QCOMPARE(numberOfFinishedSignals, 0);
+    QTRY_COMPARE(numberOfFinishedSignals, 1);
+}
+
+DECLARE_TEST(test_ConvertToDicomdir)
+
+#include "test_converttodicomdir.moc"
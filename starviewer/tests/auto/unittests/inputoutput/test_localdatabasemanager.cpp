@@ -0,0 +1,55 @@
+#include "autotest.h"
+#include "localdatabasemanager.h"
+
+#include "databaseconnection.h"
+#include "databasetesthelper.h"
+#include "localdatabasestudydal.h"
+
+#include <QSignalSpy>
+
+using namespace udg;
+using namespace testing;
+
+class test_LocalDatabaseManager : public QObject {
+
+    Q_OBJECT
+
+private slots:
+    void deleteStudiesAccessedBefore_ShouldDeleteOldStudiesInBatches();
+
+};
+
+void test_LocalDatabaseManager::deleteStudiesAccessedBefore_ShouldDeleteOldStudiesInBatches()
+{
+    QScopedPointer<DatabaseConnection> databaseConnection(DatabaseTestHelper::getCreatedDatabase());
+    DatabaseTestHelper::insertStudy(databaseConnection.data(), "1.3", QDate(2015, 3, 1));
+    DatabaseTestHelper::insertStudy(databaseConnection.data(), "1.1", QDate(2015, 1, 1));
+    DatabaseTestHelper::insertStudy(databaseConnection.data(), "1.2", QDate(2015, 2, 1));
+    DatabaseTestHelper::insertStudy(databaseConnection.data(), "1.4", QDate(2020, 1, 1));
+
+    LocalDatabaseManager localDatabaseManager;
+    QSignalSpy studyWillBeDeletedSpy(&localDatabaseManager, SIGNAL(studyWillBeDeleted(QString)));
+    QDate accessedBefore(2016, 1, 1);
+
+    // A full batch means that there may be more old studies left
+    QCOMPARE(localDatabaseManager.deleteStudiesAccessedBefore(*databaseConnection, accessedBefore, 2), 2);
+    QCOMPARE(localDatabaseManager.getLastError(), LocalDatabaseManager::Ok);
+    QCOMPARE(localDatabaseManager.deleteStudiesAccessedBefore(*databaseConnection, accessedBefore, 2), 1);
+    QCOMPARE(localDatabaseManager.deleteStudiesAccessedBefore(*databaseConnection, accessedBefore, 2), 0);
+    QCOMPARE(localDatabaseManager.getLastError(), LocalDatabaseManager::Ok);
+
+    QCOMPARE(studyWillBeDeletedSpy.count(), 3);
+    QCOMPARE(studyWillBeDeletedSpy.at(0).first().toString(), QString("1.1"));
+    QCOMPARE(studyWillBeDeletedSpy.at(1).first().toString(), QString("1.2"));
+    QCOMPARE(studyWillBeDeletedSpy.at(2).first().toString(), QString("1.3"));
+
+    LocalDatabaseStudyDAL studyDAL(*databaseConnection);
+    QVERIFY(!studyDAL.exists("1.1"));
+    QVERIFY(!studyDAL.exists("1.2"));
+    QVERIFY(!studyDAL.exists("1.3"));
+    QVERIFY(studyDAL.exists("1.4"));
+}
+
+DECLARE_TEST(test_LocalDatabaseManager)
+
+#include "test_localdatabasemanager.moc"
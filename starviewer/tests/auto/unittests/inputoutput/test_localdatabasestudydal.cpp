@@ -0,0 +1,62 @@
+#include "autotest.h"
+#include "localdatabasestudydal.h"
+
+#include "databaseconnection.h"
+#include "databasetesthelper.h"
+#include "study.h"
+
+using namespace udg;
+using namespace testing;
+
+class test_LocalDatabaseStudyDAL : public QObject {
+
+    Q_OBJECT
+
+private slots:
+    void queryLeastRecentlyAccessed_ShouldReturnOldestStudiesFirst_data();
+    void queryLeastRecentlyAccessed_ShouldReturnOldestStudiesFirst();
+
+};
+
+void test_LocalDatabaseStudyDAL::queryLeastRecentlyAccessed_ShouldReturnOldestStudiesFirst_data()
+{
+    QTest::addColumn<QDate>("accessedBefore");
+    QTest::addColumn<int>("maximumNumberOfStudies");
+    QTest::addColumn<QStringList>("expectedStudyInstanceUIDs");
+
+    // The database has the studies 1.3 (accessed on 2015-03-01), 1.1 (2015-01-01), 1.2 (2015-02-01) and 1.4 (2020-01-01), inserted in this order
+    QTest::newRow("limited") << QDate(2016, 1, 1) << 2 << (QStringList() << "1.1" << "1.2");
+    QTest::newRow("fewer studies than the limit") << QDate(2016, 1, 1) << 10 << (QStringList() << "1.1" << "1.2" << "1.3");
+    QTest::newRow("accessed on the given date") << QDate(2015, 2, 1) << 10 << (QStringList() << "1.1");
+    QTest::newRow("none") << QDate(2014, 1, 1) << 10 << QStringList();
+}
+
+void test_LocalDatabaseStudyDAL::queryLeastRecentlyAccessed_ShouldReturnOldestStudiesFirst()
+{
+    QFETCH(QDate, accessedBefore);
+    QFETCH(int, maximumNumberOfStudies);
+    QFETCH(QStringList, expectedStudyInstanceUIDs);
+
+    QScopedPointer<DatabaseConnection> databaseConnection(DatabaseTestHelper::getCreatedDatabase());
+    DatabaseTestHelper::insertStudy(databaseConnection.data(), "1.3", QDate(2015, 3, 1));
+    DatabaseTestHelper::insertStudy(databaseConnection.data(), "1.1", QDate(2015, 1, 1));
+    DatabaseTestHelper::insertStudy(databaseConnection.data(), "1.2", QDate(2015, 2, 1));
+    DatabaseTestHelper::insertStudy(databaseConnection.data(), "1.4", QDate(2020, 1, 1));
+
+    LocalDatabaseStudyDAL studyDAL(*databaseConnection);
+    QList<Study*> studies = studyDAL.queryLeastRecentlyAccessed(accessedBefore, maximumNumberOfStudies);
+
+    QStringList studyInstanceUIDs;
+    foreach (Study *study, studies)
+    {
+        studyInstanceUIDs << study->getInstanceUID();
+    }
+    qDeleteAll(studies);
+
+    QVERIFY(!studyDAL.getLastError().isValid());
+    QCOMPARE(studyInstanceUIDs, expectedStudyInstanceUIDs);
+}
+
+DECLARE_TEST(test_LocalDatabaseStudyDAL)
+
+#include "test_localdatabasestudydal.moc"
@@ -0,0 +1,141 @@
+#include "autotest.h"
+
+#include "relatedstudiesquerycache.h"
+#include "patient.h"
+#include "study.h"
+#include "pacsdevicetesthelper.h"
+
+#include <QTest>
+
+using namespace udg;
+using namespace testing;
+
+class test_RelatedStudiesQueryCache : public QObject {
+Q_OBJECT
+
+private slots:
+    void contains_ShouldReturnFalseForUnknownKeys();
+    void getPatients_ShouldReturnNewCopiesOfTheInsertedStudies();
+    void getPatients_ShouldNotBeAffectedByChangesInReturnedStudies();
+    void contains_ShouldReturnFalseWhenResultsHaveExpired();
+
+private:
+    static Patient* createPatientWithStudy(const QString &patientID, const QString &studyInstanceUID);
+    static void deletePatients(const QList<Patient*> &patients);
+};
+
+void test_RelatedStudiesQueryCache::contains_ShouldReturnFalseForUnknownKeys()
+{
+    RelatedStudiesQueryCache cache;
+
+    QVERIFY(!cache.contains("PACS\\1\\"));
+    QVERIFY(cache.getPatients("PACS\\1\\").isEmpty());
+}
+
+void test_RelatedStudiesQueryCache::getPatients_ShouldReturnNewCopiesOfTheInsertedStudies()
+{
+    RelatedStudiesQueryCache cache;
+    Patient *patient = createPatientWithStudy("1", "1.2.3");
+    cache.insert("PACS\\1\\", QList<Patient*>() << patient);
+
+    QVERIFY(cache.contains("PACS\\1\\"));
+    QList<Patient*> firstHit = cache.getPatients("PACS\\1\\");
+    QList<Patient*> secondHit = cache.getPatients("PACS\\1\\");
+
+    QCOMPARE(firstHit.count(), 1);
+    QCOMPARE(secondHit.count(), 1);
+    QVERIFY(firstHit.first() != patient);
+    QVERIFY(firstHit.first() != secondHit.first());
+    QCOMPARE(firstHit.first()->getID(), QString("1"));
+    QCOMPARE(firstHit.first()->getFullName(), patient->getFullName());
+    QCOMPARE(firstHit.first()->getNumberOfStudies(), 1);
+
+    Study *study = firstHit.first()->getStudies().first();
+    QVERIFY(study != patient->getStudies().first());
+    QVERIFY(study != secondHit.first()->getStudies().first());
+    QCOMPARE(study->getInstanceUID(), QString("1.2.3"));
+    QCOMPARE(study->getDescription(), patient->getStudies().first()->getDescription());
+    QCOMPARE(study->getModalities(), patient->getStudies().first()->getModalities());
+    QCOMPARE(study->getDate(), patient->getStudies().first()->getDate());
+    QCOMPARE(study->getParentPatient(), firstHit.first());
+    QVERIFY(study->getDICOMSource() == patient->getStudies().first()->getDICOMSource());
+
+    deletePatients(QList<Patient*>() << patient);
+    deletePatients(firstHit);
+    deletePatients(secondHit);
+}
+
+void test_RelatedStudiesQueryCache::getPatients_ShouldNotBeAffectedByChangesInReturnedStudies()
+{
+    RelatedStudiesQueryCache cache;
+    Patient *patient = createPatientWithStudy("1", "1.2.3");
+    cache.insert("PACS\\1\\", QList<Patient*>() << patient);
+    deletePatients(QList<Patient*>() << patient);
+
+    QList<Patient*> firstHit = cache.getPatients("PACS\\1\\");
+    DICOMSource otherSource;
+    otherSource.addRetrievePACS(PACSDeviceTestHelper::createPACSDevice("2", "OTHER", "2.2.2.2", 104));
+    firstHit.first()->getStudies().first()->setDICOMSource(otherSource);
+    firstHit.first()->getStudies().first()->setDescription("Changed");
+    deletePatients(firstHit);
+
+    QList<Patient*> secondHit = cache.getPatients("PACS\\1\\");
+    Study *study = secondHit.first()->getStudies().first();
+    QCOMPARE(study->getDescription(), QString("Description"));
+    QCOMPARE(study->getDICOMSource().getRetrievePACS().count(), 1);
+    QCOMPARE(study->getDICOMSource().getRetrievePACS().first().getID(), QString("1"));
+
+    deletePatients(secondHit);
+}
+
+void test_RelatedStudiesQueryCache::contains_ShouldReturnFalseWhenResultsHaveExpired()
+{
+    RelatedStudiesQueryCache cache;
+    cache.setLifetime(50);
+    Patient *patient = createPatientWithStudy("1", "1.2.3");
+    cache.insert("PACS\\1\\", QList<Patient*>() << patient);
+    deletePatients(QList<Patient*>() << patient);
+
+    QVERIFY(cache.contains("PACS\\1\\"));
+
+    QTest::qSleep(100);
+
+    QVERIFY(!cache.contains("PACS\\1\\"));
+    QVERIFY(cache.getPatients("PACS\\1\\").isEmpty());
+    QCOMPARE(cache.count(), 0);
+}
+
+Patient* test_RelatedStudiesQueryCache::createPatientWithStudy(const QString &patientID, const QString &studyInstanceUID)
+{
+    Patient *patient = new Patient();
+    patient->setID(patientID);
+    patient->setFullName("SURNAME^NAME");
+    patient->setBirthDate("19700101");
+
+    DICOMSource dicomSource;
+    dicomSource.addRetrievePACS(PACSDeviceTestHelper::createPACSDevice("1", "PACS", "1.1.1.1", 104));
+
+    Study *study = new Study();
+    study->setInstanceUID(studyInstanceUID);
+    study->setDescription("Description");
+    study->addModality("CT");
+    study->setDate(QDate(2014, 5, 20));
+    study->setTime(QTime(10, 30));
+    study->setDICOMSource(dicomSource);
+    patient->addStudy(study);
+
+    return patient;
+}
+
+void test_RelatedStudiesQueryCache::deletePatients(const QList<Patient*> &patients)
+{
+    foreach (Patient *patient, patients)
+    {
+        qDeleteAll(patient->getStudies());
+        delete patient;
+    }
+}
+
+DECLARE_TEST(test_RelatedStudiesQueryCache)
+
+#include "test_relatedstudiesquerycache.moc"
@@ -1,3 +1,4 @@
 
 SOURCES += $$PWD/test_qapplicationmainwindow.cpp \
-           $$PWD/test_applicationcommandlineoptions.cpp
+           $$PWD/test_applicationcommandlineoptions.cpp \
+           $$PWD/test_patientloaderthread.cpp
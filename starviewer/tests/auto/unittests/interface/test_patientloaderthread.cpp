@@ -0,0 +1,124 @@
+#include "autotest.h"
+#include "patientloaderthread.h"
+
+#include "patient.h"
+#include "study.h"
+#include "series.h"
+#include "image.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace udg;
+
+class test_PatientLoaderThread : public QObject {
+Q_OBJECT
+
+private slots:
+    void loadFiles_ShouldReturnPatientsOwnedByTheMainThread();
+
+    void loadedPatients_ShouldBeMergeableIntoAMainThreadPatient();
+
+    void cancel_ShouldDiscardThePatientsLoadedSoFar();
+
+private:
+    /// Crea al directori donat un fitxer MHD de 2x2x1 amb el nom donat i en retorna el path
+    QString createMHDFile(const QString &directory, const QString &name);
+
+    /// Carrega els fitxers donats i espera que acabi la càrrega
+    QList<Patient*> loadFiles(const QStringList &files);
+};
+
+void test_PatientLoaderThread::loadFiles_ShouldReturnPatientsOwnedByTheMainThread()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    QList<Patient*> patients = loadFiles(QStringList() << createMHDFile(directory.path(), "volume"));
+
+    QCOMPARE(patients.size(), 1);
+    QCOMPARE(patients.first()->thread(), QCoreApplication::instance()->thread());
+    foreach (Study *study, patients.first()->getStudies())
+    {
+        QCOMPARE(study->thread(), QCoreApplication::instance()->thread());
+        foreach (Series *series, study->getSeries())
+        {
+            QCOMPARE(series->thread(), QCoreApplication::instance()->thread());
+            foreach (Image *image, series->getImages())
+            {
+                QCOMPARE(image->thread(), QCoreApplication::instance()->thread());
+            }
+        }
+    }
+
+    qDeleteAll(patients);
+}
+
+void test_PatientLoaderThread::loadedPatients_ShouldBeMergeableIntoAMainThreadPatient()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    QList<Patient*> patients = loadFiles(QStringList() << createMHDFile(directory.path(), "volume"));
+    QCOMPARE(patients.size(), 1);
+    Patient *loadedPatient = patients.first();
+    Study *loadedStudy = loadedPatient->getStudies().first();
+
+    Patient *currentPatient = new Patient;
+    currentPatient->setID("MHD Patient");
+    *currentPatient += *loadedPatient;
+
+    QCOMPARE(currentPatient->getStudies().size(), 1);
+    QCOMPARE(loadedStudy->parent(), static_cast<QObject*>(currentPatient));
+
+    delete currentPatient;
+    delete loadedPatient;
+}
+
+void test_PatientLoaderThread::cancel_ShouldDiscardThePatientsLoadedSoFar()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    QStringList files;
+    files << createMHDFile(directory.path(), "volume1") << createMHDFile(directory.path(), "volume2") << createMHDFile(directory.path(), "volume3");
+
+    PatientLoaderThread loader;
+    // Es cancel·la des del mateix thread de càrrega en acabar el primer fitxer, així la cancel·lació sempre arriba abans d'acabar
+    connect(&loader, SIGNAL(progress(int)), &loader, SLOT(cancel()), Qt::DirectConnection);
+    loader.loadFiles(files);
+    QVERIFY(loader.wait(30000));
+
+    QCOMPARE(loader.getNumberOfFilesFound(), 1);
+    QVERIFY(loader.takePatients().isEmpty());
+}
+
+QString test_PatientLoaderThread::createMHDFile(const QString &directory, const QString &name)
+{
+    QFile rawFile(QString("%1/%2.raw").arg(directory).arg(name));
+    rawFile.open(QIODevice::WriteOnly);
+    rawFile.write(QByteArray(4, 0));
+    rawFile.close();
+
+    QString mhdFilePath = QString("%1/%2.mhd").arg(directory).arg(name);
+    QFile mhdFile(mhdFilePath);
+    mhdFile.open(QIODevice::WriteOnly | QIODevice::Text);
+    mhdFile.write(QString("ObjectType = Image\nNDims = 3\nDimSize = 2 2 1\nElementSpacing = 1 1 1\nElementType = MET_UCHAR\n"
+                          "ElementDataFile = %1.raw\n").arg(name).toLatin1());
+    mhdFile.close();
+
+    return mhdFilePath;
+}
+
+QList<Patient*> test_PatientLoaderThread::loadFiles(const QStringList &files)
+{
+    PatientLoaderThread loader;
+    loader.loadFiles(files);
+    loader.wait();
+
+    return loader.takePatients();
+}
+
+DECLARE_TEST(test_PatientLoaderThread)
+
+#include "test_patientloaderthread.moc"